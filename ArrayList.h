@@ -0,0 +1,457 @@
+#pragma once
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "MemoryReport.h"
+#include "PointerIndex.h"
+
+/*
+ A templated class representing array-backed lists. An ArrayList<T> manages
+ pointers to objects of type T in one contiguous array, and has the same
+ public methods as List<T>. Appending and peeking at any position take
+ constant time; inserting or removing anywhere but the end shifts the
+ elements after that position.
+ */
+template <typename T>
+class ArrayList {
+
+protected:
+
+    /*
+     The data pointers managed by this list, in order.
+     */
+    std::vector<T*> items;
+
+    /*
+     True if this list owns the data it points to, as with Chain.
+     */
+    bool ownsData;
+
+    /*
+     Hash index from data pointers to positions, or the null pointer if this
+     list is not indexed, as with Chain.
+     */
+    PointerIndex<T>* pointerIndex;
+
+    void invalidateIndex() {
+        if (this->pointerIndex != nullptr) {
+            this->pointerIndex->invalidate();
+        }
+    }
+
+    PointerIndex<T>* getFreshIndex() {
+        if (this->pointerIndex->isStale()) {
+            this->pointerIndex->rebuild(this->items);
+        }
+        return this->pointerIndex;
+    }
+
+    /*
+     Records in the index, if there is one, that the elements from
+     suffixPosition on moved by delta positions, as with Chain: whichever of
+     the prefixLength unmoved elements and the moved ones are fewer is
+     walked.
+     */
+    void reindexAfterShift(int prefixLength, int suffixPosition, int delta) {
+        if (this->pointerIndex == nullptr || this->pointerIndex->isStale()) {
+            return;
+        }
+        int size = (int)this->items.size();
+        if (size - suffixPosition <= prefixLength) {
+            if (delta > 0) {
+                for (int position = size - 1; position >= suffixPosition; position--) {
+                    this->pointerIndex->moveOccurrence(this->items[position], position - delta, position);
+                }
+            }
+            else {
+                for (int position = suffixPosition; position < size; position++) {
+                    this->pointerIndex->moveOccurrence(this->items[position], position - delta, position);
+                }
+            }
+        }
+        else {
+            this->pointerIndex->moveAllPositions(delta);
+            if (delta > 0) {
+                for (int position = 0; position < prefixLength; position++) {
+                    this->pointerIndex->moveOccurrence(this->items[position], position + delta, position);
+                }
+            }
+            else {
+                for (int position = prefixLength - 1; position >= 0; position--) {
+                    this->pointerIndex->moveOccurrence(this->items[position], position + delta, position);
+                }
+            }
+        }
+    }
+
+public:
+
+    typedef typename std::vector<T*>::iterator iterator;
+    typedef typename std::vector<T*>::const_iterator const_iterator;
+    typedef typename std::vector<T*>::reverse_iterator reverse_iterator;
+    typedef typename std::vector<T*>::const_reverse_iterator const_reverse_iterator;
+
+    /*
+     Creates an empty list.
+     */
+    ArrayList() {
+        this->ownsData = false;
+        this->pointerIndex = nullptr;
+    }
+
+    /*
+     Creates a non-owning copy of the specified list.
+     */
+    ArrayList(const ArrayList<T>& other) {
+        this->items = other.items;
+        this->ownsData = false;
+        this->pointerIndex = nullptr;
+        this->setIndexed(other.pointerIndex != nullptr);
+    }
+
+    /*
+     Creates a list by taking over the array of the specified list, which is
+     left empty. Runs in constant time.
+     */
+    ArrayList(ArrayList<T>&& other) {
+        this->items.swap(other.items);
+        this->ownsData = other.ownsData;
+        this->pointerIndex = other.pointerIndex;
+        other.ownsData = false;
+        other.pointerIndex = nullptr;
+    }
+
+    ArrayList<T>& operator=(const ArrayList<T>& other) {
+        if (this != &other) {
+            this->clear();
+            this->items = other.items;
+            this->ownsData = false;
+            this->invalidateIndex();
+        }
+        return *this;
+    }
+
+    ArrayList<T>& operator=(ArrayList<T>&& other) {
+        if (this != &other) {
+            this->clear();
+            this->items.swap(other.items);
+            this->ownsData = other.ownsData;
+            delete this->pointerIndex;
+            this->pointerIndex = other.pointerIndex;
+            other.ownsData = false;
+            other.pointerIndex = nullptr;
+        }
+        return *this;
+    }
+
+    /*
+     Destroys this list, and its data if this list owns it.
+     */
+    ~ArrayList() {
+        this->clear();
+        delete this->pointerIndex;
+    }
+
+    /*
+     Removes every element from this list. If this list owns its data, the
+     data is deleted as well.
+     */
+    void clear() {
+        if (this->ownsData) {
+            for (T* item : this->items) {
+                delete item;
+            }
+        }
+        this->items.clear();
+        if (this->pointerIndex != nullptr) {
+            this->pointerIndex->clear();
+        }
+    }
+
+    bool getOwnsData() {
+        return this->ownsData;
+    }
+
+    void setOwnsData(bool ownsData) {
+        this->ownsData = ownsData;
+    }
+
+    /*
+     Turns the pointer index of this list on or off, as with Chain.
+     */
+    void setIndexed(bool indexed) {
+        if (indexed && this->pointerIndex == nullptr) {
+            this->pointerIndex = new PointerIndex<T>();
+            this->pointerIndex->rebuild(this->items);
+        }
+        else if (!indexed && this->pointerIndex != nullptr) {
+            delete this->pointerIndex;
+            this->pointerIndex = nullptr;
+        }
+    }
+
+    bool isIndexed() {
+        return this->pointerIndex != nullptr;
+    }
+
+    /*
+     Returns true if and only if one of the pointers managed by this list
+     has the same value as the specified pointer.
+     */
+    bool contains(T* data) {
+        if (this->pointerIndex != nullptr) {
+            return this->getFreshIndex()->contains(data);
+        }
+        return this->getIndex(data) >= 0;
+    }
+
+    /*
+     Reserves room for the specified number of elements, so that appending up
+     to that many does not reallocate.
+     */
+    void reserve(int capacity) {
+        this->items.reserve(capacity);
+    }
+
+    /*
+     Returns true if and only if this list has no elements.
+     */
+    bool isEmpty() {
+        return this->items.empty();
+    }
+
+    /*
+     Returns the number of elements in this list.
+     */
+    int getSize() {
+        return (int)this->items.size();
+    }
+
+    /*
+     Returns a pointer to the data stored at the specified position of this
+     list, or the null pointer if there is no such position.
+     */
+    T* peek(int position) {
+        if (position < 0 || position >= (int)this->items.size()) {
+            return nullptr;
+        }
+        return this->items[position];
+    }
+
+    /*
+     Sets the data at the specified position. If the position does not exist
+     in this list, this method does nothing.
+     */
+    void setData(T* data, int position) {
+        if (position >= 0 && position < (int)this->items.size()) {
+            if (this->pointerIndex != nullptr) {
+                this->pointerIndex->replace(this->items[position], data, position);
+            }
+            this->items[position] = data;
+        }
+    }
+
+    /*
+     Returns the index of the first occurance of the specified data pointer
+     in this list, or a negative number if it is not in this list.
+     */
+    int getIndex(T* data) {
+        if (this->pointerIndex != nullptr) {
+            return this->getFreshIndex()->getPosition(data);
+        }
+        int size = (int)this->items.size();
+        for (int k = 0; k < size; k++) {
+            if (this->items[k] == data) {
+                return k;
+            }
+        }
+        return -1;
+    }
+
+    void insertAtStart(T* data) {
+        this->insertAtPosition(0, data);
+    }
+
+    void insertAtEnd(T* data) {
+        if (this->pointerIndex != nullptr) {
+            this->pointerIndex->addAtEnd(data, (int)this->items.size());
+        }
+        this->items.push_back(data);
+    }
+
+    T* removeFromStart() {
+        return this->removeFromPosition(0);
+    }
+
+    T* removeFromEnd() {
+        T* result = nullptr;
+        if (!this->items.empty()) {
+            result = this->items.back();
+            this->items.pop_back();
+            if (this->pointerIndex != nullptr) {
+                this->pointerIndex->removeFromEnd(result);
+            }
+        }
+        return result;
+    }
+
+    /*
+     Inserts the specified data into the list in the specified position. If
+     the position is past the end of the list, the data is inserted at the
+     end.
+     */
+    void insertAtPosition(int position, T* data) {
+        if (position < 0) {
+            position = 0;
+        }
+        if (position > (int)this->items.size()) {
+            position = (int)this->items.size();
+        }
+        this->items.insert(this->items.begin() + position, data);
+        if (this->pointerIndex != nullptr) {
+            this->reindexAfterShift(position, position + 1, 1);
+            this->pointerIndex->insertAt(data, position);
+        }
+    }
+
+    /*
+     Removes the element at the specified position, and returns its data. If
+     there is no element in the specified position, this method leaves the
+     list unaltered and returns the null pointer.
+     */
+    T* removeFromPosition(int position) {
+        T* result = nullptr;
+        if (position >= 0 && position < (int)this->items.size()) {
+            result = this->items[position];
+            if (this->pointerIndex != nullptr) {
+                this->pointerIndex->removeAt(result, position);
+            }
+            this->items.erase(this->items.begin() + position);
+            this->reindexAfterShift(position, position, -1);
+        }
+        return result;
+    }
+
+    /*
+     Splits this list after the specified position, removing all elements
+     after that position from this list, and returning them as another list.
+     The caller is responsible for deleting the returned list.
+     */
+    ArrayList<T>* splitAfter(int position) {
+        ArrayList<T>* result = new ArrayList<T>();
+        result->ownsData = this->ownsData;
+        if (position >= 0 && position < (int)this->items.size() - 1) {
+            result->items.assign(this->items.begin() + position + 1, this->items.end());
+            if (this->pointerIndex != nullptr) {
+                for (int k = (int)this->items.size() - 1; k > position; k--) {
+                    this->pointerIndex->removeFromEnd(this->items[k]);
+                }
+            }
+            this->items.resize(position + 1);
+            result->setIndexed(this->pointerIndex != nullptr);
+        }
+        return result;
+    }
+
+    /*
+     Appends the specified list to this one, leaving the specified list empty.
+     */
+    void append(ArrayList<T>* suffix) {
+        if (this->pointerIndex != nullptr) {
+            int position = (int)this->items.size();
+            for (T* item : suffix->items) {
+                this->pointerIndex->addAtEnd(item, position);
+                position++;
+            }
+        }
+        this->items.insert(this->items.end(), suffix->items.begin(), suffix->items.end());
+        suffix->items.clear();
+        if (suffix->pointerIndex != nullptr) {
+            suffix->pointerIndex->clear();
+        }
+    }
+
+    /*
+     Prepends the specified list to this one, leaving the specified list
+     empty.
+     */
+    void prepend(ArrayList<T>* prefix) {
+        if (this->pointerIndex != nullptr) {
+            for (int k = (int)prefix->items.size() - 1; k >= 0; k--) {
+                this->pointerIndex->addAtStart(prefix->items[k]);
+            }
+        }
+        this->items.insert(this->items.begin(), prefix->items.begin(), prefix->items.end());
+        prefix->items.clear();
+        if (prefix->pointerIndex != nullptr) {
+            prefix->pointerIndex->clear();
+        }
+    }
+
+    iterator begin() {
+        return this->items.begin();
+    }
+
+    iterator end() {
+        return this->items.end();
+    }
+
+    const_iterator begin() const {
+        return this->items.begin();
+    }
+
+    const_iterator end() const {
+        return this->items.end();
+    }
+
+    const_iterator cbegin() const {
+        return this->items.cbegin();
+    }
+
+    const_iterator cend() const {
+        return this->items.cend();
+    }
+
+    reverse_iterator rbegin() {
+        return this->items.rbegin();
+    }
+
+    reverse_iterator rend() {
+        return this->items.rend();
+    }
+
+    const_reverse_iterator rbegin() const {
+        return this->items.rbegin();
+    }
+
+    const_reverse_iterator rend() const {
+        return this->items.rend();
+    }
+
+    /*
+     Adds the memory held by this list to the specified report, under the
+     specified name: the list object, its array (with spare capacity) and
+     the index, if any.
+     */
+    void reportMemory(MemoryReport* report, const std::string& name) {
+        report->add(name + ".object", 1, sizeof(*this));
+        report->add(name + ".items", (long long)this->items.size(), this->items.capacity() * sizeof(T*));
+        if (this->pointerIndex != nullptr) {
+            this->pointerIndex->reportMemory(report, name + ".index");
+        }
+    }
+
+    /*
+     Returns a string representation of this list.
+     */
+    std::string toString() {
+        std::ostringstream sout;
+        sout << "ArrayList at " << this << std::endl;
+        sout << this->items.size() << " elements, room for " << this->items.capacity() << std::endl;
+        return sout.str();
+    }
+
+};
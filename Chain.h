@@ -1,10 +1,15 @@
 #pragma once
 
+#include <cstddef>
 #include <iostream>
+#include <iterator>
 #include <string>
 #include <sstream>
 
+#include "MemoryReport.h"
 #include "Node.h"
+#include "NodePool.h"
+#include "PointerIndex.h"
 
 
 /*
@@ -34,8 +39,311 @@ protected:
      */
     int numNodes;
 
+    /*
+     Pool that this chain takes its nodes from, or the null pointer if nodes
+     are allocated individually with new and delete.
+     */
+    NodePool<T>* nodePool;
+
+    /*
+     True if this chain owns the data its nodes point to. An owning chain
+     deletes its data when it is cleared or destroyed. Data returned by one
+     of the remove methods is handed back to the caller and is no longer
+     owned by the chain.
+     */
+    bool ownsData;
+
+    /*
+     Hash index from data pointers to positions, or the null pointer if this
+     chain is not indexed. See setIndexed.
+     */
+    PointerIndex<T>* pointerIndex;
+
+    /*
+     The node most recently reached by position, and its position, so that
+     positional access near the previous one (as in a loop over peek(k))
+     takes a few steps instead of a walk from one of the ends. The finger is
+     unset when fingerNode is the null pointer. Every method that moves or
+     destroys nodes must keep it correct or unset it.
+     */
+    Node<T>* fingerNode;
+
+    int fingerPosition;
+
+    /*
+     Forgets the finger.
+     */
+    void resetFinger() {
+        this->fingerNode = nullptr;
+        this->fingerPosition = 0;
+    }
+
+    /*
+     Makes this chain empty without touching its nodes. Used after the nodes
+     have been handed over to another chain.
+     */
+    void release() {
+        this->startNode = nullptr;
+        this->endNode = nullptr;
+        this->numNodes = 0;
+        this->resetFinger();
+        if (this->pointerIndex != nullptr) {
+            this->pointerIndex->clear();
+        }
+    }
+
+    /*
+     Records in the index, if there is one, that the elements after an
+     insertion or removal moved by delta positions (positive for an
+     insertion). The prefixLength elements before the change, the last of
+     which is prefixEnd, kept their positions; the elements from suffixStart,
+     now at position suffixPosition, to the end moved. Whichever side is
+     shorter is walked, so this takes time proportional to the smaller of
+     the two. Removed elements must be recorded with removeAt before this
+     is called, and inserted ones with insertAt after.
+     */
+    void reindexAfterShift(Node<T>* prefixEnd, int prefixLength, Node<T>* suffixStart, int suffixPosition, int delta) {
+        if (this->pointerIndex == nullptr || this->pointerIndex->isStale()) {
+            return;
+        }
+        int suffixLength = this->numNodes - suffixPosition;
+        if (suffixLength <= prefixLength) {
+            if (delta > 0) {
+                Node<T>* node = this->endNode;
+                for (int position = this->numNodes - 1; position >= suffixPosition; position--) {
+                    this->pointerIndex->moveOccurrence(node->getData(), position - delta, position);
+                    node = node->getPreviousNode();
+                }
+            }
+            else {
+                Node<T>* node = suffixStart;
+                for (int position = suffixPosition; position < this->numNodes; position++) {
+                    this->pointerIndex->moveOccurrence(node->getData(), position - delta, position);
+                    node = node->getNextNode();
+                }
+            }
+        }
+        else {
+            // move everything, then move the prefix back
+            this->pointerIndex->moveAllPositions(delta);
+            if (delta > 0) {
+                Node<T>* node = this->startNode;
+                for (int position = 0; position < prefixLength; position++) {
+                    this->pointerIndex->moveOccurrence(node->getData(), position + delta, position);
+                    node = node->getNextNode();
+                }
+            }
+            else {
+                Node<T>* node = prefixEnd;
+                for (int position = prefixLength - 1; position >= 0; position--) {
+                    this->pointerIndex->moveOccurrence(node->getData(), position + delta, position);
+                    node = node->getPreviousNode();
+                }
+            }
+        }
+    }
+
+    /*
+     Returns the index of this chain, rebuilt first if it is stale. This
+     chain must be indexed.
+     */
+    PointerIndex<T>* getFreshIndex() {
+        if (this->pointerIndex->isStale()) {
+            this->pointerIndex->rebuild(*this);
+        }
+        return this->pointerIndex;
+    }
+
+    /*
+     Takes over the nodes, pool and ownership mode of the specified chain,
+     leaving it empty and non-owning. This chain must be empty.
+     */
+    void takeNodesFrom(Chain<T>& other) {
+        this->startNode = other.startNode;
+        this->endNode = other.endNode;
+        this->numNodes = other.numNodes;
+        this->nodePool = other.nodePool;
+        this->ownsData = other.ownsData;
+        this->fingerNode = other.fingerNode;
+        this->fingerPosition = other.fingerPosition;
+        delete this->pointerIndex;
+        this->pointerIndex = other.pointerIndex;
+        other.pointerIndex = nullptr;
+        other.release();
+        other.ownsData = false;
+    }
+
+    /*
+     Returns the node at the specified position, walking from whichever of
+     the start node, the end node and the finger is nearest, or the null
+     pointer if there is no such position. The node found becomes the new
+     finger.
+     */
+    Node<T>* nodeAt(int position) {
+        if (position < 0 || position >= this->numNodes) {
+            return nullptr;
+        }
+        Node<T>* currentNode = this->startNode;
+        int currentPosition = 0;
+        int distance = position;
+        if (this->numNodes - 1 - position < distance) {
+            currentNode = this->endNode;
+            currentPosition = this->numNodes - 1;
+            distance = this->numNodes - 1 - position;
+        }
+        if (this->fingerNode != nullptr) {
+            int fingerDistance = position - this->fingerPosition;
+            if (fingerDistance < 0) {
+                fingerDistance = -fingerDistance;
+            }
+            if (fingerDistance < distance) {
+                currentNode = this->fingerNode;
+                currentPosition = this->fingerPosition;
+            }
+        }
+        while (currentPosition < position) {
+            currentNode = currentNode->getNextNode();
+            currentPosition++;
+        }
+        while (currentPosition > position) {
+            currentNode = currentNode->getPreviousNode();
+            currentPosition--;
+        }
+        this->fingerNode = currentNode;
+        this->fingerPosition = position;
+        return currentNode;
+    }
+
+    /*
+     Returns a new unlinked node containing the specified data.
+     */
+    Node<T>* createNode(T* data) {
+        if (this->nodePool != nullptr) {
+            return this->nodePool->allocate(data);
+        }
+        return new Node<T>(data);
+    }
+
+    /*
+     Disposes of a node that has been unlinked from this chain.
+     */
+    void destroyNode(Node<T>* node) {
+        if (this->nodePool != nullptr) {
+            this->nodePool->release(node);
+        }
+        else {
+            delete node;
+        }
+    }
+
 public:
 
+    /*
+     A bidirectional iterator over the data pointers managed by a chain.
+     Dereferencing an iterator yields the data pointer stored in its node.
+     The past-the-end iterator remembers its chain, so it can be decremented
+     back onto the end node; this is what makes reverse iteration possible.
+     DataPointer is T* for mutable iteration and const T* for const iteration.
+     */
+    template <typename DataPointer>
+    class ChainIterator {
+
+        friend class Chain<T>;
+
+        template <typename OtherDataPointer>
+        friend class ChainIterator;
+
+    protected:
+
+        /*
+         The node this iterator is positioned on, or the null pointer if this
+         iterator is past the end of its chain.
+         */
+        Node<T>* currentNode;
+
+        /*
+         The chain this iterator walks over.
+         */
+        const Chain<T>* chain;
+
+        ChainIterator(Node<T>* currentNode, const Chain<T>* chain) {
+            this->currentNode = currentNode;
+            this->chain = chain;
+        }
+
+    public:
+
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef DataPointer value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef DataPointer pointer;
+        typedef DataPointer reference;
+
+        /*
+         Creates an iterator that is not attached to any chain.
+         */
+        ChainIterator() {
+            this->currentNode = nullptr;
+            this->chain = nullptr;
+        }
+
+        /*
+         Allows a mutable iterator to be used where a const iterator is expected.
+         */
+        operator ChainIterator<const T*>() const {
+            return ChainIterator<const T*>(this->currentNode, this->chain);
+        }
+
+        reference operator*() const {
+            return this->currentNode->getData();
+        }
+
+        pointer operator->() const {
+            return this->currentNode->getData();
+        }
+
+        ChainIterator& operator++() {
+            this->currentNode = this->currentNode->getNextNode();
+            return *this;
+        }
+
+        ChainIterator operator++(int) {
+            ChainIterator previous = *this;
+            ++(*this);
+            return previous;
+        }
+
+        ChainIterator& operator--() {
+            if (this->currentNode == nullptr) {
+                this->currentNode = this->chain->endNode;
+            }
+            else {
+                this->currentNode = this->currentNode->getPreviousNode();
+            }
+            return *this;
+        }
+
+        ChainIterator operator--(int) {
+            ChainIterator previous = *this;
+            --(*this);
+            return previous;
+        }
+
+        bool operator==(const ChainIterator& other) const {
+            return this->currentNode == other.currentNode;
+        }
+
+        bool operator!=(const ChainIterator& other) const {
+            return this->currentNode != other.currentNode;
+        }
+
+    };
+
+    typedef ChainIterator<T*> iterator;
+    typedef ChainIterator<const T*> const_iterator;
+    typedef std::reverse_iterator<iterator> reverse_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
     /*
      Creates an empty chain.
      */
@@ -43,6 +351,176 @@ public:
         this->startNode = nullptr;
         this->endNode = nullptr;
         this->numNodes = 0;
+        this->nodePool = nullptr;
+        this->ownsData = false;
+        this->pointerIndex = nullptr;
+        this->resetFinger();
+    }
+
+    /*
+     Creates an empty chain that takes its nodes from the specified pool. The
+     pool may be shared with other chains and must outlive this chain.
+     */
+    Chain(NodePool<T>* nodePool) {
+        this->startNode = nullptr;
+        this->endNode = nullptr;
+        this->numNodes = 0;
+        this->nodePool = nodePool;
+        this->ownsData = false;
+        this->pointerIndex = nullptr;
+        this->resetFinger();
+    }
+
+    /*
+     Creates a chain with its own nodes pointing to the same data as the
+     specified chain, in the same order. The copy never owns its data, so
+     copying an owning chain does not lead to the data being deleted twice.
+     */
+    Chain(const Chain<T>& other) {
+        this->startNode = nullptr;
+        this->endNode = nullptr;
+        this->numNodes = 0;
+        this->nodePool = other.nodePool;
+        this->ownsData = false;
+        this->pointerIndex = nullptr;
+        this->resetFinger();
+        this->setIndexed(other.pointerIndex != nullptr);
+        for (Node<T>* currentNode = other.startNode; currentNode != nullptr; currentNode = currentNode->getNextNode()) {
+            this->insertAtEnd(currentNode->getData());
+        }
+    }
+
+    /*
+     Creates a chain by taking over the nodes of the specified chain, which is
+     left empty. Runs in constant time.
+     */
+    Chain(Chain<T>&& other) {
+        this->startNode = nullptr;
+        this->endNode = nullptr;
+        this->numNodes = 0;
+        this->pointerIndex = nullptr;
+        this->resetFinger();
+        this->takeNodesFrom(other);
+    }
+
+    /*
+     Replaces the contents of this chain with a non-owning copy of the
+     specified chain.
+     */
+    Chain<T>& operator=(const Chain<T>& other) {
+        if (this != &other) {
+            this->clear();
+            this->nodePool = other.nodePool;
+            this->ownsData = false;
+            for (Node<T>* currentNode = other.startNode; currentNode != nullptr; currentNode = currentNode->getNextNode()) {
+                this->insertAtEnd(currentNode->getData());
+            }
+        }
+        return *this;
+    }
+
+    /*
+     Replaces the contents of this chain with the nodes of the specified
+     chain, which is left empty. Runs in time proportional to the size of
+     this chain, since its old nodes have to be destroyed.
+     */
+    Chain<T>& operator=(Chain<T>&& other) {
+        if (this != &other) {
+            this->clear();
+            this->takeNodesFrom(other);
+        }
+        return *this;
+    }
+
+    /*
+     Destroys the nodes of this chain, and its data if this chain owns it.
+     */
+    virtual ~Chain() {
+        this->clear();
+        delete this->pointerIndex;
+    }
+
+    /*
+     Removes every node from this chain. If this chain owns its data, the data
+     is deleted as well.
+     */
+    void clear() {
+        Node<T>* currentNode = this->startNode;
+        while (currentNode != nullptr) {
+            Node<T>* nextNode = currentNode->getNextNode();
+            if (this->ownsData) {
+                delete currentNode->getData();
+            }
+            this->destroyNode(currentNode);
+            currentNode = nextNode;
+        }
+        this->release();
+    }
+
+    /*
+     Returns true if and only if this chain owns the data its nodes point to.
+     */
+    bool getOwnsData() {
+        return this->ownsData;
+    }
+
+    /*
+     Sets whether this chain owns the data its nodes point to. Chains do not
+     own their data unless this is set to true.
+     */
+    void setOwnsData(bool ownsData) {
+        this->ownsData = ownsData;
+    }
+
+    /*
+     Turns the pointer index of this chain on or off. While it is on, the
+     chain keeps a hash index from data pointers to positions, so that
+     contains and List::getIndex take constant expected time instead of a
+     scan. The index costs one hash entry per distinct pointer. Ends are
+     kept up in constant time; other edits, splits and joins pay for the
+     elements whose positions they move, walking whichever side is
+     shorter (see PointerIndex).
+     */
+    void setIndexed(bool indexed) {
+        if (indexed && this->pointerIndex == nullptr) {
+            this->pointerIndex = new PointerIndex<T>();
+            this->pointerIndex->rebuild(*this);
+        }
+        else if (!indexed && this->pointerIndex != nullptr) {
+            delete this->pointerIndex;
+            this->pointerIndex = nullptr;
+        }
+    }
+
+    /*
+     Returns true if and only if this chain keeps a pointer index.
+     */
+    bool isIndexed() {
+        return this->pointerIndex != nullptr;
+    }
+
+    /*
+     Returns true if and only if one of the pointers managed by this chain
+     has the same value as the specified pointer.
+     */
+    bool contains(T* data) {
+        if (this->pointerIndex != nullptr) {
+            return this->getFreshIndex()->contains(data);
+        }
+        for (Node<T>* currentNode = this->startNode; currentNode != nullptr; currentNode = currentNode->getNextNode()) {
+            if (currentNode->getData() == data) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /*
+     Returns the pool this chain takes its nodes from, or the null pointer if
+     it uses new and delete.
+     */
+    NodePool<T>* getNodePool() {
+        return this->nodePool;
     }
 
     /*
@@ -65,14 +543,11 @@ public:
      */
     T* peek(int position) {
         T* result;
-        if (this->isEmpty()) {
+        Node<T>* currentNode = this->nodeAt(position);
+        if (currentNode == nullptr) {
             result = nullptr;
         }
         else {
-            Node<T>* currentNode = this->startNode;
-            for (int k = 0; k < position; k++) {
-                currentNode = currentNode->getNextNode();
-            }
             result = currentNode->getData();
         }
         return result;
@@ -83,10 +558,10 @@ public:
      does not exist in this chain, this method does nothing.
      */
     void setData(T* data, int position) {
-        if (!this->isEmpty()) {
-            Node<T>* currentNode = this->startNode;
-            for (int k = 0; k < position; k++) {
-                currentNode = currentNode->getNextNode();
+        Node<T>* currentNode = this->nodeAt(position);
+        if (currentNode != nullptr) {
+            if (this->pointerIndex != nullptr) {
+                this->pointerIndex->replace(currentNode->getData(), data, position);
             }
             currentNode->setData(data);
         }
@@ -96,7 +571,11 @@ public:
      Inserts the specified data at the beginning of this chain.
      */
     void insertAtStart(T* data) {
-        Node<T>* newStart = new Node<T>(data);
+        if (this->pointerIndex != nullptr) {
+            this->pointerIndex->addAtStart(data);
+        }
+        Node<T>* newStart = this->createNode(data);
+        this->fingerPosition++;
         if (this->isEmpty()) {
             this->startNode = newStart;
             this->endNode = newStart;
@@ -120,16 +599,29 @@ public:
         }
         else if (this->numNodes == 1) {
             result = this->startNode->getData();
-            delete startNode;
+            if (this->pointerIndex != nullptr) {
+                this->pointerIndex->removeFromStart(result);
+            }
+            this->destroyNode(this->startNode);
             this->startNode = nullptr;
             this->endNode = nullptr;
             this->numNodes = 0;
+            this->resetFinger();
         }
         else {
             result = this->startNode->getData();
+            if (this->pointerIndex != nullptr) {
+                this->pointerIndex->removeFromStart(result);
+            }
             Node<T>* newStart = this->startNode->getNextNode();
             newStart->setPreviousNode(nullptr);
-            delete this->startNode;
+            if (this->fingerNode == this->startNode) {
+                this->resetFinger();
+            }
+            else {
+                this->fingerPosition--;
+            }
+            this->destroyNode(this->startNode);
             this->startNode = newStart;
             this->numNodes--;
         }
@@ -146,16 +638,26 @@ public:
         }
         else if (this->numNodes == 1) {
             result = this->endNode->getData();
-            delete startNode;
+            if (this->pointerIndex != nullptr) {
+                this->pointerIndex->removeFromEnd(result);
+            }
+            this->destroyNode(this->startNode);
             this->startNode = nullptr;
             this->endNode = nullptr;
             this->numNodes = 0;
+            this->resetFinger();
         }
         else {
             result = this->endNode->getData();
+            if (this->pointerIndex != nullptr) {
+                this->pointerIndex->removeFromEnd(result);
+            }
             Node<T>* newEnd = this->endNode->getPreviousNode();
             newEnd->setNextNode(nullptr);
-            delete this->endNode;
+            if (this->fingerNode == this->endNode) {
+                this->resetFinger();
+            }
+            this->destroyNode(this->endNode);
             this->endNode = newEnd;
             this->numNodes--;
         }
@@ -163,7 +665,10 @@ public:
     }
 
     void insertAtEnd(T* data) {
-        Node<T>* newEnd = new Node<T>(data);
+        if (this->pointerIndex != nullptr) {
+            this->pointerIndex->addAtEnd(data, this->numNodes);
+        }
+        Node<T>* newEnd = this->createNode(data);
         if (this->isEmpty()) {
             this->endNode = newEnd;
             this->startNode = newEnd;
@@ -177,6 +682,81 @@ public:
         }
     }
 
+    /*
+     Returns an iterator positioned on the start node of this chain. Walking
+     from begin() to end() visits every node exactly once, so a full scan is
+     linear, unlike a loop over peek(k) which restarts from the start node on
+     every call.
+     */
+    iterator begin() {
+        return iterator(this->startNode, this);
+    }
+
+    /*
+     Returns the past-the-end iterator of this chain.
+     */
+    iterator end() {
+        return iterator(nullptr, this);
+    }
+
+    const_iterator begin() const {
+        return const_iterator(this->startNode, this);
+    }
+
+    const_iterator end() const {
+        return const_iterator(nullptr, this);
+    }
+
+    const_iterator cbegin() const {
+        return this->begin();
+    }
+
+    const_iterator cend() const {
+        return this->end();
+    }
+
+    /*
+     Returns an iterator that walks this chain from the end node back to the
+     start node.
+     */
+    reverse_iterator rbegin() {
+        return reverse_iterator(this->end());
+    }
+
+    reverse_iterator rend() {
+        return reverse_iterator(this->begin());
+    }
+
+    const_reverse_iterator rbegin() const {
+        return const_reverse_iterator(this->end());
+    }
+
+    const_reverse_iterator rend() const {
+        return const_reverse_iterator(this->begin());
+    }
+
+    const_reverse_iterator crbegin() const {
+        return this->rbegin();
+    }
+
+    const_reverse_iterator crend() const {
+        return this->rend();
+    }
+
+    /*
+     Adds the memory held by this chain to the specified report, under the
+     specified name: the chain object, one node per element and the index,
+     if any. Nodes taken from a pool are counted here as well, and the
+     pool's own report counts only its spare nodes.
+     */
+    void reportMemory(MemoryReport* report, const std::string& name) {
+        report->add(name + ".object", 1, sizeof(*this));
+        report->add(name + ".nodes", this->numNodes, this->numNodes * sizeof(Node<T>));
+        if (this->pointerIndex != nullptr) {
+            this->pointerIndex->reportMemory(report, name + ".index");
+        }
+    }
+
     /*
      Returns a string representation of this chain.
      */
@@ -0,0 +1,1140 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ArrayList.h"
+#include "Chain.h"
+#include "ConcurrentQueue.h"
+#include "List.h"
+#include "MemoryReport.h"
+#include "MemoryUsage.h"
+#include "NodePool.h"
+#include "SingleProducerQueue.h"
+#include "TestResults.h"
+#include "UnrolledList.h"
+
+class ChainTester {
+
+protected:
+
+    /*
+     An item that keeps count of how many instances of it are alive, so the
+     tests can tell whether a chain deleted its data.
+     */
+    class CountedItem {
+
+    public:
+
+        int* counter;
+
+        CountedItem(int* counter) {
+            this->counter = counter;
+            (*this->counter)++;
+        }
+
+        ~CountedItem() {
+            (*this->counter)--;
+        }
+
+    };
+
+    /*
+     A list that can tell whether its index has gone stale, so the tests can
+     check that edits keep the index exact rather than leaving it to be
+     rebuilt.
+     */
+    template <typename ListType>
+    class IndexProbe : public ListType {
+
+    public:
+
+        bool isIndexStale() {
+            return this->pointerIndex->isStale();
+        }
+
+    };
+
+public:
+
+    /*
+     Test forward iteration with begin(), end() and range-for.
+     */
+    static TestResults* test0() {
+        std::ostringstream sout;
+        int pointsPossible = 0;
+        int pointsEarned = 0;
+        //
+        int values[5] = { 0, 1, 2, 3, 4 };
+        List<int>* list = new List<int>();
+        for (int k = 0; k < 5; k++) {
+            list->insertAtEnd(&values[k]);
+        }
+        //
+        pointsPossible++;
+        int k = 0;
+        bool inOrder = true;
+        for (int* item : *list) {
+            if (item != &values[k]) {
+                inOrder = false;
+            }
+            k++;
+        }
+        if (inOrder && k == 5) {
+            pointsEarned++;
+        }
+        else {
+            sout << "range-for visited the wrong nodes" << std::endl;
+        }
+        //
+        pointsPossible++;
+        List<int>* empty = new List<int>();
+        if (empty->begin() == empty->end()) {
+            pointsEarned++;
+        }
+        else {
+            sout << "begin() and end() differ on an empty list" << std::endl;
+        }
+        //
+        pointsPossible++;
+        if (list->getIndex(&values[3]) == 3 && list->getIndex(nullptr) < 0) {
+            pointsEarned++;
+        }
+        else {
+            sout << "getIndex returned an incorrect value" << std::endl;
+        }
+
+        std::cout << "ChainTester::test0 results:" << std::endl;
+        return new TestResults(pointsPossible, pointsEarned, sout.str());
+    }
+
+    /*
+     Test reverse iteration, decrementing from end(), and const iteration.
+     */
+    static TestResults* test1() {
+        std::ostringstream sout;
+        int pointsPossible = 0;
+        int pointsEarned = 0;
+        //
+        int values[4] = { 0, 1, 2, 3 };
+        List<int>* list = new List<int>();
+        for (int k = 0; k < 4; k++) {
+            list->insertAtEnd(&values[k]);
+        }
+        //
+        pointsPossible++;
+        int k = 3;
+        bool inOrder = true;
+        for (List<int>::reverse_iterator it = list->rbegin(); it != list->rend(); ++it) {
+            if (*it != &values[k]) {
+                inOrder = false;
+            }
+            k--;
+        }
+        if (inOrder && k == -1) {
+            pointsEarned++;
+        }
+        else {
+            sout << "reverse iteration visited the wrong nodes" << std::endl;
+        }
+        //
+        pointsPossible++;
+        List<int>::iterator last = list->end();
+        --last;
+        if (*last == &values[3]) {
+            pointsEarned++;
+        }
+        else {
+            sout << "decrementing end() did not reach the end node" << std::endl;
+        }
+        //
+        pointsPossible++;
+        const List<int>* constList = list;
+        int sum = 0;
+        for (List<int>::const_iterator it = constList->begin(); it != constList->end(); it++) {
+            sum += **it;
+        }
+        if (sum == 6) {
+            pointsEarned++;
+        }
+        else {
+            sout << "const iteration visited the wrong nodes" << std::endl;
+        }
+
+        std::cout << "ChainTester::test1 results:" << std::endl;
+        return new TestResults(pointsPossible, pointsEarned, sout.str());
+    }
+
+    /*
+     Test lists that take their nodes from a NodePool.
+     */
+    static TestResults* test2() {
+        std::ostringstream sout;
+        int pointsPossible = 0;
+        int pointsEarned = 0;
+        //
+        int values[3] = { 0, 1, 2 };
+        NodePool<int>* pool = new NodePool<int>(2);
+        List<int>* list = new List<int>(pool);
+        for (int k = 0; k < 3; k++) {
+            list->insertAtEnd(&values[k]);
+        }
+        //
+        pointsPossible++;
+        if (pool->getNumLiveNodes() == 3 && pool->getCapacity() == 4) {
+            pointsEarned++;
+        }
+        else {
+            sout << "pool did not hand out the expected number of nodes" << std::endl;
+        }
+        //
+        pointsPossible++;
+        list->removeFromStart();
+        list->removeFromEnd();
+        list->insertAtStart(&values[0]);
+        list->insertAtPosition(1, &values[2]);
+        if (pool->getNumLiveNodes() == 3 && pool->getCapacity() == 4
+            && list->getIndex(&values[2]) == 1) {
+            pointsEarned++;
+        }
+        else {
+            sout << "released nodes were not reused" << std::endl;
+        }
+        //
+        pointsPossible++;
+        List<int>* lastHalf = list->splitAfter(0);
+        if (lastHalf->getNodePool() == pool && lastHalf->getSize() == 2) {
+            pointsEarned++;
+        }
+        else {
+            sout << "splitAfter did not keep the node pool" << std::endl;
+        }
+
+        std::cout << "ChainTester::test2 results:" << std::endl;
+        return new TestResults(pointsPossible, pointsEarned, sout.str());
+    }
+
+    /*
+     Test destructors, ownership mode, copying and moving.
+     */
+    static TestResults* test3() {
+        std::ostringstream sout;
+        int pointsPossible = 0;
+        int pointsEarned = 0;
+        //
+        int alive = 0;
+        List<CountedItem>* owning = new List<CountedItem>();
+        owning->setOwnsData(true);
+        for (int k = 0; k < 4; k++) {
+            owning->insertAtEnd(new CountedItem(&alive));
+        }
+        //
+        pointsPossible++;
+        List<CountedItem>* copy = new List<CountedItem>(*owning);
+        delete copy;
+        if (alive == 4 && owning->getSize() == 4) {
+            pointsEarned++;
+        }
+        else {
+            sout << "deleting a copy of an owning list deleted its data" << std::endl;
+        }
+        //
+        pointsPossible++;
+        List<CountedItem> moved(std::move(*owning));
+        if (owning->isEmpty() && moved.getSize() == 4 && moved.getOwnsData() && !owning->getOwnsData()) {
+            pointsEarned++;
+        }
+        else {
+            sout << "move construction did not take over the nodes" << std::endl;
+        }
+        delete owning;
+        //
+        pointsPossible++;
+        List<CountedItem>* lastHalf = moved.splitAfter(1);
+        delete lastHalf;
+        moved.clear();
+        if (alive == 0 && moved.isEmpty()) {
+            pointsEarned++;
+        }
+        else {
+            sout << "owning lists did not delete their data" << std::endl;
+        }
+        //
+        pointsPossible++;
+        int values[2] = { 0, 1 };
+        List<int>* prefix = new List<int>();
+        List<int>* suffix = new List<int>();
+        prefix->insertAtEnd(&values[0]);
+        suffix->insertAtEnd(&values[1]);
+        prefix->append(suffix);
+        delete suffix;
+        if (prefix->getSize() == 2 && *prefix->peek(1) == 1) {
+            pointsEarned++;
+        }
+        else {
+            sout << "append did not move the nodes of its argument" << std::endl;
+        }
+        delete prefix;
+
+        std::cout << "ChainTester::test3 results:" << std::endl;
+        return new TestResults(pointsPossible, pointsEarned, sout.str());
+    }
+
+    /*
+     Soak test: millions of positional inserts, removals and splits should run
+     in flat memory.
+     */
+    static TestResults* test4() {
+        std::ostringstream sout;
+        int pointsPossible = 0;
+        int pointsEarned = 0;
+        //
+        int values[16];
+        List<int>* list = new List<int>();
+        for (int k = 0; k < 16; k++) {
+            values[k] = k;
+            list->insertAtEnd(&values[k]);
+        }
+        long long before = 0;
+        for (int round = 0; round < 2000001; round++) {
+            if (round == 1) {
+                before = MemoryUsage::residentBytes();
+            }
+            int position = round % 15 + 1;
+            list->insertAtPosition(position, list->removeFromPosition(position - 1));
+            List<int>* lastHalf = list->splitAfter(position);
+            list->append(lastHalf);
+            delete lastHalf;
+        }
+        long long growth = MemoryUsage::residentBytes() - before;
+        //
+        pointsPossible++;
+        if (growth < 1024 * 1024) {
+            pointsEarned++;
+        }
+        else {
+            sout << "memory grew by " << growth << " bytes during the soak test" << std::endl;
+        }
+        delete list;
+
+        std::cout << "ChainTester::test4 results:" << std::endl;
+        return new TestResults(pointsPossible, pointsEarned, sout.str());
+    }
+
+    /*
+     Test UnrolledList against a std::vector under the same sequence of
+     operations.
+     */
+    static TestResults* test5() {
+        std::ostringstream sout;
+        int pointsPossible = 0;
+        int pointsEarned = 0;
+        //
+        int values[100];
+        std::vector<int*> expected;
+        UnrolledList<int, 4>* unrolled = new UnrolledList<int, 4>();
+        unsigned int seed = 12345;
+        bool sameContents = true;
+        for (int step = 0; step < 2000; step++) {
+            seed = seed * 1103515245 + 12345;
+            int choice = (seed >> 16) % 3;
+            int position = expected.empty() ? 0 : (int)((seed >> 4) % expected.size());
+            int* item = &values[step % 100];
+            if (choice < 2 || expected.empty()) {
+                expected.insert(expected.begin() + position, item);
+                unrolled->insertAtPosition(position, item);
+            }
+            else {
+                if (unrolled->removeFromPosition(position) != expected[position]) {
+                    sameContents = false;
+                }
+                expected.erase(expected.begin() + position);
+            }
+        }
+        //
+        pointsPossible++;
+        int k = 0;
+        for (int* item : *unrolled) {
+            if (item != expected[k] || item != unrolled->peek(k)) {
+                sameContents = false;
+            }
+            k++;
+        }
+        if (sameContents && k == (int)expected.size() && k == unrolled->getSize()) {
+            pointsEarned++;
+        }
+        else {
+            sout << "UnrolledList held the wrong elements" << std::endl;
+        }
+        //
+        pointsPossible++;
+        int size = unrolled->getSize();
+        UnrolledList<int, 4>* lastHalf = unrolled->splitAfter(size / 3);
+        bool splitCorrectly = unrolled->getSize() == size / 3 + 1
+            && lastHalf->getSize() == size - size / 3 - 1
+            && lastHalf->peek(0) == expected[size / 3 + 1];
+        unrolled->prepend(lastHalf);
+        unrolled->append(lastHalf);
+        if (splitCorrectly && unrolled->getSize() == size && lastHalf->isEmpty()
+            && *unrolled->rbegin() == expected[size / 3]) {
+            pointsEarned++;
+        }
+        else {
+            sout << "UnrolledList::splitAfter returned an incorrect list" << std::endl;
+        }
+        delete lastHalf;
+        delete unrolled;
+
+        std::cout << "ChainTester::test5 results:" << std::endl;
+        return new TestResults(pointsPossible, pointsEarned, sout.str());
+    }
+
+    /*
+     Test the List-compatible methods of ArrayList.
+     */
+    static TestResults* test6() {
+        std::ostringstream sout;
+        int pointsPossible = 0;
+        int pointsEarned = 0;
+        //
+        int values[5] = { 0, 1, 2, 3, 4 };
+        ArrayList<int>* list = new ArrayList<int>();
+        list->insertAtEnd(&values[1]);
+        list->insertAtEnd(&values[3]);
+        list->insertAtStart(&values[0]);
+        list->insertAtPosition(2, &values[2]);
+        list->insertAtPosition(4, &values[4]);
+        //
+        pointsPossible++;
+        bool inOrder = list->getSize() == 5;
+        for (int k = 0; k < 5; k++) {
+            if (list->peek(k) != &values[k] || list->getIndex(&values[k]) != k) {
+                inOrder = false;
+            }
+        }
+        if (inOrder && list->peek(5) == nullptr) {
+            pointsEarned++;
+        }
+        else {
+            sout << "insert methods put elements in the wrong positions" << std::endl;
+        }
+        //
+        pointsPossible++;
+        ArrayList<int>* lastHalf = list->splitAfter(1);
+        bool splitCorrectly = list->getSize() == 2 && lastHalf->getSize() == 3 && lastHalf->peek(0) == &values[2];
+        list->append(lastHalf);
+        if (splitCorrectly && list->getSize() == 5 && lastHalf->isEmpty() && *list->rbegin() == &values[4]) {
+            pointsEarned++;
+        }
+        else {
+            sout << "splitAfter and append returned incorrect lists" << std::endl;
+        }
+        //
+        pointsPossible++;
+        int* removed = list->removeFromPosition(2);
+        if (removed == &values[2] && list->removeFromStart() == &values[0]
+            && list->removeFromEnd() == &values[4] && list->getSize() == 2) {
+            pointsEarned++;
+        }
+        else {
+            sout << "remove methods returned incorrect values" << std::endl;
+        }
+        delete lastHalf;
+        delete list;
+
+        std::cout << "ChainTester::test6 results:" << std::endl;
+        return new TestResults(pointsPossible, pointsEarned, sout.str());
+    }
+
+    /*
+     Test that indexed lists answer getIndex and contains the same way as
+     unindexed ones, through end operations, middle operations, splits and
+     duplicate pointers, and that without duplicates their indexes never go
+     stale.
+     */
+    static TestResults* test7() {
+        std::ostringstream sout;
+        int pointsPossible = 0;
+        int pointsEarned = 0;
+        //
+        int values[20];
+        List<int>* plain = new List<int>();
+        List<int>* indexed = new List<int>();
+        ArrayList<int>* indexedArray = new ArrayList<int>();
+        UnrolledList<int, 4>* indexedUnrolled = new UnrolledList<int, 4>();
+        indexed->setIndexed(true);
+        indexedArray->setIndexed(true);
+        indexedUnrolled->setIndexed(true);
+        unsigned int seed = 99;
+        bool agree = true;
+        for (int step = 0; step < 3000; step++) {
+            seed = seed * 1103515245 + 12345;
+            int choice = (seed >> 16) % 6;
+            int* item = &values[(seed >> 8) % 20];
+            int size = plain->getSize();
+            if (choice == 0 || size == 0) {
+                plain->insertAtEnd(item);
+                indexed->insertAtEnd(item);
+                indexedArray->insertAtEnd(item);
+                indexedUnrolled->insertAtEnd(item);
+            }
+            else if (choice == 1) {
+                plain->insertAtStart(item);
+                indexed->insertAtStart(item);
+                indexedArray->insertAtStart(item);
+                indexedUnrolled->insertAtStart(item);
+            }
+            else if (choice == 2) {
+                plain->removeFromStart();
+                indexed->removeFromStart();
+                indexedArray->removeFromStart();
+                indexedUnrolled->removeFromStart();
+            }
+            else if (choice == 3) {
+                plain->removeFromEnd();
+                indexed->removeFromEnd();
+                indexedArray->removeFromEnd();
+                indexedUnrolled->removeFromEnd();
+            }
+            else if (choice == 4) {
+                int position = (seed >> 4) % size;
+                plain->insertAtPosition(position, item);
+                indexed->insertAtPosition(position, item);
+                indexedArray->insertAtPosition(position, item);
+                indexedUnrolled->insertAtPosition(position, item);
+            }
+            else {
+                List<int>* lastHalf = indexed->splitAfter(size / 2);
+                indexed->append(lastHalf);
+                delete lastHalf;
+            }
+            for (int k = 0; k < 20; k++) {
+                int expected = plain->getIndex(&values[k]);
+                if (indexed->getIndex(&values[k]) != expected
+                    || indexedArray->getIndex(&values[k]) != expected
+                    || indexedUnrolled->getIndex(&values[k]) != expected
+                    || indexed->contains(&values[k]) != (expected >= 0)) {
+                    agree = false;
+                }
+            }
+        }
+        //
+        pointsPossible++;
+        if (agree) {
+            pointsEarned++;
+        }
+        else {
+            sout << "indexed lists disagreed with getIndex on an unindexed list" << std::endl;
+        }
+        delete plain;
+        delete indexed;
+        delete indexedArray;
+        delete indexedUnrolled;
+        //
+        pointsPossible++;
+        int distinct[200];
+        std::vector<int*> expected;
+        std::vector<int*> spare;
+        IndexProbe<List<int>>* probed = new IndexProbe<List<int>>();
+        IndexProbe<ArrayList<int>>* probedArray = new IndexProbe<ArrayList<int>>();
+        IndexProbe<UnrolledList<int, 4>>* probedUnrolled = new IndexProbe<UnrolledList<int, 4>>();
+        probed->setIndexed(true);
+        probedArray->setIndexed(true);
+        probedUnrolled->setIndexed(true);
+        for (int k = 0; k < 200; k++) {
+            if (k < 100) {
+                expected.push_back(&distinct[k]);
+                probed->insertAtEnd(&distinct[k]);
+                probedArray->insertAtEnd(&distinct[k]);
+                probedUnrolled->insertAtEnd(&distinct[k]);
+            }
+            else {
+                spare.push_back(&distinct[k]);
+            }
+        }
+        bool exact = true;
+        for (int step = 0; step < 600 && exact; step++) {
+            seed = seed * 1103515245 + 12345;
+            int choice = (seed >> 16) % 4;
+            int size = (int)expected.size();
+            int position = (seed >> 4) % size;
+            if (choice == 0 && !spare.empty()) {
+                int* item = spare.back();
+                spare.pop_back();
+                expected.insert(expected.begin() + position, item);
+                probed->insertAtPosition(position, item);
+                probedArray->insertAtPosition(position, item);
+                probedUnrolled->insertAtPosition(position, item);
+            }
+            else if (choice == 1 && size > 1) {
+                spare.push_back(expected[position]);
+                expected.erase(expected.begin() + position);
+                probed->removeFromPosition(position);
+                probedArray->removeFromPosition(position);
+                probedUnrolled->removeFromPosition(position);
+            }
+            else if (choice == 2) {
+                // split, then put the back part back where it was
+                List<int>* back = probed->splitAfter(position);
+                ArrayList<int>* backArray = probedArray->splitAfter(position);
+                UnrolledList<int, 4>* backUnrolled = probedUnrolled->splitAfter(position);
+                exact = !probed->isIndexStale() && !probedArray->isIndexStale() && !probedUnrolled->isIndexStale()
+                    && probed->getIndex(expected[position]) == position && probed->getIndex(expected[size - 1]) < 0
+                    && probedArray->getIndex(expected[size - 1]) < 0 && probedUnrolled->getIndex(expected[size - 1]) < 0;
+                probed->append(back);
+                probedArray->append(backArray);
+                probedUnrolled->append(backUnrolled);
+                delete back;
+                delete backArray;
+                delete backUnrolled;
+            }
+            else {
+                // split, then move the back part to the front
+                List<int>* back = probed->splitAfter(position);
+                ArrayList<int>* backArray = probedArray->splitAfter(position);
+                UnrolledList<int, 4>* backUnrolled = probedUnrolled->splitAfter(position);
+                probed->prepend(back);
+                probedArray->prepend(backArray);
+                probedUnrolled->prepend(backUnrolled);
+                delete back;
+                delete backArray;
+                delete backUnrolled;
+                std::rotate(expected.begin(), expected.begin() + position + 1, expected.end());
+            }
+            exact = exact && !probed->isIndexStale() && !probedArray->isIndexStale() && !probedUnrolled->isIndexStale();
+            for (int k = 0; k < 200 && exact; k++) {
+                std::vector<int*>::iterator found = std::find(expected.begin(), expected.end(), &distinct[k]);
+                int truePosition = found == expected.end() ? -1 : (int)(found - expected.begin());
+                exact = probed->getIndex(&distinct[k]) == truePosition && probedArray->getIndex(&distinct[k]) == truePosition
+                    && probedUnrolled->getIndex(&distinct[k]) == truePosition;
+            }
+        }
+        if (exact) {
+            pointsEarned++;
+        }
+        else {
+            sout << "an index went stale or wrong through middle edits, splits, appends and prepends" << std::endl;
+        }
+        delete probed;
+        delete probedArray;
+        delete probedUnrolled;
+
+        std::cout << "ChainTester::test7 results:" << std::endl;
+        return new TestResults(pointsPossible, pointsEarned, sout.str());
+    }
+
+    /*
+     Test in-place positional inserts and removals, insertRangeAt and
+     eraseRange against a std::vector.
+     */
+    static TestResults* test8() {
+        std::ostringstream sout;
+        int pointsPossible = 0;
+        int pointsEarned = 0;
+        //
+        int values[50];
+        std::vector<int*> expected;
+        List<int>* list = new List<int>();
+        unsigned int seed = 7;
+        bool sameContents = true;
+        for (int step = 0; step < 3000; step++) {
+            seed = seed * 1103515245 + 12345;
+            int choice = (seed >> 16) % 4;
+            int size = (int)expected.size();
+            int position = (int)((seed >> 4) % (size + 1));
+            if (choice < 2 || size == 0) {
+                int* item = &values[step % 50];
+                list->insertAtPosition(position, item);
+                expected.insert(expected.begin() + position, item);
+            }
+            else if (choice == 2) {
+                position = position % size;
+                if (list->removeFromPosition(position) != expected[position]) {
+                    sameContents = false;
+                }
+                expected.erase(expected.begin() + position);
+            }
+            else {
+                int count = (int)((seed >> 8) % 5);
+                List<int>* run = list->eraseRange(position, count);
+                int end = position + count < size ? position + count : size;
+                std::vector<int*> expectedRun(expected.begin() + position, expected.begin() + end);
+                expected.erase(expected.begin() + position, expected.begin() + end);
+                int target = expected.empty() ? 0 : (int)((seed >> 2) % (expected.size() + 1));
+                list->insertRangeAt(target, run);
+                expected.insert(expected.begin() + target, expectedRun.begin(), expectedRun.end());
+                if (!run->isEmpty()) {
+                    sameContents = false;
+                }
+                delete run;
+            }
+        }
+        //
+        pointsPossible++;
+        int k = 0;
+        for (int* item : *list) {
+            if (item != expected[k]) {
+                sameContents = false;
+            }
+            k++;
+        }
+        if (sameContents && k == (int)expected.size() && list->getSize() == k) {
+            pointsEarned++;
+        }
+        else {
+            sout << "positional edits put elements in the wrong positions" << std::endl;
+        }
+        //
+        pointsPossible++;
+        int* last = list->peek(list->getSize() - 1);
+        List<int>::iterator lastNode = list->end();
+        --lastNode;
+        if (list->removeFromPosition(list->getSize()) == nullptr && list->peek(-1) == nullptr
+            && *lastNode == last && *list->rbegin() == expected.back()) {
+            pointsEarned++;
+        }
+        else {
+            sout << "out of range positions were not rejected" << std::endl;
+        }
+        delete list;
+
+        std::cout << "ChainTester::test8 results:" << std::endl;
+        return new TestResults(pointsPossible, pointsEarned, sout.str());
+    }
+
+    /*
+     Test that peek and setData stay correct when every kind of change is
+     made between positional accesses, so that a stale finger would be
+     caught.
+     */
+    static TestResults* test9() {
+        std::ostringstream sout;
+        int pointsPossible = 0;
+        int pointsEarned = 0;
+        //
+        int values[50];
+        std::vector<int*> expected;
+        List<int>* list = new List<int>();
+        unsigned int seed = 11;
+        bool peeksMatch = true;
+        for (int step = 0; step < 4000; step++) {
+            seed = seed * 1103515245 + 12345;
+            int choice = (seed >> 16) % 9;
+            int size = (int)expected.size();
+            int position = (int)((seed >> 4) % (size + 1));
+            int* item = &values[step % 50];
+            if (choice == 0 || size == 0) {
+                list->insertAtStart(item);
+                expected.insert(expected.begin(), item);
+            }
+            else if (choice == 1) {
+                list->insertAtEnd(item);
+                expected.push_back(item);
+            }
+            else if (choice == 2) {
+                list->removeFromStart();
+                expected.erase(expected.begin());
+            }
+            else if (choice == 3) {
+                list->removeFromEnd();
+                expected.pop_back();
+            }
+            else if (choice == 4) {
+                list->insertAtPosition(position, item);
+                expected.insert(expected.begin() + position, item);
+            }
+            else if (choice == 5) {
+                position = position % size;
+                list->removeFromPosition(position);
+                expected.erase(expected.begin() + position);
+            }
+            else if (choice == 6) {
+                position = position % size;
+                list->setData(item, position);
+                expected[position] = item;
+            }
+            else if (choice == 7) {
+                List<int>* tail = list->splitAfter(position % size);
+                List<int>* head = new List<int>(std::move(*list));
+                delete list;
+                list = tail;
+                list->append(head);
+                delete head;
+                int cut = position % size + 1;
+                std::rotate(expected.begin(), expected.begin() + cut, expected.end());
+            }
+            else {
+                List<int>* front = list->eraseRange(0, position);
+                List<int>* back = new List<int>();
+                back->insertAtEnd(item);
+                list->peek(list->getSize() / 2);
+                list->prepend(back);
+                list->prepend(front);
+                delete front;
+                delete back;
+                expected.insert(expected.begin() + position, item);
+            }
+            // touch a few positions around a random one, in both directions
+            size = (int)expected.size();
+            if (size > 0) {
+                int center = (int)((seed >> 8) % size);
+                for (int k = center - 2; k <= center + 2; k++) {
+                    if (k >= 0 && k < size && list->peek(k) != expected[k]) {
+                        peeksMatch = false;
+                    }
+                }
+                for (int k = center + 2; k >= center - 2; k--) {
+                    if (k >= 0 && k < size && list->peek(k) != expected[k]) {
+                        peeksMatch = false;
+                    }
+                }
+            }
+        }
+        //
+        pointsPossible++;
+        if (peeksMatch && list->getSize() == (int)expected.size()) {
+            pointsEarned++;
+        }
+        else {
+            sout << "peek returned the wrong data after a change to the list" << std::endl;
+        }
+        //
+        pointsPossible++;
+        bool sequentialMatch = true;
+        for (int k = 0; k < list->getSize(); k++) {
+            if (list->peek(k) != expected[k]) {
+                sequentialMatch = false;
+            }
+        }
+        for (int k = list->getSize() - 1; k >= 0; k--) {
+            if (list->peek(k) != expected[k]) {
+                sequentialMatch = false;
+            }
+        }
+        if (sequentialMatch) {
+            pointsEarned++;
+        }
+        else {
+            sout << "sequential peeks returned the wrong data" << std::endl;
+        }
+        delete list;
+
+        std::cout << "ChainTester::test9 results:" << std::endl;
+        return new TestResults(pointsPossible, pointsEarned, sout.str());
+    }
+
+    /*
+     Test ConcurrentQueue and SingleProducerQueue: capacity, order and
+     batches on one thread, then several producers and consumers at once,
+     checking that every item comes out exactly once and that each
+     consumer sees each producer's items in the order they were pushed.
+     */
+    static TestResults* test10() {
+        std::ostringstream sout;
+        int pointsPossible = 0;
+        int pointsEarned = 0;
+        //
+        pointsPossible++;
+        int values[100];
+        ConcurrentQueue<int>* queue = new ConcurrentQueue<int>(5);
+        SingleProducerQueue<int>* spsc = new SingleProducerQueue<int>(5);
+        bool singleThreaded = queue->getCapacity() == 8 && spsc->getCapacity() == 8
+            && queue->pop() == nullptr && spsc->pop() == nullptr
+            && !queue->push(nullptr) && !spsc->push(nullptr);
+        for (int round = 0; round < 3; round++) {
+            for (int k = 0; k < 8; k++) {
+                singleThreaded = singleThreaded && queue->push(&values[k]) && spsc->push(&values[k]);
+            }
+            singleThreaded = singleThreaded && !queue->push(&values[8]) && !spsc->push(&values[8])
+                && queue->getSize() == 8 && spsc->getSize() == 8;
+            int* batch[8];
+            singleThreaded = singleThreaded && queue->popBatch(batch, 3) == 3 && batch[2] == &values[2]
+                && spsc->popBatch(batch, 3) == 3 && batch[2] == &values[2];
+            int* more[5] = { &values[8], &values[9], &values[10], &values[11], &values[12] };
+            singleThreaded = singleThreaded && queue->pushBatch(more, 5) == 3
+                && spsc->pushBatch(more, 5) == 3;
+            singleThreaded = singleThreaded && queue->popBatch(batch, 8) == 8 && batch[0] == &values[3]
+                && batch[7] == &values[10] && spsc->popBatch(batch, 8) == 8 && batch[0] == &values[3]
+                && batch[7] == &values[10] && queue->isEmpty() && spsc->isEmpty();
+        }
+        if (singleThreaded) {
+            pointsEarned++;
+        }
+        else {
+            sout << "queues got capacity, order or batches wrong on one thread" << std::endl;
+        }
+        delete queue;
+        delete spsc;
+        //
+        pointsPossible++;
+        const int numProducers = 4;
+        const int itemsPerProducer = 20000;
+        std::vector<int> items(numProducers * itemsPerProducer);
+        std::vector<std::atomic<int>> timesSeen(items.size());
+        for (std::atomic<int>& count : timesSeen) {
+            count.store(0);
+        }
+        std::atomic<int> consumed(0);
+        std::atomic<bool> inOrder(true);
+        queue = new ConcurrentQueue<int>(64);
+        std::vector<std::thread> threads;
+        for (int p = 0; p < numProducers; p++) {
+            threads.emplace_back([&, p]() {
+                int* batch[7];
+                int next = 0;
+                while (next < itemsPerProducer) {
+                    // alternate single and batch pushes
+                    int count = next % 2 == 0 ? 1 : 7;
+                    if (count > itemsPerProducer - next) {
+                        count = itemsPerProducer - next;
+                    }
+                    for (int k = 0; k < count; k++) {
+                        batch[k] = &items[p * itemsPerProducer + next + k];
+                    }
+                    int pushed = count == 1 ? (queue->push(batch[0]) ? 1 : 0) : queue->pushBatch(batch, count);
+                    next += pushed;
+                    if (pushed == 0) {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+        for (int c = 0; c < numProducers; c++) {
+            threads.emplace_back([&]() {
+                int* batch[5];
+                std::vector<long long> lastSeen(numProducers, -1);
+                while (consumed.load() < (int)items.size()) {
+                    int popped = queue->popBatch(batch, 5);
+                    if (popped == 0) {
+                        std::this_thread::yield();
+                    }
+                    for (int k = 0; k < popped; k++) {
+                        long long offset = batch[k] - &items[0];
+                        timesSeen[offset]++;
+                        int producer = (int)(offset / itemsPerProducer);
+                        if (offset <= lastSeen[producer]) {
+                            inOrder = false;
+                        }
+                        lastSeen[producer] = offset;
+                    }
+                    consumed += popped;
+                }
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        bool exactlyOnce = true;
+        for (std::atomic<int>& count : timesSeen) {
+            if (count.load() != 1) {
+                exactlyOnce = false;
+            }
+        }
+        if (exactlyOnce && inOrder && queue->isEmpty()) {
+            pointsEarned++;
+        }
+        else {
+            sout << "ConcurrentQueue lost, duplicated or reordered items across threads" << std::endl;
+        }
+        delete queue;
+        //
+        pointsPossible++;
+        spsc = new SingleProducerQueue<int>(64);
+        bool spscInOrder = true;
+        std::thread producer([&]() {
+            int next = 0;
+            while (next < (int)items.size()) {
+                int* batch[3] = { &items[next], &items[(next + 1) % items.size()], &items[(next + 2) % items.size()] };
+                int count = (int)items.size() - next < 3 ? (int)items.size() - next : 3;
+                int pushed = spsc->pushBatch(batch, count);
+                next += pushed;
+                if (pushed == 0) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+        int expectedNext = 0;
+        while (expectedNext < (int)items.size()) {
+            int* item = spsc->pop();
+            if (item == nullptr) {
+                std::this_thread::yield();
+            }
+            else {
+                if (item != &items[expectedNext]) {
+                    spscInOrder = false;
+                }
+                expectedNext++;
+            }
+        }
+        producer.join();
+        if (spscInOrder && spsc->isEmpty()) {
+            pointsEarned++;
+        }
+        else {
+            sout << "SingleProducerQueue lost or reordered items across threads" << std::endl;
+        }
+        delete spsc;
+
+        std::cout << "ChainTester::test10 results:" << std::endl;
+        return new TestResults(pointsPossible, pointsEarned, sout.str());
+    }
+
+    static TestResults* test11() {
+        std::ostringstream sout;
+        int pointsPossible = 0;
+        int pointsEarned = 0;
+        int values[40];
+        //
+        pointsPossible++;
+        List<int>* list = new List<int>();
+        for (int k = 0; k < 40; k++) {
+            list->insertAtEnd(&values[k]);
+        }
+        MemoryReport report;
+        list->reportMemory(&report, "list");
+        size_t unindexedBytes = report.getTotalBytes();
+        list->setIndexed(true);
+        list->contains(&values[0]);
+        MemoryReport indexedReport;
+        list->reportMemory(&indexedReport, "list");
+        if (report.getNumEntries() == 2 && report.getCount("list.nodes") == 40
+            && report.getBytes("list.nodes") == 40 * sizeof(Node<int>) && report.getBytes("list.object") == sizeof(Chain<int>)
+            && unindexedBytes == sizeof(Chain<int>) + 40 * sizeof(Node<int>)
+            && indexedReport.getCount("list.index.slots") >= 80
+            && indexedReport.getBytes("list.index") > 40 * sizeof(int*)
+            && indexedReport.getBytes("list") == indexedReport.getTotalBytes()
+            && indexedReport.getTotalBytes() == unindexedBytes + indexedReport.getBytes("list.index")) {
+            pointsEarned++;
+        }
+        else {
+            sout << "a list reported its memory wrong:" << std::endl << indexedReport.toString();
+        }
+        delete list;
+        //
+        pointsPossible++;
+        NodePool<int>* pool = new NodePool<int>(16);
+        List<int>* pooled = new List<int>(pool);
+        ArrayList<int>* array = new ArrayList<int>();
+        UnrolledList<int, 4>* unrolled = new UnrolledList<int, 4>();
+        for (int k = 0; k < 10; k++) {
+            pooled->insertAtEnd(&values[k]);
+            array->insertAtEnd(&values[k]);
+            unrolled->insertAtEnd(&values[k]);
+        }
+        report.clear();
+        pooled->reportMemory(&report, "pooled");
+        pool->reportMemory(&report, "pool");
+        array->reportMemory(&report, "array");
+        unrolled->reportMemory(&report, "unrolled");
+        size_t poolNodes = report.getBytes("pooled.nodes") + report.getBytes("pool.spare_nodes");
+        if (poolNodes == 16 * sizeof(Node<int>) && report.getCount("pool.spare_nodes") == 6
+            && report.getCount("array.items") == 10 && report.getBytes("array.items") >= 10 * sizeof(int*)
+            && report.getCount("unrolled.blocks") >= 3 && report.getBytes("unrolled.blocks") > 10 * sizeof(int*)) {
+            pointsEarned++;
+        }
+        else {
+            sout << "a pooled, array or unrolled list reported its memory wrong:" << std::endl << report.toString();
+        }
+        delete pooled;
+        delete pool;
+        delete array;
+        delete unrolled;
+        //
+        pointsPossible++;
+        report.clear();
+        report.add("a.b", 2, 10);
+        report.add("a.c\"", 1, 5);
+        report.add("a.b", 1, 3);
+        report.add("ab", 1, 100);
+        std::string keyValue = report.toKeyValue();
+        std::string json = report.toJson();
+        if (report.getNumEntries() == 3 && report.getCount("a.b") == 3 && report.getBytes("a") == 18
+            && report.getTotalBytes() == 118
+            && keyValue == "a.b.count=3\na.b.bytes=13\na.c\".count=1\na.c\".bytes=5\nab.count=1\nab.bytes=100\ntotal.bytes=118\n"
+            && json == "{\"entries\":[{\"name\":\"a.b\",\"count\":3,\"bytes\":13},"
+                "{\"name\":\"a.c\\\"\",\"count\":1,\"bytes\":5},"
+                "{\"name\":\"ab\",\"count\":1,\"bytes\":100}],\"total_bytes\":118}") {
+            pointsEarned++;
+        }
+        else {
+            sout << "a memory report was dumped wrong:" << std::endl << keyValue << json << std::endl;
+        }
+
+        std::cout << "ChainTester::test11 results:" << std::endl;
+        return new TestResults(pointsPossible, pointsEarned, sout.str());
+    }
+
+    static TestResults* runAllTests() {
+        int totalPossible = 0;
+        int totalEarned = 0;
+
+        TestResults* r;
+
+        r = test0();
+        totalPossible += r->pointsPossible;
+        totalEarned += r->pointsEarned;
+        std::cout << r->toString() << std::endl;
+
+        r = test1();
+        totalPossible += r->pointsPossible;
+        totalEarned += r->pointsEarned;
+        std::cout << r->toString() << std::endl;
+
+        r = test2();
+        totalPossible += r->pointsPossible;
+        totalEarned += r->pointsEarned;
+        std::cout << r->toString() << std::endl;
+
+        r = test3();
+        totalPossible += r->pointsPossible;
+        totalEarned += r->pointsEarned;
+        std::cout << r->toString() << std::endl;
+
+        r = test4();
+        totalPossible += r->pointsPossible;
+        totalEarned += r->pointsEarned;
+        std::cout << r->toString() << std::endl;
+
+        r = test5();
+        totalPossible += r->pointsPossible;
+        totalEarned += r->pointsEarned;
+        std::cout << r->toString() << std::endl;
+
+        r = test6();
+        totalPossible += r->pointsPossible;
+        totalEarned += r->pointsEarned;
+        std::cout << r->toString() << std::endl;
+
+        r = test7();
+        totalPossible += r->pointsPossible;
+        totalEarned += r->pointsEarned;
+        std::cout << r->toString() << std::endl;
+
+        r = test8();
+        totalPossible += r->pointsPossible;
+        totalEarned += r->pointsEarned;
+        std::cout << r->toString() << std::endl;
+
+        r = test9();
+        totalPossible += r->pointsPossible;
+        totalEarned += r->pointsEarned;
+        std::cout << r->toString() << std::endl;
+
+        r = test10();
+        totalPossible += r->pointsPossible;
+        totalEarned += r->pointsEarned;
+        std::cout << r->toString() << std::endl;
+        r = test11();
+        totalPossible += r->pointsPossible;
+        totalEarned += r->pointsEarned;
+        std::cout << r->toString() << std::endl;
+
+        return new TestResults(totalPossible, totalEarned, "");
+    }
+
+};
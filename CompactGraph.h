@@ -0,0 +1,512 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <typeinfo>
+#include <vector>
+#include "Vertex.h"
+#include "Edge.h"
+#include "Graph.h"
+#include "MemoryReport.h"
+
+/*
+An edge of a CompactGraph: its endpoints as 32-bit vertex ids, the ids of
+the next edges in its "from" vertex's out-list and its "to" vertex's
+in-list, and a weight of type Weight. With the default float weight an
+edge takes 20 bytes; with Weight = void it has no weight field, takes 16
+bytes, and every edge weighs 1.
+*/
+template <typename Weight>
+struct CompactEdge {
+	uint32_t from;
+	uint32_t to;
+	uint32_t nextOut;
+	uint32_t nextIn;
+	Weight weight;
+
+	double getWeight() const {
+		return (double)this->weight;
+	}
+
+	bool setWeight(double newWeight) {
+		this->weight = (Weight)newWeight;
+		return true;
+	}
+};
+
+template <>
+struct CompactEdge<void> {
+	uint32_t from;
+	uint32_t to;
+	uint32_t nextOut;
+	uint32_t nextIn;
+
+	double getWeight() const {
+		return 1;
+	}
+
+	bool setWeight(double) {
+		return false;
+	}
+};
+
+/*
+A directed graph for very large edge counts. Where a Graph allocates a
+Vertex per vertex and an Edge per edge, reached through pointers, hash
+indexes and list nodes, a CompactGraph keeps everything in a few flat
+arrays indexed by dense 32-bit ids:
+
+- vertex v has its data pointer, the ids of its first out-edge and first
+  in-edge, and its out- and in-degrees at index v of five arrays;
+- edge e is a CompactEdge at index e of the edge array, and the out-edges
+  (in-edges) of a vertex are linked through nextOut (nextIn), newest first.
+
+So a vertex costs 24 bytes and an edge sizeof(CompactEdge<Weight>) bytes,
+plus a data pointer per edge once any edge stores data, with no
+allocation per vertex or edge. Edge lookup walks the out-list of the
+"from" vertex, so hasEdge, findEdge and addEdge (which refuses duplicate
+edges) take time proportional to its out-degree.
+
+Removal moves the last edge or vertex into the removed one's id, as Graph
+does, so ids stay dense and only the moved item's id changes.
+
+A CompactGraph stores pointers to vertex and edge data but never owns or
+deletes them.
+*/
+template <typename T, typename U, typename Weight = float>
+class CompactGraph {
+
+public:
+
+	/*
+	The id that marks the end of an out- or in-list, returned by
+	getFirstOutEdge and its kin when there are no more edges.
+	*/
+	static constexpr uint32_t NoEdge = 0xFFFFFFFF;
+
+protected:
+
+	std::vector<T*> vertexData;
+
+	std::vector<uint32_t> firstOut;
+
+	std::vector<uint32_t> firstIn;
+
+	std::vector<uint32_t> outDegrees;
+
+	std::vector<uint32_t> inDegrees;
+
+	std::vector<CompactEdge<Weight>> edges;
+
+	/*
+	The data stored in each edge, by edge id. Empty until some edge is given
+	data, so graphs whose edges hold no data don't pay for it.
+	*/
+	std::vector<U*> edgeData;
+
+	bool isVertexId(int id) {
+		return id >= 0 && id < (int)this->vertexData.size();
+	}
+
+	bool isEdgeId(int id) {
+		return id >= 0 && id < (int)this->edges.size();
+	}
+
+	/*
+	Unlinks the specified edge from the out-list of its "from" vertex and
+	the in-list of its "to" vertex.
+	*/
+	void unlinkEdge(uint32_t edge) {
+		uint32_t* link = &this->firstOut[this->edges[edge].from];
+		while (*link != edge) {
+			link = &this->edges[*link].nextOut;
+		}
+		*link = this->edges[edge].nextOut;
+		link = &this->firstIn[this->edges[edge].to];
+		while (*link != edge) {
+			link = &this->edges[*link].nextIn;
+		}
+		*link = this->edges[edge].nextIn;
+	}
+
+	/*
+	Makes the links that lead to edge oldId in its vertices' lists lead to
+	edge newId instead. Used when an edge is moved to a new id.
+	*/
+	void relinkEdge(uint32_t oldId, uint32_t newId) {
+		uint32_t* link = &this->firstOut[this->edges[oldId].from];
+		while (*link != oldId) {
+			link = &this->edges[*link].nextOut;
+		}
+		*link = newId;
+		link = &this->firstIn[this->edges[oldId].to];
+		while (*link != oldId) {
+			link = &this->edges[*link].nextIn;
+		}
+		*link = newId;
+	}
+
+public:
+
+	/*
+	Creates an empty graph.
+	*/
+	CompactGraph() {
+	}
+
+	/*
+	Creates a compact copy of the specified graph. Vertex ids follow the
+	order of the graph's vertex list, as Graph::getVertexId does, and edge
+	ids the order of its edge list. Weights are converted to Weight. The
+	copy holds the graph's vertex and edge data pointers but owns none of
+	them. Runs in time proportional to the size of the graph.
+	*/
+	template <template <typename> class Container>
+	CompactGraph(Graph<T, U, Container>* graph) {
+		this->reserve(graph->getNumVertices(), graph->getNumEdges());
+		for (Vertex<T>* vertex : *graph->getVertices()) {
+			this->addVertex(vertex->getData());
+		}
+		for (Edge<T, U>* edge : *graph->getEdges()) {
+			// the graph has no duplicate edges, so skip addEdge's search
+			int id = this->appendEdge(graph->getVertexId(edge->getInitialVertex()),
+				graph->getVertexId(edge->getTerminalVertex()), edge->getEdgeWeight());
+			if (edge->getData() != nullptr) {
+				this->setEdgeData(id, edge->getData());
+			}
+		}
+	}
+
+	/*
+	Makes room for the specified numbers of vertices and edges.
+	*/
+	void reserve(int numVertices, int numEdges) {
+		this->vertexData.reserve(numVertices);
+		this->firstOut.reserve(numVertices);
+		this->firstIn.reserve(numVertices);
+		this->outDegrees.reserve(numVertices);
+		this->inDegrees.reserve(numVertices);
+		this->edges.reserve(numEdges);
+	}
+
+	int getNumVertices() {
+		return (int)this->vertexData.size();
+	}
+
+	int getNumEdges() {
+		return (int)this->edges.size();
+	}
+
+	/*
+	Adds a vertex storing the specified data and returns its id, which is
+	the number of vertices before the call.
+	*/
+	int addVertex(T* data = nullptr) {
+		this->vertexData.push_back(data);
+		this->firstOut.push_back(NoEdge);
+		this->firstIn.push_back(NoEdge);
+		this->outDegrees.push_back(0);
+		this->inDegrees.push_back(0);
+		return (int)this->vertexData.size() - 1;
+	}
+
+	/*
+	Adds an edge with the specified weight from the vertex with id from to
+	the vertex with id to, and returns its id, which is the number of edges
+	before the call. Returns a negative number, and does nothing, if either
+	id is out of range or the edge already exists.
+	*/
+	int addEdge(int from, int to, double weight = 1) {
+		if (!this->isVertexId(from) || !this->isVertexId(to) || this->findEdge(from, to) >= 0) {
+			return -1;
+		}
+		return this->appendEdge(from, to, weight);
+	}
+
+	/*
+	Adds an edge as addEdge does, but without checking the ids or looking
+	for an existing edge, for callers that already know the edge is new,
+	such as bulk loaders.
+	*/
+	int appendEdge(int from, int to, double weight = 1) {
+		CompactEdge<Weight> edge;
+		edge.from = (uint32_t)from;
+		edge.to = (uint32_t)to;
+		edge.nextOut = this->firstOut[from];
+		edge.nextIn = this->firstIn[to];
+		edge.setWeight(weight);
+		uint32_t id = (uint32_t)this->edges.size();
+		this->edges.push_back(edge);
+		if (!this->edgeData.empty()) {
+			this->edgeData.push_back(nullptr);
+		}
+		this->firstOut[from] = id;
+		this->firstIn[to] = id;
+		this->outDegrees[from]++;
+		this->inDegrees[to]++;
+		return (int)id;
+	}
+
+	/*
+	Returns the id of the edge from the vertex with id from to the vertex
+	with id to, or a negative number if there is no such edge.
+	*/
+	int findEdge(int from, int to) {
+		if (!this->isVertexId(from) || !this->isVertexId(to)) {
+			return -1;
+		}
+		for (uint32_t edge = this->firstOut[from]; edge != NoEdge; edge = this->edges[edge].nextOut) {
+			if (this->edges[edge].to == (uint32_t)to) {
+				return (int)edge;
+			}
+		}
+		return -1;
+	}
+
+	bool hasEdge(int from, int to) {
+		return this->findEdge(from, to) >= 0;
+	}
+
+	/*
+	Removes the edge with the specified id and returns true, or returns
+	false if there is no such edge. The last edge takes the removed edge's
+	id. Takes time proportional to the degrees of the vertices involved.
+	*/
+	bool removeEdge(int id) {
+		if (!this->isEdgeId(id)) {
+			return false;
+		}
+		uint32_t edge = (uint32_t)id;
+		this->unlinkEdge(edge);
+		this->outDegrees[this->edges[edge].from]--;
+		this->inDegrees[this->edges[edge].to]--;
+		uint32_t last = (uint32_t)this->edges.size() - 1;
+		if (edge != last) {
+			this->relinkEdge(last, edge);
+			this->edges[edge] = this->edges[last];
+			if (!this->edgeData.empty()) {
+				this->edgeData[edge] = this->edgeData[last];
+			}
+		}
+		this->edges.pop_back();
+		if (!this->edgeData.empty()) {
+			this->edgeData.pop_back();
+		}
+		return true;
+	}
+
+	/*
+	Removes the edge from the vertex with id from to the vertex with id to
+	and returns true, or returns false if there is no such edge.
+	*/
+	bool removeEdge(int from, int to) {
+		return this->removeEdge(this->findEdge(from, to));
+	}
+
+	/*
+	Removes the vertex with the specified id and every edge into or out of
+	it, and returns true, or returns false if there is no such vertex. The
+	last vertex takes the removed vertex's id.
+	*/
+	bool removeVertex(int id) {
+		if (!this->isVertexId(id)) {
+			return false;
+		}
+		while (this->firstOut[id] != NoEdge) {
+			this->removeEdge((int)this->firstOut[id]);
+		}
+		while (this->firstIn[id] != NoEdge) {
+			this->removeEdge((int)this->firstIn[id]);
+		}
+		uint32_t vertex = (uint32_t)id;
+		uint32_t last = (uint32_t)this->vertexData.size() - 1;
+		if (vertex != last) {
+			this->vertexData[vertex] = this->vertexData[last];
+			this->firstOut[vertex] = this->firstOut[last];
+			this->firstIn[vertex] = this->firstIn[last];
+			this->outDegrees[vertex] = this->outDegrees[last];
+			this->inDegrees[vertex] = this->inDegrees[last];
+			for (uint32_t edge = this->firstOut[vertex]; edge != NoEdge; edge = this->edges[edge].nextOut) {
+				this->edges[edge].from = vertex;
+			}
+			for (uint32_t edge = this->firstIn[vertex]; edge != NoEdge; edge = this->edges[edge].nextIn) {
+				this->edges[edge].to = vertex;
+			}
+		}
+		this->vertexData.pop_back();
+		this->firstOut.pop_back();
+		this->firstIn.pop_back();
+		this->outDegrees.pop_back();
+		this->inDegrees.pop_back();
+		return true;
+	}
+
+	/*
+	Returns the out-degree of the vertex with the specified id, or a
+	negative number if there is no such vertex.
+	*/
+	int getOutDegree(int id) {
+		return this->isVertexId(id) ? (int)this->outDegrees[id] : -1;
+	}
+
+	/*
+	Returns the in-degree of the vertex with the specified id, or a negative
+	number if there is no such vertex.
+	*/
+	int getInDegree(int id) {
+		return this->isVertexId(id) ? (int)this->inDegrees[id] : -1;
+	}
+
+	/*
+	Walk the out-edges of a vertex with
+		for (uint32_t e = g->getFirstOutEdge(v); e != g->NoEdge; e = g->getNextOutEdge(e))
+	and its in-edges likewise. Edges come newest first. The vertex and edge
+	ids must be valid.
+	*/
+	uint32_t getFirstOutEdge(int id) {
+		return this->firstOut[id];
+	}
+
+	uint32_t getNextOutEdge(uint32_t edge) {
+		return this->edges[edge].nextOut;
+	}
+
+	uint32_t getFirstInEdge(int id) {
+		return this->firstIn[id];
+	}
+
+	uint32_t getNextInEdge(uint32_t edge) {
+		return this->edges[edge].nextIn;
+	}
+
+	/*
+	Returns the id of the "from" vertex of the edge with the specified id,
+	or a negative number if there is no such edge.
+	*/
+	int getEdgeFrom(int id) {
+		return this->isEdgeId(id) ? (int)this->edges[id].from : -1;
+	}
+
+	/*
+	Returns the id of the "to" vertex of the edge with the specified id, or
+	a negative number if there is no such edge.
+	*/
+	int getEdgeTo(int id) {
+		return this->isEdgeId(id) ? (int)this->edges[id].to : -1;
+	}
+
+	/*
+	Returns the weight of the edge with the specified id, or NaN if there is
+	no such edge.
+	*/
+	double getEdgeWeight(int id) {
+		if (!this->isEdgeId(id)) {
+			return std::nan("");
+		}
+		return this->edges[id].getWeight();
+	}
+
+	/*
+	Sets the weight of the edge with the specified id and returns 0. Returns
+	a negative number if there is no such edge or edges have no weights.
+	*/
+	int setEdgeWeight(double weight, int id) {
+		if (!this->isEdgeId(id) || !this->edges[id].setWeight(weight)) {
+			return -1;
+		}
+		return 0;
+	}
+
+	/*
+	Returns the data stored in the edge with the specified id, or the null
+	pointer if it has none or there is no such edge.
+	*/
+	U* getEdgeData(int id) {
+		if (!this->isEdgeId(id) || this->edgeData.empty()) {
+			return nullptr;
+		}
+		return this->edgeData[id];
+	}
+
+	/*
+	Stores the specified data in the edge with the specified id and returns
+	0, or returns a negative number if there is no such edge.
+	*/
+	int setEdgeData(int id, U* data) {
+		if (!this->isEdgeId(id)) {
+			return -1;
+		}
+		if (this->edgeData.empty()) {
+			if (data == nullptr) {
+				return 0;
+			}
+			this->edgeData.assign(this->edges.size(), nullptr);
+		}
+		this->edgeData[id] = data;
+		return 0;
+	}
+
+	/*
+	Returns the data stored in the vertex with the specified id, or the null
+	pointer if it has none or there is no such vertex.
+	*/
+	T* getVertexData(int id) {
+		return this->isVertexId(id) ? this->vertexData[id] : nullptr;
+	}
+
+	/*
+	Stores the specified data in the vertex with the specified id and
+	returns 0, or returns a negative number if there is no such vertex.
+	*/
+	int setVertexData(int id, T* data) {
+		if (!this->isVertexId(id)) {
+			return -1;
+		}
+		this->vertexData[id] = data;
+		return 0;
+	}
+
+	/*
+	Returns the number of bytes of heap memory this graph holds, counting
+	the capacity of its arrays.
+	*/
+	size_t getMemoryBytes() {
+		return this->vertexData.capacity() * sizeof(T*)
+			+ (this->firstOut.capacity() + this->firstIn.capacity()
+				+ this->outDegrees.capacity() + this->inDegrees.capacity()) * sizeof(uint32_t)
+			+ this->edges.capacity() * sizeof(CompactEdge<Weight>)
+			+ this->edgeData.capacity() * sizeof(U*);
+	}
+
+	/*
+	Adds the memory held by this graph to the specified report, under the
+	specified name: the graph object, the per-vertex arrays, the edges and
+	the edge data pointers, if any edge has data. The entries add up to
+	getMemoryBytes plus the size of the object.
+	*/
+	void reportMemory(MemoryReport* report, const std::string& name) {
+		report->add(name + ".object", 1, sizeof(*this));
+		report->add(name + ".vertex_arrays", this->getNumVertices(), this->getMemoryBytes()
+			- this->edges.capacity() * sizeof(CompactEdge<Weight>) - this->edgeData.capacity() * sizeof(U*));
+		report->add(name + ".edges", this->getNumEdges(), this->edges.capacity() * sizeof(CompactEdge<Weight>));
+		report->add(name + ".edge_data", (long long)this->edgeData.size(), this->edgeData.capacity() * sizeof(U*));
+	}
+
+	/*
+	Returns a string representation of this graph.
+	*/
+	std::string toString() {
+		std::ostringstream sout;
+		sout << "CompactGraph at: " << this << std::endl;
+		sout << "Number of total vertices: " << this->getNumVertices() << std::endl;
+		sout << "Number of total edges: " << this->getNumEdges() << std::endl;
+		sout << "Edges of " << sizeof(CompactEdge<Weight>) << " bytes, " << this->getMemoryBytes()
+			<< " bytes in all" << std::endl;
+		sout << "Storing data of type " << typeid(T).name() << " in vertices" << std::endl;
+		sout << "Storing data of type " << typeid(U).name() << " in edges" << std::endl;
+		return sout.str();
+	}
+
+};
@@ -0,0 +1,235 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <sstream>
+#include <string>
+
+/*
+ A templated class representing bounded queues that any number of threads
+ can push to and pop from at the same time without locks. A
+ ConcurrentQueue<T> manages pointers to objects of type T, like the chain
+ family, but never owns them; the null pointer can't be pushed, since pop
+ returns it to mean the queue was empty.
+
+ The queue is a ring of slots, each with a sequence number telling whether
+ it is ready to be written or to be read on the current lap. A producer
+ claims a position by advancing the enqueue position with compare-and-swap,
+ writes its slot, and then publishes it by bumping the slot's sequence; a
+ consumer does the same on the dequeue side. Batch operations claim a run
+ of consecutive slots with one compare-and-swap.
+
+ No operation ever waits: push and pop return at once when the queue is
+ full or empty. But the queue is not lock-free in the strict sense, since
+ a slot between being claimed and being published blocks its side of the
+ ring. If a producer stalls after its compare-and-swap and before it bumps
+ the sequence, consumers see the queue as empty at that slot, even when
+ later slots are full, until the producer resumes; a stalled consumer
+ likewise makes the queue look full to producers once they come round to
+ its slot.
+
+ For one producer and one consumer, SingleProducerQueue is faster.
+ */
+template <typename T>
+class ConcurrentQueue {
+
+protected:
+
+    struct Slot {
+        std::atomic<size_t> sequence;
+        T* data;
+    };
+
+    /*
+     Keeps the positions, which are written by different threads, on
+     different cache lines.
+     */
+    static const int CacheLineSize = 64;
+
+    Slot* slots;
+
+    /*
+     The number of slots minus one. The number of slots is a power of two,
+     so a position maps to its slot with a mask.
+     */
+    size_t mask;
+
+    char padding0[CacheLineSize];
+
+    std::atomic<size_t> enqueuePosition;
+
+    char padding1[CacheLineSize - sizeof(std::atomic<size_t>)];
+
+    std::atomic<size_t> dequeuePosition;
+
+    char padding2[CacheLineSize - sizeof(std::atomic<size_t>)];
+
+public:
+
+    /*
+     Creates an empty queue with room for at least the specified number of
+     pointers. The capacity is rounded up to a power of two, and is at
+     least 2.
+     */
+    ConcurrentQueue(int capacity) {
+        size_t numSlots = 2;
+        while (numSlots < (size_t)capacity) {
+            numSlots *= 2;
+        }
+        this->slots = new Slot[numSlots];
+        this->mask = numSlots - 1;
+        for (size_t k = 0; k < numSlots; k++) {
+            this->slots[k].sequence.store(k, std::memory_order_relaxed);
+            this->slots[k].data = nullptr;
+        }
+        this->enqueuePosition.store(0, std::memory_order_relaxed);
+        this->dequeuePosition.store(0, std::memory_order_relaxed);
+    }
+
+    ConcurrentQueue(const ConcurrentQueue<T>& other) = delete;
+
+    ConcurrentQueue<T>& operator=(const ConcurrentQueue<T>& other) = delete;
+
+    /*
+     Destroys this queue. Pointers still in the queue are dropped, not
+     deleted. No other thread may be using the queue.
+     */
+    ~ConcurrentQueue() {
+        delete[] this->slots;
+    }
+
+    /*
+     Returns the number of pointers this queue can hold.
+     */
+    int getCapacity() {
+        return (int)(this->mask + 1);
+    }
+
+    /*
+     Returns the number of pointers in this queue. While other threads are
+     pushing or popping this is only an estimate.
+     */
+    int getSize() {
+        size_t dequeued = this->dequeuePosition.load(std::memory_order_acquire);
+        size_t enqueued = this->enqueuePosition.load(std::memory_order_acquire);
+        return enqueued > dequeued ? (int)(enqueued - dequeued) : 0;
+    }
+
+    /*
+     Returns true if this queue looked empty when checked.
+     */
+    bool isEmpty() {
+        return this->getSize() == 0;
+    }
+
+    /*
+     Adds the specified data at the back of this queue. Returns false, and
+     leaves the queue unaltered, if the queue is full or the data is the
+     null pointer.
+     */
+    bool push(T* data) {
+        return data != nullptr && this->pushBatch(&data, 1) == 1;
+    }
+
+    /*
+     Removes and returns the data at the front of this queue, or returns the
+     null pointer if the queue is empty.
+     */
+    T* pop() {
+        T* result = nullptr;
+        this->popBatch(&result, 1);
+        return result;
+    }
+
+    /*
+     Adds as many of the specified pointers as fit, in order, at the back of
+     this queue, and returns how many were added. The pointers added go into
+     consecutive positions, so a batch is never interleaved with another
+     producer's items. None of the pointers may be null.
+     */
+    int pushBatch(T** items, int count) {
+        size_t position = this->enqueuePosition.load(std::memory_order_relaxed);
+        while (count > 0) {
+            // count the slots from position on that are free on this lap
+            int numFree = 0;
+            bool behind = false;
+            while (numFree < count) {
+                Slot& slot = this->slots[(position + numFree) & this->mask];
+                size_t sequence = slot.sequence.load(std::memory_order_acquire);
+                if (sequence != position + numFree) {
+                    // a larger sequence means another producer got there first
+                    behind = (long long)(sequence - (position + numFree)) > 0;
+                    break;
+                }
+                numFree++;
+            }
+            if (numFree == 0 && !behind) {
+                return 0;
+            }
+            if (numFree == 0) {
+                position = this->enqueuePosition.load(std::memory_order_relaxed);
+            }
+            else if (this->enqueuePosition.compare_exchange_weak(position, position + numFree,
+                std::memory_order_relaxed)) {
+                for (int k = 0; k < numFree; k++) {
+                    Slot& slot = this->slots[(position + k) & this->mask];
+                    slot.data = items[k];
+                    slot.sequence.store(position + k + 1, std::memory_order_release);
+                }
+                return numFree;
+            }
+        }
+        return 0;
+    }
+
+    /*
+     Removes up to the specified number of pointers from the front of this
+     queue into the specified array, in order, and returns how many were
+     removed.
+     */
+    int popBatch(T** items, int maxCount) {
+        size_t position = this->dequeuePosition.load(std::memory_order_relaxed);
+        while (maxCount > 0) {
+            // count the slots from position on that hold data on this lap
+            int numReady = 0;
+            bool behind = false;
+            while (numReady < maxCount) {
+                Slot& slot = this->slots[(position + numReady) & this->mask];
+                size_t sequence = slot.sequence.load(std::memory_order_acquire);
+                if (sequence != position + numReady + 1) {
+                    // a larger sequence means another consumer got there first
+                    behind = (long long)(sequence - (position + numReady + 1)) > 0;
+                    break;
+                }
+                numReady++;
+            }
+            if (numReady == 0 && !behind) {
+                return 0;
+            }
+            if (numReady == 0) {
+                position = this->dequeuePosition.load(std::memory_order_relaxed);
+            }
+            else if (this->dequeuePosition.compare_exchange_weak(position, position + numReady,
+                std::memory_order_relaxed)) {
+                for (int k = 0; k < numReady; k++) {
+                    Slot& slot = this->slots[(position + k) & this->mask];
+                    items[k] = slot.data;
+                    slot.sequence.store(position + k + this->mask + 1, std::memory_order_release);
+                }
+                return numReady;
+            }
+        }
+        return 0;
+    }
+
+    /*
+     Returns a string representation of this queue.
+     */
+    std::string toString() {
+        std::ostringstream sout;
+        sout << "ConcurrentQueue at " << this << std::endl;
+        sout << this->getSize() << " of " << this->getCapacity() << " slots in use" << std::endl;
+        return sout.str();
+    }
+
+};
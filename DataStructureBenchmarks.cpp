@@ -0,0 +1 @@
+#include "DataStructureBenchmarks.h"
@@ -0,0 +1,678 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "ConcurrentQueue.h"
+#include "HashMap.h"
+#include "List.h"
+#include "MemoryUsage.h"
+#include "NodePool.h"
+#include "OrderedMap.h"
+#include "SingleProducerQueue.h"
+#include "StringArena.h"
+#include "UnrolledList.h"
+
+/*
+ Timing runs for the homemade data structures. Each benchmark returns a
+ human-readable report; none of them assert anything.
+ */
+class DataStructureBenchmarks {
+
+protected:
+
+    typedef std::chrono::steady_clock Clock;
+
+    /*
+     Returns the number of milliseconds elapsed since the specified time.
+     */
+    static double millisecondsSince(Clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    /*
+     Fills the specified list with the specified number of nodes and then
+     empties it again, the specified number of times. Returns the elapsed
+     time in milliseconds, and sets peakBytes to the resident set size of
+     this process when the list was full for the last time.
+     */
+    static double fillAndDrain(List<int>* list, int size, int rounds, long long& peakBytes) {
+        int value = 1;
+        Clock::time_point start = Clock::now();
+        for (int round = 0; round < rounds; round++) {
+            for (int k = 0; k < size; k++) {
+                list->insertAtEnd(&value);
+            }
+            if (round == rounds - 1) {
+                peakBytes = MemoryUsage::residentBytes();
+            }
+            while (!list->isEmpty()) {
+                list->removeFromStart();
+            }
+        }
+        return millisecondsSince(start);
+    }
+
+    /*
+     Runs the specified numbers of producer and consumer threads over a
+     queue, reached through the specified push and pop functions, until each
+     producer has pushed the specified number of items. push(items, count)
+     and pop(items, maxCount) return how many items they moved; batchSize is
+     the count passed to them. Returns the elapsed time in milliseconds, or
+     a negative number if the consumers did not get back every item.
+     */
+    template <typename Push, typename Pop>
+    static double runPipeline(int numProducers, int numConsumers, int itemsPerProducer,
+        int batchSize, Push push, Pop pop) {
+        int value = 1;
+        long long total = (long long)numProducers * itemsPerProducer;
+        std::atomic<long long> consumed(0);
+        std::atomic<long long> sum(0);
+        std::vector<std::thread> threads;
+
+        Clock::time_point start = Clock::now();
+        for (int k = 0; k < numProducers; k++) {
+            threads.emplace_back([&]() {
+                std::vector<int*> batch(batchSize, &value);
+                int remaining = itemsPerProducer;
+                while (remaining > 0) {
+                    int count = remaining < batchSize ? remaining : batchSize;
+                    int pushed = push(batch.data(), count);
+                    remaining -= pushed;
+                    if (pushed == 0) {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+        for (int k = 0; k < numConsumers; k++) {
+            threads.emplace_back([&]() {
+                std::vector<int*> batch(batchSize);
+                long long localSum = 0;
+                while (consumed.load(std::memory_order_relaxed) < total) {
+                    int popped = pop(batch.data(), batchSize);
+                    if (popped == 0) {
+                        std::this_thread::yield();
+                    }
+                    for (int j = 0; j < popped; j++) {
+                        localSum += *batch[j];
+                    }
+                    consumed.fetch_add(popped, std::memory_order_relaxed);
+                }
+                sum.fetch_add(localSum);
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        double elapsed = millisecondsSince(start);
+        return sum.load() == total ? elapsed : -1.0;
+    }
+
+public:
+
+    /*
+     Scans lists of increasing size with peek(k) in order, with peek(k) in a
+     scattered order, and with iterators. Each scan visits every position
+     once. Thanks to the finger kept by Chain, doubling the size should
+     roughly double the in-order and iterator times. The scattered order
+     jumps thousands of positions between peeks, so the finger doesn't
+     help, each peek walks from the nearest end or the finger, and doubling
+     the size should roughly quadruple the time.
+     */
+    static std::string benchmarkIteration() {
+        std::ostringstream sout;
+        sout << "DataStructureBenchmarks::benchmarkIteration" << std::endl;
+        int value = 1;
+
+        for (int size = 5000; size <= 40000; size *= 2) {
+            List<int>* list = new List<int>();
+            for (int k = 0; k < size; k++) {
+                list->insertAtEnd(&value);
+            }
+
+            long long peekSum = 0;
+            Clock::time_point start = Clock::now();
+            for (int k = 0; k < list->getSize(); k++) {
+                peekSum += *list->peek(k);
+            }
+            double peekTime = millisecondsSince(start);
+
+            // 7919 is prime and doesn't divide any size, so this visits every position
+            long long scatteredSum = 0;
+            start = Clock::now();
+            for (int k = 0; k < list->getSize(); k++) {
+                scatteredSum += *list->peek((int)((long long)k * 7919 % size));
+            }
+            double scatteredTime = millisecondsSince(start);
+
+            long long iteratorSum = 0;
+            start = Clock::now();
+            for (int* item : *list) {
+                iteratorSum += *item;
+            }
+            double iteratorTime = millisecondsSince(start);
+
+            delete list;
+
+            sout << "size " << size << ": peek(k) in order " << peekTime << " ms, scattered " << scatteredTime
+                << " ms, iterator " << iteratorTime << " ms"
+                << (peekSum == iteratorSum && scatteredSum == iteratorSum ? "" : " (MISMATCH)") << std::endl;
+        }
+        return sout.str();
+    }
+
+    /*
+     Runs fillAndDrain on a list using new and delete, or on one drawing its
+     nodes from a NodePool, and reports its time, throughput and how much
+     the resident set grew up to the list's last peak.
+     */
+    static std::string timeNodeAllocation(bool pooled, int size, int rounds) {
+        std::ostringstream sout;
+        MemoryUsage::releaseFreeMemory();
+        long long before = MemoryUsage::residentBytes();
+        long long peak = before;
+        NodePool<int>* pool = pooled ? new NodePool<int>(4096) : nullptr;
+        List<int>* list = pooled ? new List<int>(pool) : new List<int>();
+        double time = fillAndDrain(list, size, rounds, peak);
+        delete list;
+        delete pool;
+        double operations = 2.0 * size * rounds;
+        sout << (pooled ? "NodePool:   " : "new/delete: ") << time << " ms, " << operations / time / 1000.0
+            << " M ops/s, RSS growth at peak " << (peak - before) / 1024 << " KiB" << std::endl;
+        return sout.str();
+    }
+
+    /*
+     Compares insert/remove throughput of a list using new and delete with a
+     list drawing its nodes from a NodePool, and reports how much the resident
+     set grew by the time each list was at its largest. The heap is asked to
+     give its free memory back before each run, so a run doesn't count as its
+     own memory the last one left with the allocator; whichever runs second
+     still finds the caches warmer, so both orders are run.
+     */
+    static std::string benchmarkNodePool() {
+        std::ostringstream sout;
+        sout << "DataStructureBenchmarks::benchmarkNodePool" << std::endl;
+        const int size = 1000000;
+        const int rounds = 5;
+
+        sout << "new/delete first:" << std::endl;
+        sout << timeNodeAllocation(false, size, rounds);
+        sout << timeNodeAllocation(true, size, rounds);
+        sout << "NodePool first:" << std::endl;
+        sout << timeNodeAllocation(true, size, rounds);
+        sout << timeNodeAllocation(false, size, rounds);
+        return sout.str();
+    }
+
+    /*
+     Compares List and UnrolledList on a full scan, on random indexed access
+     with peek, and on repeated insertion in the middle.
+     */
+    static std::string benchmarkUnrolledList() {
+        std::ostringstream sout;
+        sout << "DataStructureBenchmarks::benchmarkUnrolledList" << std::endl;
+        const int size = 200000;
+        const int lookups = 2000;
+        const int middleInserts = 2000;
+        int value = 1;
+
+        List<int>* list = new List<int>();
+        UnrolledList<int>* unrolled = new UnrolledList<int>();
+        for (int k = 0; k < size; k++) {
+            list->insertAtEnd(&value);
+            unrolled->insertAtEnd(&value);
+        }
+
+        long long sum = 0;
+        Clock::time_point start = Clock::now();
+        for (int* item : *list) {
+            sum += *item;
+        }
+        double listScan = millisecondsSince(start);
+        start = Clock::now();
+        for (int* item : *unrolled) {
+            sum += *item;
+        }
+        double unrolledScan = millisecondsSince(start);
+
+        unsigned int seed = 1;
+        start = Clock::now();
+        for (int k = 0; k < lookups; k++) {
+            seed = seed * 1103515245 + 12345;
+            sum += *list->peek((seed >> 8) % size);
+        }
+        double listPeek = millisecondsSince(start);
+        seed = 1;
+        start = Clock::now();
+        for (int k = 0; k < lookups; k++) {
+            seed = seed * 1103515245 + 12345;
+            sum += *unrolled->peek((seed >> 8) % size);
+        }
+        double unrolledPeek = millisecondsSince(start);
+
+        start = Clock::now();
+        for (int k = 0; k < middleInserts; k++) {
+            list->insertAtPosition(list->getSize() / 2, &value);
+        }
+        double listInsert = millisecondsSince(start);
+        start = Clock::now();
+        for (int k = 0; k < middleInserts; k++) {
+            unrolled->insertAtPosition(unrolled->getSize() / 2, &value);
+        }
+        double unrolledInsert = millisecondsSince(start);
+
+        delete list;
+        delete unrolled;
+
+        sout << "scan of " << size << ": List " << listScan << " ms, UnrolledList "
+            << unrolledScan << " ms" << std::endl;
+        sout << lookups << " random peeks: List " << listPeek << " ms, UnrolledList "
+            << unrolledPeek << " ms" << std::endl;
+        sout << middleInserts << " middle inserts: List " << listInsert << " ms, UnrolledList "
+            << unrolledInsert << " ms" << (sum > 0 ? "" : " (no work)") << std::endl;
+        return sout.str();
+    }
+
+    /*
+     Times index-based loops over lists of increasing size: peek(k) forwards,
+     peek(k) backwards, setData at every position, and peek at every other
+     position. Each of these reaches its position from the previous one
+     through the finger, so doubling the size should roughly double every
+     time. Random peeks, which the finger can't help with, are timed for
+     comparison; their time per peek grows with the size.
+     */
+    static std::string benchmarkFingerCache() {
+        std::ostringstream sout;
+        sout << "DataStructureBenchmarks::benchmarkFingerCache" << std::endl;
+        int value = 1;
+        const int randomPeeks = 2000;
+
+        for (int size = 50000; size <= 400000; size *= 2) {
+            List<int>* list = new List<int>();
+            for (int k = 0; k < size; k++) {
+                list->insertAtEnd(&value);
+            }
+            long long sum = 0;
+
+            Clock::time_point start = Clock::now();
+            for (int k = 0; k < size; k++) {
+                sum += *list->peek(k);
+            }
+            double forwardTime = millisecondsSince(start);
+
+            start = Clock::now();
+            for (int k = size - 1; k >= 0; k--) {
+                sum += *list->peek(k);
+            }
+            double backwardTime = millisecondsSince(start);
+
+            start = Clock::now();
+            for (int k = 0; k < size; k++) {
+                list->setData(&value, k);
+            }
+            double setDataTime = millisecondsSince(start);
+
+            start = Clock::now();
+            for (int k = 0; k < size; k += 2) {
+                sum += *list->peek(k);
+            }
+            double strideTime = millisecondsSince(start);
+
+            unsigned int seed = 12345;
+            start = Clock::now();
+            for (int k = 0; k < randomPeeks; k++) {
+                seed = seed * 1103515245 + 12345;
+                sum += *list->peek((int)((seed >> 8) % size));
+            }
+            double randomTime = millisecondsSince(start);
+
+            delete list;
+
+            sout << "size " << size << ": forward " << forwardTime << " ms, backward "
+                << backwardTime << " ms, setData " << setDataTime << " ms, stride 2 "
+                << strideTime << " ms, " << randomPeeks << " random " << randomTime << " ms"
+                << (sum > 0 ? "" : " (no work)") << std::endl;
+        }
+        return sout.str();
+    }
+
+    /*
+     Compares the throughput of ConcurrentQueue, pushing and popping one item
+     at a time and in batches of 32, with a List guarded by a mutex, for 1
+     to 8 producers with as many consumers (2 to 16 threads). The single
+     producer case also times SingleProducerQueue. Throughput is in millions
+     of items per second.
+     */
+    static std::string benchmarkQueues() {
+        std::ostringstream sout;
+        sout << "DataStructureBenchmarks::benchmarkQueues" << std::endl;
+        const int totalItems = 400000;
+        const int capacity = 1024;
+        const int batchSize = 32;
+
+        for (int numProducers = 1; numProducers <= 8; numProducers *= 2) {
+            int itemsPerProducer = totalItems / numProducers;
+            double items = (double)itemsPerProducer * numProducers;
+
+            ConcurrentQueue<int>* queue = new ConcurrentQueue<int>(capacity);
+            double single = runPipeline(numProducers, numProducers, itemsPerProducer, 1,
+                [queue](int** batch, int) { return queue->push(batch[0]) ? 1 : 0; },
+                [queue](int** batch, int) { batch[0] = queue->pop(); return batch[0] != nullptr ? 1 : 0; });
+            double batched = runPipeline(numProducers, numProducers, itemsPerProducer, batchSize,
+                [queue](int** batch, int count) { return queue->pushBatch(batch, count); },
+                [queue](int** batch, int maxCount) { return queue->popBatch(batch, maxCount); });
+            delete queue;
+
+            std::mutex listMutex;
+            List<int>* list = new List<int>();
+            double locked = runPipeline(numProducers, numProducers, itemsPerProducer, 1,
+                [&listMutex, list](int** batch, int) {
+                    std::lock_guard<std::mutex> lock(listMutex);
+                    list->insertAtEnd(batch[0]);
+                    return 1;
+                },
+                [&listMutex, list](int** batch, int) {
+                    std::lock_guard<std::mutex> lock(listMutex);
+                    batch[0] = list->removeFromStart();
+                    return batch[0] != nullptr ? 1 : 0;
+                });
+            delete list;
+
+            sout << numProducers << "+" << numProducers << " threads: ConcurrentQueue "
+                << items / single / 1000.0 << ", batched " << items / batched / 1000.0
+                << ", mutex List " << items / locked / 1000.0;
+
+            if (numProducers == 1) {
+                SingleProducerQueue<int>* spsc = new SingleProducerQueue<int>(capacity);
+                double spscSingle = runPipeline(1, 1, itemsPerProducer, 1,
+                    [spsc](int** batch, int) { return spsc->push(batch[0]) ? 1 : 0; },
+                    [spsc](int** batch, int) { batch[0] = spsc->pop(); return batch[0] != nullptr ? 1 : 0; });
+                double spscBatched = runPipeline(1, 1, itemsPerProducer, batchSize,
+                    [spsc](int** batch, int count) { return spsc->pushBatch(batch, count); },
+                    [spsc](int** batch, int maxCount) { return spsc->popBatch(batch, maxCount); });
+                delete spsc;
+                sout << ", SingleProducerQueue " << items / spscSingle / 1000.0
+                    << ", batched " << items / spscBatched / 1000.0;
+            }
+            sout << (single > 0 && batched > 0 && locked > 0 ? "" : " (LOST ITEMS)") << std::endl;
+        }
+        return sout.str();
+    }
+
+    /*
+     Times inserting every key of the specified vector into a HashMap and
+     into a std::unordered_map, then looking each one up once, in shuffled
+     order, by a key of type Lookup made from it. Appends one line to the
+     specified report.
+     */
+    template <typename K, typename Lookup>
+    static void timeMaps(std::ostringstream& sout, std::vector<K>& keys, bool reserved) {
+        int size = (int)keys.size();
+        int value = 1;
+        long long hits = 0;
+        std::vector<int> order(size);
+        unsigned int seed = 99;
+        for (int k = 0; k < size; k++) {
+            seed = seed * 1103515245 + 12345;
+            int other = (int)(seed % (unsigned int)(k + 1));
+            order[k] = order[other];
+            order[other] = k;
+        }
+
+        Clock::time_point start = Clock::now();
+        HashMap<K, int>* map = new HashMap<K, int>();
+        if (reserved) {
+            map->reserve(size);
+        }
+        for (K& key : keys) {
+            map->insert(&key, &value);
+        }
+        double mapInsert = millisecondsSince(start);
+        start = Clock::now();
+        for (int k : order) {
+            hits += map->get(Lookup(keys[k])) != nullptr;
+        }
+        double mapLookup = millisecondsSince(start);
+        delete map;
+
+        start = Clock::now();
+        std::unordered_map<K, int*>* standard = new std::unordered_map<K, int*>();
+        if (reserved) {
+            standard->reserve(size);
+        }
+        for (K& key : keys) {
+            standard->emplace(key, &value);
+        }
+        double standardInsert = millisecondsSince(start);
+        start = Clock::now();
+        for (int k : order) {
+            hits += standard->find(keys[k]) != standard->end();
+        }
+        double standardLookup = millisecondsSince(start);
+        delete standard;
+
+        sout << size << (reserved ? " reserved" : "") << ": HashMap insert " << mapInsert
+            << " ms, lookup " << mapLookup << " ms; std::unordered_map insert " << standardInsert
+            << " ms, lookup " << standardLookup << " ms" << (hits == 2LL * size ? "" : " (MISSED KEYS)")
+            << std::endl;
+    }
+
+    /*
+     Compares HashMap with std::unordered_map at 1k, 1M and 10M entries. The
+     first two use std::string keys looked up by std::string_view; 10M uses
+     long long keys to keep the run within a few hundred megabytes. The 1k
+     run also times the linear List scan that keyed lookups used before.
+     */
+    static std::string benchmarkHashMap() {
+        std::ostringstream sout;
+        sout << "DataStructureBenchmarks::benchmarkHashMap" << std::endl;
+
+        for (int size = 1000; size <= 1000000; size *= 1000) {
+            std::vector<std::string> names(size);
+            for (int k = 0; k < size; k++) {
+                names[k] = "player" + std::to_string(k * 7919);
+            }
+            timeMaps<std::string, std::string_view>(sout, names, false);
+            timeMaps<std::string, std::string_view>(sout, names, true);
+
+            if (size == 1000) {
+                List<Pair<std::string, int>>* list = new List<Pair<std::string, int>>();
+                list->setOwnsData(true);
+                int value = 1;
+                for (std::string& name : names) {
+                    list->insertAtEnd(new Pair<std::string, int>(&name, &value));
+                }
+                long long hits = 0;
+                Clock::time_point start = Clock::now();
+                for (std::string& name : names) {
+                    std::string_view key = name;
+                    for (Pair<std::string, int>* entry : *list) {
+                        if (*entry->first == key) {
+                            hits++;
+                            break;
+                        }
+                    }
+                }
+                double scan = millisecondsSince(start);
+                delete list;
+                sout << size << ": List scan lookup " << scan << " ms"
+                    << (hits == size ? "" : " (MISSED KEYS)") << std::endl;
+            }
+        }
+
+        std::vector<long long> ids(10000000);
+        for (int k = 0; k < (int)ids.size(); k++) {
+            ids[k] = (long long)k * 2654435761LL;
+        }
+        timeMaps<long long, long long>(sout, ids, true);
+        return sout.str();
+    }
+
+    /*
+     Compares OrderedMap with std::map on inserting a million keys in random
+     order, looking each one up, and range scans of 100 entries starting at
+     lowerBound of random keys.
+     */
+    static std::string benchmarkOrderedMap() {
+        std::ostringstream sout;
+        sout << "DataStructureBenchmarks::benchmarkOrderedMap" << std::endl;
+        const int size = 1000000;
+        const int numScans = 10000;
+        const int scanLength = 100;
+        int value = 1;
+
+        std::vector<int> keys(size);
+        for (int k = 0; k < size; k++) {
+            keys[k] = 2 * k;
+        }
+        unsigned int seed = 17;
+        for (int k = size - 1; k > 0; k--) {
+            seed = seed * 1103515245 + 12345;
+            int other = (int)((seed >> 4) % (unsigned int)(k + 1));
+            int temp = keys[k];
+            keys[k] = keys[other];
+            keys[other] = temp;
+        }
+        long long checksum = 0;
+
+        OrderedMap<int, int>* map = new OrderedMap<int, int>();
+        Clock::time_point start = Clock::now();
+        for (int& key : keys) {
+            map->insert(&key, &value);
+        }
+        double mapInsert = millisecondsSince(start);
+        start = Clock::now();
+        for (int& key : keys) {
+            checksum += *map->get(key);
+        }
+        double mapLookup = millisecondsSince(start);
+        start = Clock::now();
+        for (int k = 0; k < numScans; k++) {
+            OrderedMap<int, int>::iterator entry = map->lowerBound(keys[k] - 1);
+            for (int j = 0; j < scanLength && entry != map->end(); j++, ++entry) {
+                checksum += *entry->first;
+            }
+        }
+        double mapScan = millisecondsSince(start);
+        delete map;
+
+        std::map<int, int*>* standard = new std::map<int, int*>();
+        start = Clock::now();
+        for (int& key : keys) {
+            standard->emplace(key, &value);
+        }
+        double standardInsert = millisecondsSince(start);
+        start = Clock::now();
+        for (int& key : keys) {
+            checksum -= *standard->find(key)->second;
+        }
+        double standardLookup = millisecondsSince(start);
+        start = Clock::now();
+        for (int k = 0; k < numScans; k++) {
+            std::map<int, int*>::iterator entry = standard->lower_bound(keys[k] - 1);
+            for (int j = 0; j < scanLength && entry != standard->end(); j++, ++entry) {
+                checksum -= entry->first;
+            }
+        }
+        double standardScan = millisecondsSince(start);
+        delete standard;
+
+        sout << size << " keys: OrderedMap insert " << mapInsert << " ms, lookup " << mapLookup
+            << " ms, " << numScans << " scans " << mapScan << " ms" << std::endl;
+        sout << size << " keys: std::map insert " << standardInsert << " ms, lookup " << standardLookup
+            << " ms, " << numScans << " scans " << standardScan << " ms"
+            << (checksum == 0 ? "" : " (MISMATCH)") << std::endl;
+        return sout.str();
+    }
+
+    /*
+     Writes story line k into the specified string: one of a thousand stock
+     lines for every third line, otherwise a line of its own.
+     */
+    static void makeStoryLine(int k, std::string& line) {
+        line = k % 3 == 0 ? "You hear the echo of dripping water, number " + std::to_string(k % 1000)
+            : "The torchlight flickers over carvings of a battle long forgotten, scene " + std::to_string(k);
+    }
+
+    /*
+     Compares the memory and time taken by a million story lines in lists of
+     a hundred, stored as one std::string each in owning lists, and interned
+     in a StringArena with the lists holding handles. Memory is the growth
+     of the resident set while the lines are stored. Both sets of lines are
+     kept until the end, so neither run reuses memory the other freed.
+     */
+    static std::string benchmarkStringArena() {
+        std::ostringstream sout;
+        sout << "DataStructureBenchmarks::benchmarkStringArena" << std::endl;
+        const int numLines = 1000000;
+        const int linesPerStory = 100;
+        std::string line;
+
+        long long before = MemoryUsage::residentBytes();
+        Clock::time_point start = Clock::now();
+        std::vector<List<std::string>*> stories(numLines / linesPerStory);
+        for (int s = 0; s < (int)stories.size(); s++) {
+            stories[s] = new List<std::string>();
+            stories[s]->setOwnsData(true);
+            for (int k = s * linesPerStory; k < (s + 1) * linesPerStory; k++) {
+                makeStoryLine(k, line);
+                stories[s]->insertAtEnd(new std::string(line));
+            }
+        }
+        double stringTime = millisecondsSince(start);
+        long long stringGrowth = MemoryUsage::residentBytes() - before;
+
+        before = MemoryUsage::residentBytes();
+        start = Clock::now();
+        StringArena* arena = new StringArena();
+        std::vector<List<std::string_view>*> views(numLines / linesPerStory);
+        for (int s = 0; s < (int)views.size(); s++) {
+            views[s] = new List<std::string_view>();
+            for (int k = s * linesPerStory; k < (s + 1) * linesPerStory; k++) {
+                makeStoryLine(k, line);
+                views[s]->insertAtEnd(arena->intern(line));
+            }
+        }
+        double arenaTime = millisecondsSince(start);
+        long long arenaGrowth = MemoryUsage::residentBytes() - before;
+        sout << numLines << " lines, " << arena->getNumStrings() << " distinct" << std::endl;
+        sout << "std::string each: " << stringTime << " ms, RSS growth " << stringGrowth / (1024 * 1024) << " MiB, "
+            << stringGrowth / numLines << " bytes per line" << std::endl;
+        sout << "StringArena:      " << arenaTime << " ms, RSS growth " << arenaGrowth / (1024 * 1024) << " MiB, "
+            << arenaGrowth / numLines << " bytes per line (arena " << arena->getBytesAllocated() / (1024 * 1024)
+            << " MiB for " << arena->getTextBytes() / (1024 * 1024) << " MiB of text)" << std::endl;
+        for (List<std::string>* story : stories) {
+            delete story;
+        }
+        for (List<std::string_view>* story : views) {
+            delete story;
+        }
+        delete arena;
+        return sout.str();
+    }
+
+    static std::string runAllBenchmarks() {
+        std::ostringstream sout;
+        sout << benchmarkIteration() << std::endl;
+        sout << benchmarkFingerCache() << std::endl;
+        sout << benchmarkNodePool() << std::endl;
+        sout << benchmarkUnrolledList() << std::endl;
+        sout << benchmarkQueues() << std::endl;
+        sout << benchmarkHashMap() << std::endl;
+        sout << benchmarkOrderedMap() << std::endl;
+        sout << benchmarkStringArena() << std::endl;
+        return sout.str();
+    }
+
+};
@@ -1,20 +1,24 @@
 #pragma once
 #include "Vertex.h"
 #include "Pair.h"
+#include <utility>
 
 
 /*
 A template representing an edge in a graph.
 Typename T refers to the data type stored in vertices.
 Typename U refers to the data type stored in edges.
+The edge doesn't own the vertices or the data it points to.
 */
 template <typename T, typename U>
 class Edge
 {
 protected:
 
-	// Stores an edge as a pair of vertices (initial vertex , terminal vertex) (from , to) 
-	Pair<Vertex<T>, Vertex<T>>* theEdge;
+	// Stores an edge as a pair of vertices (initial vertex , terminal vertex) (from , to).
+	// The pair is part of the edge itself, so an edge is a single allocation and
+	// reaching its vertices doesn't go through another pointer
+	Pair<Vertex<T>, Vertex<T>> theEdge;
 
 	//edgeWeight parameter can store some sort of data in the edge
 	double edgeWeight;
@@ -22,13 +26,55 @@ protected:
 	//Pointer to the data stored in the edge
 	U* data;
 
+	//Position of this edge's entry in its initial vertex's out-list, kept up to date
+	//by the graph holding the edge so it can unlink the edge without searching;
+	//-1 while the edge is in no graph
+	int outPosition;
+
 public:
 	//Creates an edge with values given, the defualt edgeWeight is 1, and sine there is no data 
 	//Data is initialized as nullptr
-	Edge(Vertex<T>* initialVertex, Vertex<T>* terminalVertex) {
-		this->theEdge = new Pair<Vertex<T>, Vertex<T>>(initialVertex, terminalVertex);
+	Edge(Vertex<T>* initialVertex, Vertex<T>* terminalVertex) : theEdge(initialVertex, terminalVertex) {
 		this->edgeWeight = 1;
 		this->data = nullptr;
+		this->outPosition = -1;
+	}
+
+	//Creates an edge between the same vertices, with the same weight and data, as the given edge.
+	//The copy is in no graph
+	Edge(const Edge<T, U>& other) : theEdge(other.theEdge) {
+		this->edgeWeight = other.edgeWeight;
+		this->data = other.data;
+		this->outPosition = -1;
+	}
+
+	//Takes over the vertices and data of the given edge. The given edge can only be
+	//destroyed or assigned to afterwards
+	Edge(Edge<T, U>&& other) : theEdge(std::move(other.theEdge)) {
+		this->edgeWeight = other.edgeWeight;
+		this->data = other.data;
+		this->outPosition = other.outPosition;
+		other.data = nullptr;
+	}
+
+	Edge<T, U>& operator=(const Edge<T, U>& other) {
+		if (this != &other) {
+			this->theEdge = other.theEdge;
+			this->edgeWeight = other.edgeWeight;
+			this->data = other.data;
+		}
+		return *this;
+	}
+
+	Edge<T, U>& operator=(Edge<T, U>&& other) {
+		if (this != &other) {
+			this->theEdge = std::move(other.theEdge);
+			this->edgeWeight = other.edgeWeight;
+			this->data = other.data;
+			this->outPosition = other.outPosition;
+			other.data = nullptr;
+		}
+		return *this;
 	}
 
 	//Gets the data from the vertex
@@ -43,12 +89,18 @@ public:
 
 	//Getter for initial vertex from any pair 
 	Vertex<T>* getInitialVertex() {
-		return this->theEdge->first;
+		return this->theEdge.first;
 	}
 
 	//Getter for terminal vertex from any pair 
 	Vertex<T>* getTerminalVertex() {
-		return this->theEdge->second;
+		return this->theEdge.second;
+	}
+
+	//Getter for the (initial vertex , terminal vertex) pair itself, which the graph uses
+	//as the key of its edge index. The pair must not be changed through this pointer
+	Pair<Vertex<T>, Vertex<T>>* getVertexPair() {
+		return &this->theEdge;
 	}
 
 	//Getter for edgeWeight
@@ -61,6 +113,14 @@ public:
 		this->edgeWeight = weight;
 	}
 
+	int getOutPosition() {
+		return this->outPosition;
+	}
+
+	void setOutPosition(int position) {
+		this->outPosition = position;
+	}
+
 	//Will be able to tell if the edge is a loop 
 	bool isLoop() {
 		Vertex<T>* initVer = getInitialVertex();
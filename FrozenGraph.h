@@ -0,0 +1,285 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "Vertex.h"
+#include "Edge.h"
+#include "List.h"
+#include "PointerIndex.h"
+
+/*
+An immutable snapshot of a Graph in compressed sparse row form, made by
+Graph::freeze for read-mostly work such as traversals.
+
+Vertices are numbered 0 to n - 1 in the order of the graph's vertex list.
+The out-edges of vertex v are entries offsets[v] to offsets[v + 1] - 1 of
+the neighbors array, sorted by neighbor id, with their weights and data in
+parallel arrays, so a traversal reads a few contiguous arrays instead of
+chasing vertex and list node pointers. Ids map back to the original
+Vertex<T>* through getVertex, and vertices map to ids through getVertexId.
+
+The snapshot holds the data pointers the graph held when it was frozen; it
+owns none of them, and must not outlive the vertices of its graph. Later
+changes to the graph are not reflected in it.
+*/
+template <typename T, typename U>
+class FrozenGraph {
+
+protected:
+
+	/*
+	The original vertices, by id.
+	*/
+	std::vector<Vertex<T>*> vertices;
+
+	/*
+	The data stored in each vertex when the graph was frozen, by id.
+	*/
+	std::vector<T*> vertexData;
+
+	/*
+	offsets[v] is the position in neighbors of the first out-edge of vertex
+	v; offsets[n] is the number of edges.
+	*/
+	std::vector<int> offsets;
+
+	std::vector<int> neighbors;
+
+	std::vector<double> weights;
+
+	std::vector<U*> edgeData;
+
+	/*
+	Maps each original vertex to its id.
+	*/
+	PointerIndex<Vertex<T>> vertexIds;
+
+	/*
+	Returns the position in neighbors of the edge from the vertex with id
+	fromId to the vertex with id toId, or a negative number if there is no
+	such edge. Binary search within the row.
+	*/
+	int findEdgePosition(int fromId, int toId) {
+		if (fromId < 0 || fromId >= (int)this->vertices.size() || toId < 0) {
+			return -1;
+		}
+		std::vector<int>::iterator rowStart = this->neighbors.begin() + this->offsets[fromId];
+		std::vector<int>::iterator rowEnd = this->neighbors.begin() + this->offsets[fromId + 1];
+		std::vector<int>::iterator found = std::lower_bound(rowStart, rowEnd, toId);
+		if (found == rowEnd || *found != toId) {
+			return -1;
+		}
+		return (int)(found - this->neighbors.begin());
+	}
+
+public:
+
+	/*
+	Freezes the specified vertex and edge lists, which can be any containers
+	whose iterators yield Vertex<T>* and Edge<T, U>*. Every edge must join
+	two vertices of the vertex list. Graph::freeze is the usual way to call
+	this.
+	*/
+	template <typename VertexList, typename EdgeList>
+	FrozenGraph(VertexList& vertexList, EdgeList& edgeList) {
+		for (Vertex<T>* vertex : vertexList) {
+			this->vertices.push_back(vertex);
+			this->vertexData.push_back(vertex->getData());
+		}
+		this->vertexIds.rebuild(this->vertices);
+		int numVertices = (int)this->vertices.size();
+
+		// count the out-edges of each vertex, then turn the counts into offsets
+		this->offsets.assign(numVertices + 1, 0);
+		int numEdges = 0;
+		for (Edge<T, U>* edge : edgeList) {
+			this->offsets[this->vertexIds.getPosition(edge->getInitialVertex()) + 1]++;
+			numEdges++;
+		}
+		for (int v = 0; v < numVertices; v++) {
+			this->offsets[v + 1] += this->offsets[v];
+		}
+
+		// drop each edge into the next free place in its row
+		std::vector<int> rowEnds(this->offsets.begin(), this->offsets.end() - 1);
+		std::vector<int> unsortedNeighbors(numEdges);
+		std::vector<Edge<T, U>*> unsortedEdges(numEdges);
+		for (Edge<T, U>* edge : edgeList) {
+			int from = this->vertexIds.getPosition(edge->getInitialVertex());
+			int position = rowEnds[from]++;
+			unsortedNeighbors[position] = this->vertexIds.getPosition(edge->getTerminalVertex());
+			unsortedEdges[position] = edge;
+		}
+
+		// sort each row by neighbor id, carrying weights and data along
+		this->neighbors.resize(numEdges);
+		this->weights.resize(numEdges);
+		this->edgeData.resize(numEdges);
+		std::vector<int> order;
+		for (int v = 0; v < numVertices; v++) {
+			int rowStart = this->offsets[v];
+			int rowLength = this->offsets[v + 1] - rowStart;
+			order.resize(rowLength);
+			for (int k = 0; k < rowLength; k++) {
+				order[k] = rowStart + k;
+			}
+			std::sort(order.begin(), order.end(), [&unsortedNeighbors](int a, int b) {
+				return unsortedNeighbors[a] < unsortedNeighbors[b];
+			});
+			for (int k = 0; k < rowLength; k++) {
+				this->neighbors[rowStart + k] = unsortedNeighbors[order[k]];
+				this->weights[rowStart + k] = unsortedEdges[order[k]]->getEdgeWeight();
+				this->edgeData[rowStart + k] = unsortedEdges[order[k]]->getData();
+			}
+		}
+	}
+
+	/*
+	Returns the number of vertices in this snapshot.
+	*/
+	int getNumVertices() {
+		return (int)this->vertices.size();
+	}
+
+	/*
+	Returns the number of edges in this snapshot.
+	*/
+	int getNumEdges() {
+		return (int)this->neighbors.size();
+	}
+
+	/*
+	Returns the id of the specified vertex, or a negative number if it was
+	not part of the graph when it was frozen.
+	*/
+	int getVertexId(Vertex<T>* vertex) {
+		return this->vertexIds.getPosition(vertex);
+	}
+
+	/*
+	Returns the original vertex with the specified id, or the null pointer
+	if there is no such id.
+	*/
+	Vertex<T>* getVertex(int id) {
+		if (id < 0 || id >= (int)this->vertices.size()) {
+			return nullptr;
+		}
+		return this->vertices[id];
+	}
+
+	/*
+	Returns the data stored in the vertex with the specified id, or the null
+	pointer if there is no such id.
+	*/
+	T* getVertexData(int id) {
+		if (id < 0 || id >= (int)this->vertices.size()) {
+			return nullptr;
+		}
+		return this->vertexData[id];
+	}
+
+	/*
+	Returns the data stored in the specified vertex, or the null pointer if
+	the vertex is not part of this snapshot.
+	*/
+	T* getVertexData(Vertex<T>* vertex) {
+		return this->getVertexData(this->getVertexId(vertex));
+	}
+
+	/*
+	Returns the out-degree of the vertex with the specified id, or a
+	negative number if there is no such id.
+	*/
+	int getOutDegree(int id) {
+		if (id < 0 || id >= (int)this->vertices.size()) {
+			return -1;
+		}
+		return this->offsets[id + 1] - this->offsets[id];
+	}
+
+	/*
+	Returns a pointer to the ids of the out-neighbors of the vertex with the
+	specified id, sorted, and getOutDegree(id) long. The id must be valid.
+	*/
+	const int* getNeighbors(int id) {
+		return this->neighbors.data() + this->offsets[id];
+	}
+
+	/*
+	Returns a pointer to the weights of the out-edges of the vertex with the
+	specified id, in the same order as getNeighbors. The id must be valid.
+	*/
+	const double* getNeighborWeights(int id) {
+		return this->weights.data() + this->offsets[id];
+	}
+
+	/*
+	Returns a list of the outgoing vertices from the specified vertex, in
+	order of id. If the specified vertex is not part of this snapshot, this
+	method returns the empty list. The caller is responsible for deleting
+	the returned list.
+	*/
+	List<Vertex<T>>* getOutgoingVertices(Vertex<T>* vertex) {
+		List<Vertex<T>>* result = new List<Vertex<T>>();
+		int id = this->getVertexId(vertex);
+		if (id >= 0) {
+			for (int k = this->offsets[id]; k < this->offsets[id + 1]; k++) {
+				result->insertAtEnd(this->vertices[this->neighbors[k]]);
+			}
+		}
+		return result;
+	}
+
+	/*
+	Returns true if and only if this snapshot has an edge from the vertex
+	with id fromId to the vertex with id toId.
+	*/
+	bool hasEdge(int fromId, int toId) {
+		return this->findEdgePosition(fromId, toId) >= 0;
+	}
+
+	bool hasEdge(Vertex<T>* from, Vertex<T>* to) {
+		return this->hasEdge(this->getVertexId(from), this->getVertexId(to));
+	}
+
+	/*
+	Returns the weight of the edge from the vertex with id fromId to the
+	vertex with id toId, or NaN if there is no such edge.
+	*/
+	double getEdgeWeight(int fromId, int toId) {
+		int position = this->findEdgePosition(fromId, toId);
+		return position >= 0 ? this->weights[position] : std::nan("");
+	}
+
+	/*
+	Returns the weight of the specified edge, or NaN if it is not part of
+	this snapshot.
+	*/
+	double getEdgeWeight(Vertex<T>* from, Vertex<T>* to) {
+		return this->getEdgeWeight(this->getVertexId(from), this->getVertexId(to));
+	}
+
+	/*
+	Returns the data stored in the specified edge, or the null pointer if
+	the edge is not part of this snapshot or holds no data.
+	*/
+	U* getEdgeData(Vertex<T>* from, Vertex<T>* to) {
+		int position = this->findEdgePosition(this->getVertexId(from), this->getVertexId(to));
+		return position >= 0 ? this->edgeData[position] : nullptr;
+	}
+
+	/*
+	Returns a string representation of this snapshot.
+	*/
+	std::string toString() {
+		std::ostringstream sout;
+		sout << "FrozenGraph at: " << this << std::endl;
+		sout << "Number of total verticies: " << this->getNumVertices() << std::endl;
+		sout << "Number of total edges: " << this->getNumEdges() << std::endl;
+		return sout.str();
+	}
+
+};
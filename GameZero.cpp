@@ -2,12 +2,14 @@
 #include "GameZero.h"
 #include "Vertex.h"
 #include "Player.h"
+#include "WorldLoader.h"
 
 
 //Should create and initialize the player and the game graph
 GameZero::GameZero() {
 	this->thePlayer = new Player();
 	this->theGraph = nullptr;
+	this->storyText = new StringArena();
 	// get Player info 
 	this->getUserInfo();
 	//build the new game graph 
@@ -22,11 +24,19 @@ GameZero::GameZero() {
 GameZero::GameZero(Player* player) {
 	this->thePlayer = player;
 	this->theGraph = nullptr;
+	this->storyText = new StringArena();
 	this->buildGameGraph();
 
 	std::cout << thePlayer->toString() << std::endl;
 }
 
+//Frees the game graph, along with the rooms and story lists it owns, and
+// then the story text they point into
+GameZero::~GameZero() {
+	delete this->theGraph;
+	delete this->storyText;
+}
+
 
 //Meathod to start the game
 void GameZero::startGame() {
@@ -49,27 +59,58 @@ std::string GameZero::toString() {
 	return sout.str();
 }
 
+//Reports the graph, the story lists hanging off it and the text they point into
+void GameZero::reportMemory(MemoryReport* report) {
+	this->theGraph->reportMemory(report, "world.graph");
+	for (Vertex<List<std::string_view>>* room : *this->theGraph->getVertices()) {
+		if (room->getData() != nullptr) {
+			room->getData()->reportMemory(report, "world.stories");
+		}
+	}
+	for (Edge<List<std::string_view>, List<std::string_view>>* exit : *this->theGraph->getEdges()) {
+		if (exit->getData() != nullptr) {
+			exit->getData()->reportMemory(report, "world.stories");
+		}
+	}
+	this->storyText->reportMemory(report, "world.text");
+}
+
 //All protected feilds down here
 
 
-//Build our graph for the game
+//Build our graph for the game from the world file, so the story can change
+// without rebuilding the game
 void GameZero::buildGameGraph() {
-	this->theGraph = new Graph <List <std::string>, List <std::string>>();
+	WorldLoader loader(this->storyText);
+	this->theGraph = loader.loadFile("GameZero.world");
+	if (this->theGraph == nullptr) {
+		std::cout << "GameZero.world (line " << loader.getErrorLine() << ", column " << loader.getErrorColumn()
+			<< "): " << loader.getErrorMessage() << std::endl;
+		std::cout << "Starting in the dragon's lair instead.\n";
+		this->buildDefaultGameGraph();
+	}
+}
+
+//Build the dragon's lair in code, for when the world file can't be loaded
+void GameZero::buildDefaultGameGraph() {
+	// the graph owns the rooms and the story lists stored in them
+	this->theGraph = new Graph <List <std::string_view>, List <std::string_view>>(true);
 	//add single vertex
-	Vertex<List<std::string>>* dragonsLair = new Vertex<List<std::string>>();
+	Vertex<List<std::string_view>>* dragonsLair = new Vertex<List<std::string_view>>();
 	this->theGraph->addVertex(dragonsLair);
-	//Add some string data to decribe the story that occurs in the dragons lair 
-	List<std::string>* storyList = new List<std::string>();
+	//Add some string data to decribe the story that occurs in the dragons lair,
+	// keeping the text itself in the story arena
+	List<std::string_view>* storyList = new List<std::string_view>();
 	//add some strings to the list
-	storyList->insertAtEnd(new std::string("You awaken in a dark underground pit..."));
-	storyList->insertAtEnd(new std::string("You can't see far ahead of you but you see a light at the end of the room..."));
-	storyList->insertAtEnd(new std::string("You stumble forward, weary of what's ahead..."));
-	storyList->insertAtEnd(new std::string("As you draw closer to the flame you realize it's a slumbering dragon..."));
-	storyList->insertAtEnd(new std::string("Slowly you back away as a glimmer of gold catches your eye..."));
-	storyList->insertAtEnd(new std::string("Greedily you double back to claim some of the booty..."));
-	storyList->insertAtEnd(new std::string("As you grab the gold the dragon begains to awaken..."));
-	storyList->insertAtEnd(new std::string("The dragon awakens to find you stealing his wealth..."));
-	storyList->insertAtEnd(new std::string("The dragon spits out three fire ghosts as defence... goodluck!"));
+	storyList->insertAtEnd(this->storyText->intern("You awaken in a dark underground pit..."));
+	storyList->insertAtEnd(this->storyText->intern("You can't see far ahead of you but you see a light at the end of the room..."));
+	storyList->insertAtEnd(this->storyText->intern("You stumble forward, weary of what's ahead..."));
+	storyList->insertAtEnd(this->storyText->intern("As you draw closer to the flame you realize it's a slumbering dragon..."));
+	storyList->insertAtEnd(this->storyText->intern("Slowly you back away as a glimmer of gold catches your eye..."));
+	storyList->insertAtEnd(this->storyText->intern("Greedily you double back to claim some of the booty..."));
+	storyList->insertAtEnd(this->storyText->intern("As you grab the gold the dragon begains to awaken..."));
+	storyList->insertAtEnd(this->storyText->intern("The dragon awakens to find you stealing his wealth..."));
+	storyList->insertAtEnd(this->storyText->intern("The dragon spits out three fire ghosts as defence... goodluck!"));
 	//After all stories store list in vertex
 	this->theGraph->storeInVertex(storyList , 0);
 }
@@ -117,10 +158,11 @@ void GameZero::getUserInfo() {
 void GameZero::printVertexData() {
 	std::cout << "The story thus far: " << std::endl;
 	//get pointer to the list of strings (graph)
-	List<std::string>* storyList = this->theGraph->getVertexData(0);
-	for (int k = 0; k < storyList->getSize(); k++) {
-		//get k from the list 
-		std::string* itemk = storyList->peek(k);
+	List<std::string_view>* storyList = this->theGraph->getVertexData(0);
+	if (storyList == nullptr) {
+		return;
+	}
+	for (std::string_view* itemk : *storyList) {
 		std::cout << *itemk << std::endl;
 		this->getUserResponse();
 	}
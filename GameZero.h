@@ -2,7 +2,10 @@
 #include "Graph.h"
 #include "Player.h"
 #include "List.h"
+#include "MemoryReport.h"
+#include "StringArena.h"
 #include <string>
+#include <string_view>
 class GameZero
 {
 
@@ -16,6 +19,9 @@ public:
 	   */
 	GameZero(Player* player);
 
+	//Frees the game graph
+	~GameZero();
+
 	//Meathod to start the game
 	void startGame();
 
@@ -25,17 +31,31 @@ public:
 	// toString 
 	std::string toString();
 
+	/*
+	   Adds the memory taken by the game world to the specified report: the
+	   graph under "world.graph", the story lists of its rooms and exits
+	   under "world.stories" and the story text under "world.text". Call
+	   toKeyValue or toJson on the report to dump it.
+	   */
+	void reportMemory(MemoryReport* report);
+
 protected:
 
 	//The player in our game
 	Player* thePlayer;
 
-	//The graph for our game 
-	Graph<List<std::string>, List<std::string>>* theGraph;
+	//The graph for our game. Its story lists point into storyText
+	Graph<List<std::string_view>, List<std::string_view>>* theGraph;
+
+	//The story text of the game, stored once per distinct line
+	StringArena* storyText;
 
-	//Build our graph for the game
+	//Build our graph for the game from the world file GameZero.world
 	void buildGameGraph();
 
+	//Build the single-room graph the game used before it had a world file
+	void buildDefaultGameGraph();
+
 	//Function to prompt the user for character info  to create the player
 	// object representing the game player
 	void getUserInfo();
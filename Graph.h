@@ -5,14 +5,44 @@
 #include <typeinfo>
 #include "Vertex.h"
 #include "Edge.h"
+#include "FrozenGraph.h"
+#include "List.h"
+#include "ArrayList.h"
+#include "HashMap.h"
+#include "MemoryReport.h"
 #include <cmath>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
 
 /*
 A templated class to represent directed graphs. The vertices of the graph can
 store pointers to data of type T, and the edges of the graph can store pointers
 to data of type U.
+
+Container is the list template used to hold the vertex and edge sets. It
+defaults to ArrayList, whose constant-time access by index is how most of
+the graph's methods reach vertices and edges. Any template with
+List's method names and iterators can be used; List itself keeps its nodes
+in place as the graph grows, but reaching an index means walking to it.
+
+The vertex set is always indexed (see Chain::setIndexed), so looking up a
+vertex, which addVertex, addEdge, hasVertex and the degree queries all do,
+takes constant expected time. Edges are likewise found through a hash index
+keyed by their (from, to) vertex pair, so hasEdge, getEdgeIndex and the
+per-edge weight and data methods take constant expected time too.
+
+Vertices and edges are removed by moving the last vertex or edge into the
+removed one's place, so indices stay dense and only the moved item's index
+changes. Adjacency works the same way: each edge remembers its position in
+its initial vertex's out-list, from which Vertex::removeOutVertexAt
+unlinks it at both ends in constant time. With the default ArrayList,
+removing an edge therefore takes constant expected time, and removing a
+vertex takes time proportional to its own degree, however large its
+neighbours' degrees. With List each removal also walks to the removed
+position, in time proportional to the size of the graph.
 */
-template <typename T, typename U>
+template <typename T, typename U, template <typename> class Container = ArrayList>
 class Graph {
 
 protected:
@@ -20,21 +50,308 @@ protected:
 	/*
 	This list contains the vertices that are part of this graph.
 	*/
-	List<Vertex<T>>* vertices;
+	Container<Vertex<T>>* vertices;
 
 	/*
 	This list contains the edges that are part of this graph.
 	*/
-	List<Edge<T, U>>* edges;
+	Container<Edge<T, U>>* edges;
+
+	/*
+	If true, this graph owns its vertices and the data stored in its vertices
+	and edges, and deletes them when it is destroyed. The edges themselves are
+	always owned by the graph, since it is the graph that creates them.
+	*/
+	bool ownsContents;
+
+	/*
+	Hashes an edge's (from, to) vertex pair by the two vertex addresses.
+	*/
+	struct VertexPairHash {
+		size_t operator()(const Pair<Vertex<T>, Vertex<T>>& vertexPair) const {
+			size_t fromHash = std::hash<Vertex<T>*>()(vertexPair.first);
+			size_t toHash = std::hash<Vertex<T>*>()(vertexPair.second);
+			return fromHash ^ (toHash + 0x9E3779B9 + (fromHash << 6) + (fromHash >> 2));
+		}
+	};
+
+	/*
+	Index from the vertex pair of each edge (the edge's own pair, so no extra
+	keys are allocated) to the edge itself. The edge set is indexed as well,
+	so an edge's position can also be found in constant expected time.
+	*/
+	HashMap<Pair<Vertex<T>, Vertex<T>>, Edge<T, U>, VertexPairHash>* edgeIndex;
+
+	/*
+	Creates the empty vertex list, edge list and edge index of a new graph.
+	*/
+	void createContents() {
+		this->vertices = new Container<Vertex<T>>();
+		this->vertices->setIndexed(true);
+		this->edges = new Container<Edge<T, U>>();
+		this->edges->setIndexed(true);
+		this->edgeIndex = new HashMap<Pair<Vertex<T>, Vertex<T>>, Edge<T, U>, VertexPairHash>();
+	}
+
+	/*
+	Returns the edge from the "from" vertex to the "to" vertex, or the null
+	pointer if this graph has no such edge.
+	*/
+	Edge<T, U>* findEdge(Vertex<T>* from, Vertex<T>* to) {
+		Pair<Vertex<T>, Vertex<T>> key(from, to);
+		return this->edgeIndex->get(key);
+	}
+
+	/*
+	Returns the vertex with the specified id, or the null pointer if the id
+	is out of range. Takes constant time with the default ArrayList. With
+	List, peek walks to the id from the nearer end of the list, or from
+	where the last lookup stopped, so it takes time proportional to the
+	number of vertices; the id-based methods below all pay this.
+	*/
+	Vertex<T>* getVertexById(int id) {
+		if (id < 0 || id >= this->vertices->getSize()) {
+			return nullptr;
+		}
+		return this->vertices->peek(id);
+	}
+
+	/*
+	Returns the edge between the vertices with the specified ids, or the
+	null pointer if either id is out of range or there is no such edge.
+	*/
+	Edge<T, U>* findEdgeById(int fromId, int toId) {
+		Vertex<T>* from = this->getVertexById(fromId);
+		Vertex<T>* to = this->getVertexById(toId);
+		if (from == nullptr || to == nullptr) {
+			return nullptr;
+		}
+		return this->findEdge(from, to);
+	}
+
+	/*
+	Removes the item at the specified position of the specified list by
+	moving the last item into its place. With an ArrayList this takes
+	constant time; a List walks to the position from its nearest end.
+	*/
+	template <typename Item>
+	static void swapRemove(Container<Item>* list, int position) {
+		int last = list->getSize() - 1;
+		if (position != last) {
+			list->setData(list->peek(last), position);
+		}
+		list->removeFromEnd();
+	}
+
+	/*
+	Deletes the edges of this graph and, if this graph owns its contents, its
+	vertices and the data stored in its vertices and edges. Leaves both lists
+	empty.
+	*/
+	void destroyContents() {
+		for (Edge<T, U>* edge : *this->edges) {
+			if (this->ownsContents) {
+				delete edge->getData();
+			}
+			delete edge;
+		}
+		this->edges->clear();
+		this->edgeIndex->clear();
+		if (this->ownsContents) {
+			for (Vertex<T>* vertex : *this->vertices) {
+				delete vertex->getData();
+				delete vertex;
+			}
+		}
+		this->vertices->clear();
+	}
 
 public:
 
+	/*
+	One edge for addEdges: the vertices it goes from and to, its weight and
+	its data, e.g. {from, to, 1.0, nullptr}.
+	*/
+	struct EdgeRecord {
+		Vertex<T>* from;
+		Vertex<T>* to;
+		double weight;
+		U* data;
+	};
+
+	/*
+	The outgoing or incoming neighbours of a vertex, as a range that can be
+	used in a range-based for loop or indexed like an array. A range is a
+	small value that reads the vertex's adjacency in place through
+	Vertex::getOutVertex or getInVertex, so getting and walking one
+	allocates nothing. It reflects the vertex's degree when it was made, so
+	neighbours must not be added or removed while it is in use.
+	*/
+	class NeighborRange {
+
+	protected:
+
+		Vertex<T>* vertex;
+
+		bool outgoing;
+
+		int degree;
+
+	public:
+
+		class iterator {
+
+		protected:
+
+			Vertex<T>* vertex;
+
+			bool outgoing;
+
+			int position;
+
+		public:
+
+			iterator(Vertex<T>* vertex, bool outgoing, int position) {
+				this->vertex = vertex;
+				this->outgoing = outgoing;
+				this->position = position;
+			}
+
+			Vertex<T>* operator*() const {
+				return this->outgoing ? this->vertex->getOutVertex(this->position)
+					: this->vertex->getInVertex(this->position);
+			}
+
+			iterator& operator++() {
+				this->position++;
+				return *this;
+			}
+
+			bool operator==(const iterator& other) const {
+				return this->position == other.position;
+			}
+
+			bool operator!=(const iterator& other) const {
+				return this->position != other.position;
+			}
+		};
+
+		/*
+		Creates the range of the outgoing (or, if outgoing is false,
+		incoming) neighbours of the specified vertex. A null vertex gives the
+		empty range.
+		*/
+		NeighborRange(Vertex<T>* vertex, bool outgoing) {
+			this->vertex = vertex;
+			this->outgoing = outgoing;
+			if (vertex == nullptr) {
+				this->degree = 0;
+			}
+			else {
+				this->degree = outgoing ? vertex->getOutDegree() : vertex->getInDegree();
+			}
+		}
+
+		int size() const {
+			return this->degree;
+		}
+
+		bool empty() const {
+			return this->degree == 0;
+		}
+
+		/*
+		Returns the neighbour at the specified position, which must be less
+		than size().
+		*/
+		Vertex<T>* operator[](int position) const {
+			return *iterator(this->vertex, this->outgoing, position);
+		}
+
+		iterator begin() const {
+			return iterator(this->vertex, this->outgoing, 0);
+		}
+
+		iterator end() const {
+			return iterator(this->vertex, this->outgoing, this->degree);
+		}
+	};
+
 	/*
 	Creates an empty graph: no vertices (and therefore no edges)
 	*/
 	Graph() {
-		this->vertices = new List <Vertex<T>>();
-		this->edges = new List<Edge<T, U>>();
+		this->createContents();
+		this->ownsContents = false;
+	}
+
+	/*
+	Creates an empty graph. If ownsContents is true, the graph takes ownership
+	of every vertex added to it and of the data stored in its vertices and
+	edges.
+	*/
+	Graph(bool ownsContents) {
+		this->createContents();
+		this->ownsContents = ownsContents;
+	}
+
+	/*
+	Graphs can't be copied, since their vertices keep track of their own
+	neighbours; use std::move to hand a graph over instead.
+	*/
+	Graph(const Graph<T, U, Container>&) = delete;
+	Graph<T, U, Container>& operator=(const Graph<T, U, Container>&) = delete;
+
+	/*
+	Creates a graph by taking over the vertices and edges of the specified
+	graph, which is left empty. Runs in constant time.
+	*/
+	Graph(Graph<T, U, Container>&& other) {
+		this->vertices = other.vertices;
+		this->edges = other.edges;
+		this->edgeIndex = other.edgeIndex;
+		this->ownsContents = other.ownsContents;
+		other.createContents();
+	}
+
+	/*
+	Destroys the contents of this graph and takes over the vertices and edges
+	of the specified graph, which is left empty.
+	*/
+	Graph<T, U, Container>& operator=(Graph<T, U, Container>&& other) {
+		if (this != &other) {
+			this->destroyContents();
+			Container<Vertex<T>>* otherVertices = other.vertices;
+			Container<Edge<T, U>>* otherEdges = other.edges;
+			HashMap<Pair<Vertex<T>, Vertex<T>>, Edge<T, U>, VertexPairHash>* otherEdgeIndex = other.edgeIndex;
+			other.vertices = this->vertices;
+			other.edges = this->edges;
+			other.edgeIndex = this->edgeIndex;
+			this->vertices = otherVertices;
+			this->edges = otherEdges;
+			this->edgeIndex = otherEdgeIndex;
+			this->ownsContents = other.ownsContents;
+		}
+		return *this;
+	}
+
+	/*
+	Destroys this graph's edges and, if it owns its contents, its vertices and
+	the data stored in them.
+	*/
+	~Graph() {
+		this->destroyContents();
+		delete this->vertices;
+		delete this->edges;
+		delete this->edgeIndex;
+	}
+
+	/*
+	Returns true if and only if this graph owns its vertices and the data
+	stored in its vertices and edges.
+	*/
+	bool getOwnsContents() {
+		return this->ownsContents;
 	}
 
 	/*
@@ -115,7 +432,7 @@ public:
 	Returns true if and only if the specified vertex is part of this graph.
 	*/
 	bool hasVertex(Vertex<T>* vertex) {
-		return this->vertices->getIndex(vertex) >= 0;
+		return this->vertices->contains(vertex);
 	}
 
 	/*
@@ -127,13 +444,9 @@ public:
 	identical, a loop is added to that vertex.
 	*/
 	void addEdge(Vertex<T>* fromVertex, Vertex<T>* toVertex) {
-		// create an Edge from the specified vertices to see whether this edge
-		// is already part of the graph
-		Edge<T, U>* newEdge = new Edge<T, U>(fromVertex, toVertex);
-		// returns a negative number if newEdge is not part of this graph
-		int edgeNdx = this->edges->getIndex(newEdge);
 		// if this edge is already in the graph, do nothing. Otherwise:
-		if (edgeNdx < 0) {
+		if (!this->hasEdge(fromVertex, toVertex)) {
+			Edge<T, U>* newEdge = new Edge<T, U>(fromVertex, toVertex);
 			// need to handle a special case: if the from and to vertices
 			// are actually the same, then we're adding a edge from that
 			// vertex to itself. Otherwise, we're adding an edge between
@@ -150,10 +463,11 @@ public:
 				}
 				// add the new edge to this graph
 				this->edges->insertAtEnd(newEdge);
+				this->edgeIndex->insert(newEdge->getVertexPair(), newEdge);
 				// manage previousNodes and nextNodes. Since the edge goes
 				// from a vertex to itself, the vertex is both an incoming
 				// and outgoing vertex of itself.
-				fromVertex->addOutVertex(fromVertex);
+				newEdge->setOutPosition(fromVertex->addOutVertex(fromVertex));
 			}
 			else {
 				// get the indices for the from and to nodes. If getIndex returns
@@ -171,36 +485,221 @@ public:
 				}
 				// add the new edge to this graph
 				this->edges->insertAtEnd(newEdge);
+				this->edgeIndex->insert(newEdge->getVertexPair(), newEdge);
 				// manage previousNodes and nextNodes
-				fromVertex->addOutVertex(toVertex);
+				newEdge->setOutPosition(fromVertex->addOutVertex(toVertex));
 			}
 		}
 	}
 
 
 	/*
-	Returns true if and only if this graph contains an edge from the "from"
-	vertex to the "to" vertex.
+	Adds every vertex of the specified range (any container whose iterators
+	yield Vertex<T>*) that is not already part of this graph, in order.
+	Returns the number of vertices added. The range can be a temporary, such
+	as a vector returned by a function, or a braced list: addVertices({a, b}).
 	*/
-	// need to loosen up comparison 
+	template <typename VertexRange>
+	int addVertices(VertexRange&& vertexRange) {
+		int numAdded = 0;
+		for (Vertex<T>* vertex : vertexRange) {
+			if (!this->vertices->contains(vertex)) {
+				this->vertices->insertAtEnd(vertex);
+				numAdded++;
+			}
+		}
+		return numAdded;
+	}
 
-	bool hasEdge(Vertex<T>* from, Vertex<T>* to) {
-		bool result = false;
-		Edge<T, U>* e = new Edge<T, U>(from, to);
-		for (int k = 0; k < this->edges->getSize(); k++) {
-			Edge<T, U>* ek = this->edges->peek(k);
-			if (*e == *ek) {
-				result = true;
-				break;
+	int addVertices(std::initializer_list<Vertex<T>*> vertexList) {
+		return this->addVertices<std::initializer_list<Vertex<T>*>&>(vertexList);
+	}
+
+	/*
+	Adds the edges described by the specified range of EdgeRecords, in
+	order, with their weights and data, and returns the number of edges
+	added. As with addEdge, missing vertices are added, and a record is
+	skipped if its edge is already in this graph or earlier in the range;
+	the first record for an edge wins, and the caller stays responsible for
+	the data of skipped records.
+
+	Duplicates are found through the edge index, which is sized for the
+	whole range up front. When the range is larger than the current edge
+	set, the edge position index is switched off during the load and
+	rebuilt in one pass at the end.
+
+	As with addVertices, the range can be a temporary or a braced list of
+	records: addEdges({{a, b, 1.0, nullptr}, {b, c, 2.0, nullptr}}).
+	*/
+	template <typename EdgeRange>
+	int addEdges(EdgeRange&& edgeRange) {
+		int numRecords = (int)std::distance(std::begin(edgeRange), std::end(edgeRange));
+		this->edgeIndex->reserve(this->edges->getSize() + numRecords);
+		bool suspendIndex = numRecords > this->edges->getSize();
+		if (suspendIndex) {
+			this->edges->setIndexed(false);
+		}
+
+		int numAdded = 0;
+		// records usually come grouped by the vertex they leave from
+		Vertex<T>* knownFrom = nullptr;
+		for (const EdgeRecord& record : edgeRange) {
+			Pair<Vertex<T>, Vertex<T>> key(record.from, record.to);
+			if (this->edgeIndex->contains(key)) {
+				continue;
+			}
+			if (record.from != knownFrom && !this->vertices->contains(record.from)) {
+				this->vertices->insertAtEnd(record.from);
+			}
+			knownFrom = record.from;
+			if (record.to != record.from && !this->vertices->contains(record.to)) {
+				this->vertices->insertAtEnd(record.to);
 			}
+			Edge<T, U>* newEdge = new Edge<T, U>(record.from, record.to);
+			newEdge->setEdgeWeight(record.weight);
+			newEdge->setData(record.data);
+			this->edges->insertAtEnd(newEdge);
+			this->edgeIndex->insert(newEdge->getVertexPair(), newEdge);
+			newEdge->setOutPosition(record.from->addOutVertex(record.to));
+			numAdded++;
 		}
-		return result;
+
+		if (suspendIndex) {
+			this->edges->setIndexed(true);
+		}
+		return numAdded;
+	}
+
+	int addEdges(std::initializer_list<EdgeRecord> recordList) {
+		return this->addEdges<std::initializer_list<EdgeRecord>&>(recordList);
+	}
+
+	/*
+	Removes the edge from the "from" vertex to the "to" vertex from this
+	graph, and returns true, or returns false if there is no such edge. The
+	last edge takes the removed edge's index, and in the adjacency of both
+	vertices the last neighbour takes the removed one's place. If this graph
+	owns its contents, the edge's data is deleted. Takes constant expected
+	time with ArrayList; with List, reaching the edge's index is a walk
+	proportional to the number of edges.
+	*/
+	bool removeEdge(Vertex<T>* from, Vertex<T>* to) {
+		Edge<T, U>* edge = this->findEdge(from, to);
+		if (edge == nullptr) {
+			return false;
+		}
+		this->edgeIndex->remove(*edge->getVertexPair());
+		swapRemove(this->edges, this->edges->getIndex(edge));
+		int position = edge->getOutPosition();
+		from->removeOutVertexAt(position);
+		// the edge that was last in the out-list now has the removed one's place
+		if (position < from->getOutDegree()) {
+			this->findEdge(from, from->getOutVertex(position))->setOutPosition(position);
+		}
+		if (this->ownsContents) {
+			delete edge->getData();
+		}
+		delete edge;
+		return true;
+	}
+
+	/*
+	Removes the specified vertex and every edge into or out of it from this
+	graph, and returns true, or returns false if the vertex is not part of
+	this graph. The last vertex takes the removed vertex's index. If this
+	graph owns its contents, the vertex and its data are deleted along with
+	the data of its edges. Takes expected time proportional to the vertex's
+	degree with ArrayList; with List, each edge and the vertex also cost a
+	walk to their index.
+	*/
+	bool removeVertex(Vertex<T>* vertex) {
+		int position = this->vertices->getIndex(vertex);
+		if (position < 0) {
+			return false;
+		}
+		// from the last neighbour back, so removals don't shift the ones to come
+		for (int k = vertex->getOutDegree() - 1; k >= 0; k--) {
+			this->removeEdge(vertex, vertex->getOutVertex(k));
+		}
+		for (int k = vertex->getInDegree() - 1; k >= 0; k--) {
+			this->removeEdge(vertex->getInVertex(k), vertex);
+		}
+		swapRemove(this->vertices, position);
+		if (this->ownsContents) {
+			delete vertex->getData();
+			delete vertex;
+		}
+		return true;
+	}
+
+	/*
+	Returns true if and only if this graph contains an edge from the "from"
+	vertex to the "to" vertex, whatever its weight and data.
+	*/
+	bool hasEdge(Vertex<T>* from, Vertex<T>* to) {
+		return this->findEdge(from, to) != nullptr;
+	}
+
+	/*
+	Returns the outgoing neighbours of the specified vertex as a range that
+	allocates nothing (see NeighborRange). If the specified vertex is not
+	part of this graph, the range is empty.
+	*/
+	NeighborRange getOutgoingRange(Vertex<T>* vertex) {
+		return NeighborRange(this->hasVertex(vertex) ? vertex : nullptr, true);
+	}
+
+	/*
+	Returns the incoming neighbours of the specified vertex as a range that
+	allocates nothing (see NeighborRange). If the specified vertex is not
+	part of this graph, the range is empty.
+	*/
+	NeighborRange getIncomingRange(Vertex<T>* vertex) {
+		return NeighborRange(this->hasVertex(vertex) ? vertex : nullptr, false);
+	}
+
+	/*
+	Calls visit(neighbour) for each outgoing neighbour of the specified
+	vertex, in adjacency order, and returns the number of neighbours
+	visited, or a negative number if the vertex is not part of this graph.
+	visit can be any callable taking a Vertex<T>*; as a template argument it
+	can be inlined into the loop. The visitor must not add or remove edges
+	of the vertex.
+	*/
+	template <typename Visitor>
+	int forEachOutgoing(Vertex<T>* vertex, Visitor visit) {
+		if (!this->hasVertex(vertex)) {
+			return -1;
+		}
+		int outDegree = vertex->getOutDegree();
+		for (int k = 0; k < outDegree; k++) {
+			visit(vertex->getOutVertex(k));
+		}
+		return outDegree;
+	}
+
+	/*
+	Calls visit(neighbour) for each incoming neighbour of the specified
+	vertex, as forEachOutgoing does for outgoing ones.
+	*/
+	template <typename Visitor>
+	int forEachIncoming(Vertex<T>* vertex, Visitor visit) {
+		if (!this->hasVertex(vertex)) {
+			return -1;
+		}
+		int inDegree = vertex->getInDegree();
+		for (int k = 0; k < inDegree; k++) {
+			visit(vertex->getInVertex(k));
+		}
+		return inDegree;
 	}
 
 	/*
 	Returns a list of the outgoing vertices form the specified vertex. If the
-	specified vertex is not part o                                                                                                                                                           f this graph, this method returns the empty
-	list.
+	specified vertex is not part of this graph, this method returns the empty
+	list. The caller is responsible for deleting the returned list; code
+	that only walks the neighbours should use getOutgoingRange or
+	forEachOutgoing, which allocate nothing.
 	*/
 	List<Vertex<T>>* getOutgoingVertices(Vertex<T>* vertex) {
 		List<Vertex<T>>* result = new List <Vertex<T>>();
@@ -217,7 +716,8 @@ public:
 	/*
 	Returns a list of the incoming vertices form the specified vertex. If the
 	specified vertex is not part of this graph, this method returns the empty
-	list.
+	list. The caller is responsible for deleting the returned list; see
+	getIncomingRange and forEachIncoming.
 	*/
 	List<Vertex<T>>* getIncomingVertices(Vertex<T>* vertex) {
 		List<Vertex<T>>* result = new List <Vertex<T>>();
@@ -237,7 +737,7 @@ public:
 		Returns a pointer to a list containing pointers to all the vertices in
 		this graph.
 		 */
-	List<Vertex<T>>* getVertices() {
+	Container<Vertex<T>>* getVertices() {
 		return this->vertices;
 	}
 
@@ -245,7 +745,7 @@ public:
 	  Returns a pointer to a list containing pointers to all the edges in
 	  this graph.
 	   */
-	List<Edge<T, U>>* getEdges() {
+	Container<Edge<T, U>>* getEdges() {
 		return this->edges;
 	}
 
@@ -255,10 +755,10 @@ public:
 	  */
 	double getEdgeWeight(Vertex<T>* from, Vertex<T>* to) {
 		double result = std::nan("");
-		int ndx = this->getEdgeIndex(from, to);
-		if (ndx >= 0) {
-			// return the edge weight of the edge with index ndx
-			result = this->edges->peek(ndx)->getEdgeWeight();
+		Edge<T, U>* edge = this->findEdge(from, to);
+		if (edge != nullptr) {
+			// return the edge weight of the edge from "from" to "to"
+			result = edge->getEdgeWeight();
 			return result;
 		}
 		else {
@@ -292,10 +792,10 @@ public:
 	negative number.
 	*/
 	int setEdgeWeight(double weight, Vertex<T>* from, Vertex<T>* to) {
-		int ndx = this->getEdgeIndex(from, to);
-		if (ndx >= 0) {
+		Edge<T, U>* edge = this->findEdge(from, to);
+		if (edge != nullptr) {
 
-			this->edges->peek(ndx)->setEdgeWeight(weight);
+			edge->setEdgeWeight(weight);
 			return 0;
 		}
 		else {
@@ -398,9 +898,9 @@ public:
 	unsuccessful, this method returns a negative number.
 	*/
 	int storeInEdge(U* data, Vertex<T>* from, Vertex<T>* to) {
-		int ndx = getEdgeIndex(from, to);
-		if (ndx >= 0) {
-			this->edges->peek(ndx)->setData(data);
+		Edge<T, U>* edge = this->findEdge(from, to);
+		if (edge != nullptr) {
+			edge->setData(data);
 			return 0;
 		}
 		else {
@@ -433,9 +933,9 @@ public:
 	*/
 	U* getEdgeData(Vertex<T>* from, Vertex<T>* to) {
 		U* result = nullptr;
-		int ndx = getEdgeIndex(from, to);
-		if (ndx >= 0) {
-			result = this->edges->peek(ndx)->getData();
+		Edge<T, U>* edge = this->findEdge(from, to);
+		if (edge != nullptr) {
+			result = edge->getData();
 			return result;
 		}
 		else {
@@ -469,12 +969,7 @@ public:
 	vertex is not part of this graph, this method returns a negative number.
 	*/
 	int getVertexIndex(Vertex<T>* vertex) {
-		if (hasVertex(vertex) == true) {
-			return this->vertices->getIndex(vertex);
-		}
-		else {
-			return -1;
-		}
+		return this->vertices->getIndex(vertex);
 	}
 
 	/*
@@ -482,19 +977,151 @@ public:
 	edge is not part of this graph, this method returns a negative number.
 	*/
 	int getEdgeIndex(Vertex<T>* from, Vertex<T>* to) {
-		int ndx = -1;
-		for (int k = 0; k < this->edges->getSize(); k++) {
-			// peek at edgeK
-			Edge<T, U>* result = this->edges->peek(k);
-			// compare edgeK's initial vertex to "from" and its 
-			// terminal vertex to "to". If they are the same, return k
-			bool first = result->getInitialVertex() == from;
-			bool second = result->getTerminalVertex() == to;
-			if (first && second == true) {
-				return k;
-			}
+		Edge<T, U>* edge = this->findEdge(from, to);
+		if (edge == nullptr) {
+			return -1;
+		}
+		return this->edges->getIndex(edge);
+	}
+
+	/*
+	Returns the id of the specified vertex, or a negative number if the
+	vertex is not part of this graph. A vertex's id is its index in the
+	vertex list, so ids run from 0 to getNumVertices() - 1 with no gaps;
+	when a vertex is removed, the last vertex takes its id. Takes constant
+	expected time with either container, since the vertex list is indexed.
+	*/
+	int getVertexId(Vertex<T>* vertex) {
+		return this->vertices->getIndex(vertex);
+	}
+
+	/*
+	Adds an edge with the specified weight from the vertex with id fromId to
+	the vertex with id toId, and returns true. Returns false, and does
+	nothing, if either id is out of range or the edge already exists. Takes
+	constant expected time with ArrayList, and time proportional to the
+	number of vertices with List (see getVertexById).
+	*/
+	bool addEdge(int fromId, int toId, double weight = 1) {
+		Vertex<T>* from = this->getVertexById(fromId);
+		Vertex<T>* to = this->getVertexById(toId);
+		if (from == nullptr || to == nullptr || this->findEdge(from, to) != nullptr) {
+			return false;
+		}
+		this->addEdge(from, to);
+		this->findEdge(from, to)->setEdgeWeight(weight);
+		return true;
+	}
+
+	/*
+	Returns true if and only if there is an edge from the vertex with id
+	fromId to the vertex with id toId. Constant expected time with
+	ArrayList; O(number of vertices) with List.
+	*/
+	bool hasEdge(int fromId, int toId) {
+		return this->findEdgeById(fromId, toId) != nullptr;
+	}
+
+	/*
+	Removes the edge from the vertex with id fromId to the vertex with id
+	toId as removeEdge(Vertex<T>*, Vertex<T>*) does, and returns true, or
+	returns false if there is no such edge. With List, finding the two
+	vertices adds a walk proportional to the number of vertices.
+	*/
+	bool removeEdge(int fromId, int toId) {
+		Edge<T, U>* edge = this->findEdgeById(fromId, toId);
+		if (edge == nullptr) {
+			return false;
+		}
+		return this->removeEdge(edge->getInitialVertex(), edge->getTerminalVertex());
+	}
+
+	/*
+	Returns the weight of the edge from the vertex with id fromId to the
+	vertex with id toId, or NaN if there is no such edge. Constant expected
+	time with ArrayList; O(number of vertices) with List.
+	*/
+	double getEdgeWeight(int fromId, int toId) {
+		Edge<T, U>* edge = this->findEdgeById(fromId, toId);
+		if (edge == nullptr) {
+			return std::nan("");
+		}
+		return edge->getEdgeWeight();
+	}
+
+	/*
+	Sets the weight of the edge from the vertex with id fromId to the vertex
+	with id toId and returns 0, or returns a negative number if there is no
+	such edge. Constant expected time with ArrayList; O(number of vertices)
+	with List.
+	*/
+	int setEdgeWeight(double weight, int fromId, int toId) {
+		Edge<T, U>* edge = this->findEdgeById(fromId, toId);
+		if (edge == nullptr) {
+			return -1;
+		}
+		edge->setEdgeWeight(weight);
+		return 0;
+	}
+
+	/*
+	Returns the out-degree of the vertex with the specified id, or a
+	negative number if the id is out of range. Constant time with
+	ArrayList; O(number of vertices) with List.
+	*/
+	int getOutDegree(int id) {
+		Vertex<T>* vertex = this->getVertexById(id);
+		return vertex == nullptr ? -1 : vertex->getOutDegree();
+	}
+
+	/*
+	Returns the in-degree of the vertex with the specified id, or a negative
+	number if the id is out of range. Constant time with ArrayList;
+	O(number of vertices) with List.
+	*/
+	int getInDegree(int id) {
+		Vertex<T>* vertex = this->getVertexById(id);
+		return vertex == nullptr ? -1 : vertex->getInDegree();
+	}
+
+	/*
+	Returns an immutable compressed sparse row snapshot of this graph, with
+	dense vertex ids in the order of the vertex list (see FrozenGraph). Runs
+	in time proportional to the size of the graph. The caller is responsible
+	for deleting the snapshot, which must not outlive this graph's vertices.
+	*/
+	FrozenGraph<T, U>* freeze() {
+		return new FrozenGraph<T, U>(*this->vertices, *this->edges);
+	}
+
+	/*
+	Adds the memory held by this graph to the specified report, under the
+	specified name:
+	- name.object: the graph object itself;
+	- name.vertices and name.edges: the vertex and edge lists (see their
+	  reportMemory);
+	- name.vertex_objects: the Vertex objects, including their data
+	  pointers, whether or not this graph owns them;
+	- name.vertex_adjacency: the arrays of neighbour pointers the vertices
+	  keep, counted at their capacity (see Vertex::reportMemory), with one
+	  item per outgoing and per incoming neighbour;
+	- name.edge_objects: the Edge objects, each holding its vertex pair,
+	  weight and data pointer;
+	- name.edge_index: the index from vertex pairs to edges.
+	The data the vertices and edges point to is not counted.
+	*/
+	void reportMemory(MemoryReport* report, const std::string& name) {
+		report->add(name + ".object", 1, sizeof(*this));
+		this->vertices->reportMemory(report, name + ".vertices");
+		report->add(name + ".vertex_objects", this->vertices->getSize(), this->vertices->getSize() * sizeof(Vertex<T>));
+		std::string adjacencyName = name + ".vertex_adjacency";
+		report->add(adjacencyName, 0, 0);
+		for (Vertex<T>* vertex : *this->vertices) {
+			vertex->reportMemory(report, adjacencyName);
 		}
-		return -1;
+		this->edges->reportMemory(report, name + ".edges");
+		report->add(name + ".edge_objects", this->edges->getSize(), this->edges->getSize() * sizeof(Edge<T, U>));
+		this->edgeIndex->reportMemory(report, name + ".edge_index");
 	}
 
 	/*
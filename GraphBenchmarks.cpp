@@ -0,0 +1 @@
+#include "GraphBenchmarks.h"
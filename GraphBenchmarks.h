@@ -0,0 +1,1163 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "CompactGraph.h"
+#include "Graph.h"
+#include "GraphSearch.h"
+#include "MemoryReport.h"
+#include "MemoryUsage.h"
+#include "ParallelBfs.h"
+#include "PathFinder.h"
+#include "StrongComponents.h"
+#include "WorldImage.h"
+#include "WorldLoader.h"
+
+/*
+ Timing runs for Graph. Each benchmark returns a human-readable report; none
+ of them assert anything.
+ */
+class GraphBenchmarks {
+
+protected:
+
+    typedef std::chrono::steady_clock Clock;
+
+    /*
+     Returns the number of milliseconds elapsed since the specified time.
+     */
+    static double millisecondsSince(Clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    /*
+     Adds the specified vertices to the specified graph one at a time and
+     then checks that each one is present. Returns the elapsed time in
+     milliseconds.
+     */
+    static double loadVertices(Graph<int, int>* g, Vertex<int>** rooms, int numRooms) {
+        Clock::time_point start = Clock::now();
+        for (int k = 0; k < numRooms; k++) {
+            g->addVertex(rooms[k]);
+        }
+        int found = 0;
+        for (int k = 0; k < numRooms; k++) {
+            if (g->hasVertex(rooms[k])) {
+                found++;
+            }
+        }
+        double elapsed = millisecondsSince(start);
+        return found == numRooms ? elapsed : -1;
+    }
+
+    /*
+     Finds the weight of the edge from the "from" vertex to the "to" vertex
+     by scanning the edge list, the way getEdgeWeight did before graphs had
+     an edge index. Returns NaN if there is no such edge.
+     */
+    static double scanForEdgeWeight(Graph<int, int>* g, Vertex<int>* from, Vertex<int>* to) {
+        for (Edge<int, int>* edge : *g->getEdges()) {
+            if (edge->getInitialVertex() == from && edge->getTerminalVertex() == to) {
+                return edge->getEdgeWeight();
+            }
+        }
+        return std::nan("");
+    }
+
+    /*
+     Builds a graph with the specified numbers of vertices and random edges,
+     filling the specified vector with its vertices. The caller is
+     responsible for deleting the graph, which owns its vertices.
+     */
+    static Graph<int, int>* buildRandomGraph(int numVertices, int numEdges, std::vector<Vertex<int>*>& rooms) {
+        Graph<int, int>* g = new Graph<int, int>(true);
+        rooms.resize(numVertices);
+        for (int k = 0; k < numVertices; k++) {
+            rooms[k] = new Vertex<int>();
+            g->addVertex(rooms[k]);
+        }
+        unsigned int seed = 41;
+        while (g->getNumEdges() < numEdges) {
+            seed = seed * 1103515245 + 12345;
+            int from = (int)((seed >> 4) % numVertices);
+            seed = seed * 1103515245 + 12345;
+            int to = (int)((seed >> 4) % numVertices);
+            g->addEdge(rooms[from], rooms[to]);
+        }
+        return g;
+    }
+
+    /*
+     Runs the specified number of random (from, to) weight queries, half of
+     them on existing edges, either through getEdgeWeight or by scanning.
+     Returns the elapsed time in milliseconds and adds the number of edges
+     found to the specified count.
+     */
+    static double timeEdgeQueries(Graph<int, int>* g, std::vector<Vertex<int>*>& rooms, int numQueries,
+        bool scan, long long& found) {
+        std::vector<Edge<int, int>*> edgeList;
+        for (Edge<int, int>* edge : *g->getEdges()) {
+            edgeList.push_back(edge);
+        }
+        unsigned int seed = 77;
+        Clock::time_point start = Clock::now();
+        for (int k = 0; k < numQueries; k++) {
+            seed = seed * 1103515245 + 12345;
+            Vertex<int>* from;
+            Vertex<int>* to;
+            if (k % 2 == 0) {
+                Edge<int, int>* edge = edgeList[(seed >> 4) % edgeList.size()];
+                from = edge->getInitialVertex();
+                to = edge->getTerminalVertex();
+            }
+            else {
+                from = rooms[(seed >> 4) % rooms.size()];
+                to = rooms[(seed >> 12) % rooms.size()];
+            }
+            double weight = scan ? scanForEdgeWeight(g, from, to) : g->getEdgeWeight(from, to);
+            if (!std::isnan(weight)) {
+                found++;
+            }
+        }
+        return millisecondsSince(start);
+    }
+
+public:
+
+    /*
+     Loads 100k vertices into a graph with its vertex index, and a smaller
+     graph with the index turned off for comparison.
+     */
+    static std::string benchmarkVertexLoad() {
+        std::ostringstream sout;
+        sout << "GraphBenchmarks::benchmarkVertexLoad" << std::endl;
+        const int numRooms = 100000;
+        const int numUnindexedRooms = 20000;
+
+        Vertex<int>** rooms = new Vertex<int>*[numRooms];
+        for (int k = 0; k < numRooms; k++) {
+            rooms[k] = new Vertex<int>();
+        }
+
+        Graph<int, int>* indexed = new Graph<int, int>();
+        double indexedTime = loadVertices(indexed, rooms, numRooms);
+        delete indexed;
+
+        Graph<int, int>* unindexed = new Graph<int, int>();
+        unindexed->getVertices()->setIndexed(false);
+        double unindexedTime = loadVertices(unindexed, rooms, numUnindexedRooms);
+        delete unindexed;
+
+        for (int k = 0; k < numRooms; k++) {
+            delete rooms[k];
+        }
+        delete[] rooms;
+
+        sout << "indexed, " << numRooms << " vertices: " << indexedTime << " ms" << std::endl;
+        sout << "unindexed, " << numUnindexedRooms << " vertices: " << unindexedTime << " ms" << std::endl;
+        return sout.str();
+    }
+
+    /*
+     Times (from, to) edge weight queries through the edge index on graphs of
+     increasing size, up to a million edges, and the old scan of the edge
+     list on the smaller graphs. The indexed time per query should stay flat
+     while the scan grows with the number of edges.
+     */
+    static std::string benchmarkEdgeQueries() {
+        std::ostringstream sout;
+        sout << "GraphBenchmarks::benchmarkEdgeQueries" << std::endl;
+        const int numQueries = 200000;
+        const int numScanQueries = 200;
+
+        for (int numEdges = 10000; numEdges <= 1000000; numEdges *= 10) {
+            std::vector<Vertex<int>*> rooms;
+            Clock::time_point start = Clock::now();
+            Graph<int, int>* g = buildRandomGraph(numEdges / 4, numEdges, rooms);
+            double buildTime = millisecondsSince(start);
+            long long found = 0;
+            double indexedTime = timeEdgeQueries(g, rooms, numQueries, false, found);
+            sout << numEdges << " edges: built in " << buildTime << " ms, " << numQueries
+                << " indexed queries " << indexedTime << " ms";
+            if (numEdges <= 100000) {
+                double scanTime = timeEdgeQueries(g, rooms, numScanQueries, true, found);
+                sout << ", " << numScanQueries << " scanned queries " << scanTime << " ms";
+            }
+            sout << " (" << found << " found)" << std::endl;
+            delete g;
+        }
+        return sout.str();
+    }
+
+    /*
+     Runs a breadth-first search from the specified vertex through the
+     graph's own vertices, using the vertex index to mark visited vertices.
+     Returns the number of vertices reached.
+     */
+    static int bfsOnGraph(Graph<int, int>* g, Vertex<int>* source) {
+        std::vector<char> visited(g->getNumVertices(), 0);
+        std::vector<Vertex<int>*> queue;
+        queue.push_back(source);
+        visited[g->getVertexIndex(source)] = 1;
+        for (size_t head = 0; head < queue.size(); head++) {
+            Vertex<int>* vertex = queue[head];
+            int outDegree = vertex->getOutDegree();
+            for (int k = 0; k < outDegree; k++) {
+                Vertex<int>* neighbor = vertex->getOutVertex(k);
+                int index = g->getVertexIndex(neighbor);
+                if (!visited[index]) {
+                    visited[index] = 1;
+                    queue.push_back(neighbor);
+                }
+            }
+        }
+        return (int)queue.size();
+    }
+
+    /*
+     Runs a breadth-first search from the vertex with the specified id
+     through the arrays of a frozen graph. Returns the number of vertices
+     reached.
+     */
+    static int bfsOnFrozen(FrozenGraph<int, int>* frozen, int source) {
+        std::vector<char> visited(frozen->getNumVertices(), 0);
+        std::vector<int> queue;
+        queue.reserve(frozen->getNumVertices());
+        queue.push_back(source);
+        visited[source] = 1;
+        for (size_t head = 0; head < queue.size(); head++) {
+            int id = queue[head];
+            const int* neighbors = frozen->getNeighbors(id);
+            int outDegree = frozen->getOutDegree(id);
+            for (int k = 0; k < outDegree; k++) {
+                if (!visited[neighbors[k]]) {
+                    visited[neighbors[k]] = 1;
+                    queue.push_back(neighbors[k]);
+                }
+            }
+        }
+        return (int)queue.size();
+    }
+
+    /*
+     Times a breadth-first search over a random graph with the specified
+     numbers of vertices and edges, once through the Graph and once through
+     its frozen snapshot, and reports how long freezing took.
+     */
+    static std::string benchmarkFrozenBfs(int numVertices, int numEdges) {
+        std::ostringstream sout;
+        std::vector<Vertex<int>*> rooms;
+        Graph<int, int>* g = buildRandomGraph(numVertices, numEdges, rooms);
+
+        Clock::time_point start = Clock::now();
+        FrozenGraph<int, int>* frozen = g->freeze();
+        double freezeTime = millisecondsSince(start);
+
+        start = Clock::now();
+        int reachedOnGraph = bfsOnGraph(g, rooms[0]);
+        double graphTime = millisecondsSince(start);
+
+        start = Clock::now();
+        int reachedOnFrozen = bfsOnFrozen(frozen, frozen->getVertexId(rooms[0]));
+        double frozenTime = millisecondsSince(start);
+
+        delete frozen;
+        delete g;
+        sout << numEdges << " edges: freeze " << freezeTime << " ms, BFS on Graph " << graphTime
+            << " ms, BFS on FrozenGraph " << frozenTime << " ms, " << graphTime / frozenTime << "x"
+            << (reachedOnGraph == reachedOnFrozen ? "" : " (MISMATCH)") << std::endl;
+        return sout.str();
+    }
+
+    /*
+     Compares breadth-first search on Graph and on FrozenGraph at 1M and 10M
+     edges.
+     */
+    static std::string benchmarkFrozenGraph() {
+        std::ostringstream sout;
+        sout << "GraphBenchmarks::benchmarkFrozenGraph" << std::endl;
+        sout << benchmarkFrozenBfs(100000, 1000000);
+        sout << benchmarkFrozenBfs(1000000, 10000000);
+        return sout.str();
+    }
+
+    /*
+     Loads a random graph with the specified numbers of vertices and edge
+     records (a few of them duplicates) through addEdges, and, if asked,
+     the same records one addEdge and setEdgeWeight call at a time.
+     */
+    static std::string benchmarkBulkLoad(int numVertices, int numRecords, bool oneAtATime) {
+        std::ostringstream sout;
+        std::vector<Vertex<int>*> rooms(numVertices);
+        for (int k = 0; k < numVertices; k++) {
+            rooms[k] = new Vertex<int>();
+        }
+        std::vector<Graph<int, int>::EdgeRecord> records(numRecords);
+        unsigned int seed = 53;
+        for (int k = 0; k < numRecords; k++) {
+            seed = seed * 1103515245 + 12345;
+            int from = (int)((seed >> 4) % numVertices);
+            seed = seed * 1103515245 + 12345;
+            int to = (int)((seed >> 4) % numVertices);
+            records[k] = { rooms[from], rooms[to], (double)(k % 100), nullptr };
+        }
+
+        Clock::time_point start = Clock::now();
+        Graph<int, int>* bulk = new Graph<int, int>();
+        bulk->addVertices(rooms);
+        int numAdded = bulk->addEdges(records);
+        double bulkTime = millisecondsSince(start);
+        int numBulkEdges = bulk->getNumEdges();
+        delete bulk;
+        sout << numRecords << " records: addEdges " << bulkTime << " ms (" << numAdded << " edges)";
+
+        if (oneAtATime) {
+            for (int k = 0; k < numVertices; k++) {
+                delete rooms[k];
+                rooms[k] = new Vertex<int>();
+            }
+            seed = 53;
+            for (int k = 0; k < numRecords; k++) {
+                seed = seed * 1103515245 + 12345;
+                records[k].from = rooms[(seed >> 4) % numVertices];
+                seed = seed * 1103515245 + 12345;
+                records[k].to = rooms[(seed >> 4) % numVertices];
+            }
+            start = Clock::now();
+            Graph<int, int>* single = new Graph<int, int>();
+            for (Vertex<int>* room : rooms) {
+                single->addVertex(room);
+            }
+            for (Graph<int, int>::EdgeRecord& record : records) {
+                if (!single->hasEdge(record.from, record.to)) {
+                    single->addEdge(record.from, record.to);
+                    single->setEdgeWeight(record.weight, record.from, record.to);
+                }
+            }
+            double singleTime = millisecondsSince(start);
+            sout << ", addEdge " << singleTime << " ms"
+                << (single->getNumEdges() == numBulkEdges ? "" : " (MISMATCH)");
+            delete single;
+        }
+        sout << std::endl;
+
+        for (Vertex<int>* room : rooms) {
+            delete room;
+        }
+        return sout.str();
+    }
+
+    /*
+     Compares addEdges with one addEdge call per edge at 1M edges, and loads
+     10M edges through addEdges.
+     */
+    static std::string benchmarkBulkLoads() {
+        std::ostringstream sout;
+        sout << "GraphBenchmarks::benchmarkBulkLoads" << std::endl;
+        sout << benchmarkBulkLoad(100000, 1000000, true);
+        sout << benchmarkBulkLoad(1000000, 10000000, false);
+        return sout.str();
+    }
+
+    /*
+     A breadth-first search that gets each vertex's neighbours from
+     getOutgoingVertices and tracks visited vertices in a fresh list, the
+     way callers searched graphs before GraphSearch. Returns the number of
+     vertices reached within maxDepth edges.
+     */
+    static int listBreadthFirst(Graph<int, int>* g, Vertex<int>* source, int maxDepth) {
+        List<Vertex<int>>* visited = new List<Vertex<int>>();
+        visited->setIndexed(true);
+        List<Vertex<int>>* frontier = new List<Vertex<int>>();
+        visited->insertAtEnd(source);
+        frontier->insertAtEnd(source);
+        for (int depth = 0; depth < maxDepth && !frontier->isEmpty(); depth++) {
+            List<Vertex<int>>* nextFrontier = new List<Vertex<int>>();
+            for (Vertex<int>* vertex : *frontier) {
+                List<Vertex<int>>* outgoing = g->getOutgoingVertices(vertex);
+                for (Vertex<int>* neighbor : *outgoing) {
+                    if (!visited->contains(neighbor)) {
+                        visited->insertAtEnd(neighbor);
+                        nextFrontier->insertAtEnd(neighbor);
+                    }
+                }
+                delete outgoing;
+            }
+            delete frontier;
+            frontier = nextFrontier;
+        }
+        int result = visited->getSize();
+        delete frontier;
+        delete visited;
+        return result;
+    }
+
+    /*
+     Runs the specified number of breadth-first searches of at most maxDepth
+     edges from random vertices, with listBreadthFirst and with one reused
+     GraphSearch, and reports the searches per second of each.
+     */
+    static std::string timeSearches(Graph<int, int>* g, std::vector<Vertex<int>*>& rooms, int numSearches,
+        int maxDepth) {
+        std::ostringstream sout;
+        std::vector<Vertex<int>*> sources(numSearches);
+        unsigned int seed = 59;
+        for (int k = 0; k < numSearches; k++) {
+            seed = seed * 1103515245 + 12345;
+            sources[k] = rooms[(seed >> 4) % rooms.size()];
+        }
+        long long listReached = 0;
+        Clock::time_point start = Clock::now();
+        for (Vertex<int>* source : sources) {
+            listReached += listBreadthFirst(g, source, maxDepth < 0 ? g->getNumVertices() : maxDepth);
+        }
+        double listTime = millisecondsSince(start);
+
+        GraphSearch<int, int> search(g);
+        long long searchReached = 0;
+        start = Clock::now();
+        for (Vertex<int>* source : sources) {
+            searchReached += search.breadthFirst(source, [](Vertex<int>*, int) { return true; }, maxDepth);
+        }
+        double searchTime = millisecondsSince(start);
+
+        sout << numSearches << " searches, depth " << maxDepth << ": lists "
+            << numSearches * 1000.0 / listTime << "/s, GraphSearch " << numSearches * 1000.0 / searchTime
+            << "/s, " << listTime / searchTime << "x"
+            << (listReached == searchReached ? "" : " (MISMATCH)") << std::endl;
+        return sout.str();
+    }
+
+    /*
+     Compares GraphSearch with list-based searching on a random graph of
+     100k rooms, for whole-graph searches and for short room-discovery ones.
+     */
+    static std::string benchmarkGraphSearch() {
+        std::ostringstream sout;
+        sout << "GraphBenchmarks::benchmarkGraphSearch" << std::endl;
+        std::vector<Vertex<int>*> rooms;
+        Graph<int, int>* g = buildRandomGraph(100000, 400000, rooms);
+        sout << timeSearches(g, rooms, 5, -1);
+        sout << timeSearches(g, rooms, 20000, 2);
+        delete g;
+        return sout.str();
+    }
+
+    /*
+     Builds a side-by-side grid of rooms, each joined both ways to the rooms
+     north, south, east and west of it by corridors of length 1 to 9. Each
+     room stores its position in rooms, which is row * side + column.
+     */
+    static Graph<int, int>* buildGridGraph(int side, std::vector<Vertex<int>*>& rooms) {
+        Graph<int, int>* g = new Graph<int, int>(true);
+        rooms.resize(side * side);
+        for (int k = 0; k < side * side; k++) {
+            rooms[k] = new Vertex<int>();
+            rooms[k]->setData(new int(k));
+        }
+        std::vector<Graph<int, int>::EdgeRecord> records;
+        records.reserve(4 * side * side);
+        unsigned int seed = 71;
+        for (int row = 0; row < side; row++) {
+            for (int column = 0; column < side; column++) {
+                Vertex<int>* room = rooms[row * side + column];
+                int neighbors[2] = { column + 1 < side ? row * side + column + 1 : -1,
+                    row + 1 < side ? (row + 1) * side + column : -1 };
+                for (int neighbor : neighbors) {
+                    if (neighbor >= 0) {
+                        seed = seed * 1103515245 + 12345;
+                        double length = 1 + (seed >> 8) % 9;
+                        records.push_back({ room, rooms[neighbor], length, nullptr });
+                        records.push_back({ rooms[neighbor], room, length, nullptr });
+                    }
+                }
+            }
+        }
+        g->addVertices(rooms);
+        g->addEdges(records);
+        return g;
+    }
+
+    /*
+     Builds a graph of randomly joined rooms, numEdges of them, with edge
+     weights from 1 to 9.
+     */
+    static Graph<int, int>* buildWeightedRandomGraph(int numVertices, int numEdges, std::vector<Vertex<int>*>& rooms) {
+        Graph<int, int>* g = new Graph<int, int>(true);
+        rooms.resize(numVertices);
+        for (int k = 0; k < numVertices; k++) {
+            rooms[k] = new Vertex<int>();
+        }
+        std::vector<Graph<int, int>::EdgeRecord> records(numEdges);
+        unsigned int seed = 73;
+        for (int k = 0; k < numEdges; k++) {
+            seed = seed * 1103515245 + 12345;
+            int from = (int)((seed >> 4) % numVertices);
+            seed = seed * 1103515245 + 12345;
+            int to = (int)((seed >> 4) % numVertices);
+            records[k] = { rooms[from], rooms[to], (double)(1 + (seed >> 8) % 9), nullptr };
+        }
+        g->addVertices(rooms);
+        g->addEdges(records);
+        return g;
+    }
+
+    /*
+     Runs a path query from each source to the matching target with one
+     reused PathFinder, by Dijkstra's algorithm or, if side is positive, by
+     A* with the grid distance as the heuristic. Returns the queries per
+     second, and adds the total path length to totalLength.
+     */
+    static double timePathQueries(PathFinder<int, int>& paths, std::vector<Vertex<int>*>& sources,
+        std::vector<Vertex<int>*>& targets, int side, double& totalLength) {
+        Clock::time_point start = Clock::now();
+        for (size_t k = 0; k < sources.size(); k++) {
+            double length;
+            if (side > 0) {
+                int target = *targets[k]->getData();
+                length = paths.findPath(sources[k], targets[k], [side, target](Vertex<int>* room) {
+                    int position = *room->getData();
+                    return (double)(std::abs(position / side - target / side) + std::abs(position % side - target % side));
+                });
+            }
+            else {
+                length = paths.findPath(sources[k], targets[k]);
+            }
+            if (!std::isnan(length)) {
+                totalLength += length;
+            }
+        }
+        return sources.size() * 1000.0 / millisecondsSince(start);
+    }
+
+    /*
+     Reports path queries per second on a grid of side * side rooms, between
+     random rooms and between rooms at most 10 apart in each direction, the
+     way an NPC looks for a nearby target.
+     */
+    static std::string benchmarkGridPaths(int side, int numQueries) {
+        std::ostringstream sout;
+        std::vector<Vertex<int>*> rooms;
+        Graph<int, int>* g = buildGridGraph(side, rooms);
+        PathFinder<int, int> paths(g);
+        std::vector<Vertex<int>*> sources(numQueries);
+        std::vector<Vertex<int>*> targets(numQueries);
+        std::vector<Vertex<int>*> nearTargets(numQueries * 100);
+        std::vector<Vertex<int>*> nearSources(numQueries * 100);
+        unsigned int seed = 79;
+        for (int k = 0; k < numQueries * 100; k++) {
+            seed = seed * 1103515245 + 12345;
+            int row = (seed >> 4) % side;
+            seed = seed * 1103515245 + 12345;
+            int column = (seed >> 4) % side;
+            seed = seed * 1103515245 + 12345;
+            int nearRow = std::min(side - 1, std::max(0, row + (int)((seed >> 4) % 21) - 10));
+            int nearColumn = std::min(side - 1, std::max(0, column + (int)((seed >> 12) % 21) - 10));
+            nearSources[k] = rooms[row * side + column];
+            nearTargets[k] = rooms[nearRow * side + nearColumn];
+            if (k < numQueries) {
+                sources[k] = rooms[row * side + column];
+                seed = seed * 1103515245 + 12345;
+                targets[k] = rooms[(seed >> 4) % rooms.size()];
+            }
+        }
+        double dijkstraLength = 0;
+        double aStarLength = 0;
+        double dijkstraRate = timePathQueries(paths, sources, targets, 0, dijkstraLength);
+        double aStarRate = timePathQueries(paths, sources, targets, side, aStarLength);
+        double nearLength = 0;
+        double nearAStarLength = 0;
+        double nearRate = timePathQueries(paths, nearSources, nearTargets, 0, nearLength);
+        double nearAStarRate = timePathQueries(paths, nearSources, nearTargets, side, nearAStarLength);
+        sout << side * side << "-room grid: Dijkstra " << dijkstraRate << "/s, A* " << aStarRate
+            << "/s; within 10 rooms: Dijkstra " << nearRate << "/s, A* " << nearAStarRate << "/s"
+            << (dijkstraLength == aStarLength && nearLength == nearAStarLength ? "" : " (MISMATCH)") << std::endl;
+        delete g;
+        return sout.str();
+    }
+
+    /*
+     Reports Dijkstra queries per second between random rooms of a random
+     graph with four edges per room.
+     */
+    static std::string benchmarkRandomPaths(int numVertices, int numQueries) {
+        std::ostringstream sout;
+        std::vector<Vertex<int>*> rooms;
+        Graph<int, int>* g = buildWeightedRandomGraph(numVertices, 4 * numVertices, rooms);
+        PathFinder<int, int> paths(g);
+        std::vector<Vertex<int>*> sources(numQueries);
+        std::vector<Vertex<int>*> targets(numQueries);
+        unsigned int seed = 83;
+        for (int k = 0; k < numQueries; k++) {
+            seed = seed * 1103515245 + 12345;
+            sources[k] = rooms[(seed >> 4) % numVertices];
+            seed = seed * 1103515245 + 12345;
+            targets[k] = rooms[(seed >> 4) % numVertices];
+        }
+        double totalLength = 0;
+        double rate = timePathQueries(paths, sources, targets, 0, totalLength);
+        sout << numVertices << "-room random graph: Dijkstra " << rate << "/s" << std::endl;
+        delete g;
+        return sout.str();
+    }
+
+    /*
+     Path query rates on grids and random graphs of 10k to 1M rooms.
+     */
+    static std::string benchmarkPathFinder() {
+        std::ostringstream sout;
+        sout << "GraphBenchmarks::benchmarkPathFinder" << std::endl;
+        sout << benchmarkGridPaths(100, 200);
+        sout << benchmarkGridPaths(316, 20);
+        sout << benchmarkGridPaths(1000, 5);
+        sout << benchmarkRandomPaths(10000, 200);
+        sout << benchmarkRandomPaths(100000, 20);
+        sout << benchmarkRandomPaths(1000000, 3);
+        return sout.str();
+    }
+
+    /*
+     Times ParallelBfs on a random graph with the specified numbers of rooms
+     and edges, top-down only and direction-optimizing, from one thread up
+     to one per hardware thread, against the single-threaded bfsOnFrozen.
+     */
+    static std::string benchmarkParallelBfs(int numVertices, int numEdges) {
+        std::ostringstream sout;
+        std::vector<Vertex<int>*> rooms;
+        Graph<int, int>* g = buildWeightedRandomGraph(numVertices, numEdges, rooms);
+        FrozenGraph<int, int>* frozen = g->freeze();
+        int source = frozen->getVertexId(rooms[0]);
+
+        Clock::time_point start = Clock::now();
+        int expected = bfsOnFrozen(frozen, source);
+        double serialTime = millisecondsSince(start);
+        sout << numVertices << " rooms, " << numEdges << " edges: bfsOnFrozen " << serialTime << " ms" << std::endl;
+
+        ParallelBfs<int, int> bfs(frozen);
+        int maxThreads = std::max(1, (int)std::thread::hardware_concurrency());
+        std::vector<int> threadCounts;
+        for (int numThreads = 1; numThreads < maxThreads; numThreads *= 2) {
+            threadCounts.push_back(numThreads);
+        }
+        threadCounts.push_back(maxThreads);
+        for (int numThreads : threadCounts) {
+            bfs.setNumThreads(numThreads);
+            double times[2];
+            bool mismatch = false;
+            for (int optimizing = 0; optimizing < 2; optimizing++) {
+                bfs.setDirectionOptimizing(optimizing == 1);
+                start = Clock::now();
+                mismatch = mismatch || bfs.run(source) != expected;
+                times[optimizing] = millisecondsSince(start);
+            }
+            sout << "  " << numThreads << " threads: top-down " << times[0] << " ms, direction-optimizing "
+                << times[1] << " ms (" << bfs.getNumBottomUpLevels() << " of "
+                << bfs.getNumBottomUpLevels() + bfs.getNumTopDownLevels() << " levels bottom-up), "
+                << serialTime / times[1] << "x" << (mismatch ? " (MISMATCH)" : "") << std::endl;
+        }
+        delete frozen;
+        delete g;
+        return sout.str();
+    }
+
+    static std::string benchmarkParallelBfs() {
+        std::ostringstream sout;
+        sout << "GraphBenchmarks::benchmarkParallelBfs" << std::endl;
+        sout << benchmarkParallelBfs(1000000, 8000000);
+        return sout.str();
+    }
+
+    /*
+     Times StrongComponents::compute on a random graph, then adds edges
+     between random rooms one at a time through the incremental addEdge.
+     */
+    static std::string benchmarkStrongComponents(int numVertices, int numEdges, int numAdded) {
+        std::ostringstream sout;
+        std::vector<Vertex<int>*> rooms;
+        Graph<int, int>* g = buildWeightedRandomGraph(numVertices, numEdges, rooms);
+        StrongComponents<int, int> components(g);
+        Clock::time_point start = Clock::now();
+        int numComponents = components.compute();
+        double computeTime = millisecondsSince(start);
+        int largest = 0;
+        for (int c = 0; c < numComponents; c++) {
+            largest = std::max(largest, components.getComponentSize(c));
+        }
+
+        unsigned int seed = 101;
+        int numMerged = 0;
+        start = Clock::now();
+        for (int k = 0; k < numAdded; k++) {
+            seed = seed * 1103515245 + 12345;
+            int from = (int)((seed >> 4) % numVertices);
+            seed = seed * 1103515245 + 12345;
+            int to = (int)((seed >> 4) % numVertices);
+            numMerged += components.addEdge(rooms[from], rooms[to]);
+        }
+        double addTime = millisecondsSince(start);
+        sout << numVertices << " rooms, " << numEdges << " edges: compute " << computeTime << " ms ("
+            << numComponents << " components, largest " << largest << "); " << numAdded << " addEdge calls "
+            << addTime << " ms, " << addTime * 1000 / numAdded << " us each (" << numMerged
+            << " components merged, " << components.getNumComponents() << " left)" << std::endl;
+        delete g;
+        return sout.str();
+    }
+
+    static std::string benchmarkStrongComponents() {
+        std::ostringstream sout;
+        sout << "GraphBenchmarks::benchmarkStrongComponents" << std::endl;
+        sout << benchmarkStrongComponents(100000, 100000, 10000);
+        sout << benchmarkStrongComponents(1000000, 1000000, 10000);
+        sout << benchmarkStrongComponents(1000000, 4000000, 10000);
+        return sout.str();
+    }
+
+    /*
+     Builds a random graph on the specified container, then times removing
+     random edges one at a time and then random vertices with all their
+     edges.
+     */
+    template <template <typename> class Container>
+    static std::string timeRemovals(const char* containerName, int numVertices, int numEdges, int numRemovals) {
+        std::ostringstream sout;
+        Graph<int, int, Container>* g = new Graph<int, int, Container>(true);
+        std::vector<Vertex<int>*> rooms(numVertices);
+        for (int k = 0; k < numVertices; k++) {
+            rooms[k] = new Vertex<int>();
+        }
+        std::vector<typename Graph<int, int, Container>::EdgeRecord> records(numEdges);
+        unsigned int seed = 107;
+        for (int k = 0; k < numEdges; k++) {
+            seed = seed * 1103515245 + 12345;
+            int from = (int)((seed >> 4) % numVertices);
+            seed = seed * 1103515245 + 12345;
+            int to = (int)((seed >> 4) % numVertices);
+            records[k] = { rooms[from], rooms[to], 1.0, nullptr };
+        }
+        g->addVertices(rooms);
+        g->addEdges(records);
+
+        Clock::time_point start = Clock::now();
+        int numRemoved = 0;
+        for (int k = 0; k < numRemovals; k++) {
+            seed = seed * 1103515245 + 12345;
+            typename Graph<int, int, Container>::EdgeRecord& record = records[(seed >> 4) % numEdges];
+            numRemoved += g->removeEdge(record.from, record.to) ? 1 : 0;
+        }
+        double edgeTime = millisecondsSince(start);
+
+        // vertices are removed from the end of rooms, so none is removed twice
+        start = Clock::now();
+        for (int k = 0; k < numRemovals / 10; k++) {
+            seed = seed * 1103515245 + 12345;
+            int index = (int)((seed >> 4) % rooms.size());
+            g->removeVertex(rooms[index]);
+            rooms[index] = rooms.back();
+            rooms.pop_back();
+        }
+        double vertexTime = millisecondsSince(start);
+        sout << containerName << ": removeEdge " << edgeTime * 1000 / numRemovals << " us, removeVertex "
+            << vertexTime * 10000 / numRemovals << " us (" << numRemoved << " edges removed)" << std::endl;
+        delete g;
+        return sout.str();
+    }
+
+    /*
+     Builds a hub joined both ways to the specified number of rooms, then
+     times removing every room, in a scattered order. Each removal unlinks
+     two edges from the hub's adjacency, which a search of the hub's
+     neighbours would make quadratic in the number of rooms.
+     */
+    static std::string timeHubRemovals(int numSpokes) {
+        std::ostringstream sout;
+        Graph<int, int>* g = new Graph<int, int>(true);
+        Vertex<int>* hub = new Vertex<int>();
+        std::vector<Vertex<int>*> spokes(numSpokes);
+        std::vector<Graph<int, int>::EdgeRecord> records;
+        for (int k = 0; k < numSpokes; k++) {
+            spokes[k] = new Vertex<int>();
+            records.push_back({ hub, spokes[k], 1.0, nullptr });
+            records.push_back({ spokes[k], hub, 1.0, nullptr });
+        }
+        g->addEdges(records);
+        unsigned int seed = 109;
+        for (int k = numSpokes - 1; k > 0; k--) {
+            seed = seed * 1103515245 + 12345;
+            std::swap(spokes[k], spokes[(seed >> 4) % (k + 1)]);
+        }
+        Clock::time_point start = Clock::now();
+        for (Vertex<int>* spoke : spokes) {
+            g->removeVertex(spoke);
+        }
+        double time = millisecondsSince(start);
+        sout << "ArrayList hub of " << numSpokes << " rooms: removeVertex " << time * 1000 / numSpokes
+            << " us per room, hub degree now " << g->getOutDegree(hub) + g->getInDegree(hub) << std::endl;
+        delete g;
+        return sout.str();
+    }
+
+    /*
+     Reports the cost of removing edges and vertices from graphs of 100k
+     rooms and 400k edges, backed by List and by ArrayList, and of removing
+     the rooms around a hub of degree 200k.
+     */
+    static std::string benchmarkRemoval() {
+        std::ostringstream sout;
+        sout << "GraphBenchmarks::benchmarkRemoval" << std::endl;
+        sout << timeRemovals<List>("List", 100000, 400000, 20000);
+        sout << timeRemovals<ArrayList>("ArrayList", 100000, 400000, 20000);
+        sout << timeHubRemovals(100000);
+        return sout.str();
+    }
+
+    /*
+     Builds a world of the specified size, each room holding a story list of
+     the specified number of lines, then times saving it as a WorldImage,
+     opening the image and reading from it, against building the world in
+     code. The image is written to the working directory and removed.
+     */
+    static std::string benchmarkWorldImage(int numRooms, int numDoors, int linesPerRoom, int lineLength) {
+        std::ostringstream sout;
+        const std::string path = "GraphBenchmarks_world.img";
+        Clock::time_point start = Clock::now();
+        Graph<List<std::string>, List<std::string>>* world = new Graph<List<std::string>, List<std::string>>(true);
+        std::vector<Vertex<List<std::string>>*> rooms(numRooms);
+        for (int k = 0; k < numRooms; k++) {
+            List<std::string>* story = new List<std::string>();
+            story->setOwnsData(true);
+            for (int line = 0; line < linesPerRoom; line++) {
+                story->insertAtEnd(new std::string(lineLength, (char)('a' + (k + line) % 26)));
+            }
+            rooms[k] = new Vertex<List<std::string>>();
+            rooms[k]->setData(story);
+        }
+        std::vector<Graph<List<std::string>, List<std::string>>::EdgeRecord> records(numDoors);
+        unsigned int seed = 109;
+        for (int k = 0; k < numDoors; k++) {
+            seed = seed * 1103515245 + 12345;
+            int from = (int)((seed >> 4) % numRooms);
+            seed = seed * 1103515245 + 12345;
+            int to = (int)((seed >> 4) % numRooms);
+            records[k] = { rooms[from], rooms[to], 1.0 + k % 7, nullptr };
+        }
+        world->addVertices(rooms);
+        world->addEdges(records);
+        double buildTime = millisecondsSince(start);
+
+        start = Clock::now();
+        bool written = WorldImage::write(world, path);
+        double writeTime = millisecondsSince(start);
+        delete world;
+
+        start = Clock::now();
+        WorldImage* image = written ? WorldImage::open(path, false) : nullptr;
+        double openTime = millisecondsSince(start);
+        delete image;
+        start = Clock::now();
+        image = written ? WorldImage::open(path) : nullptr;
+        double validatedOpenTime = millisecondsSince(start);
+        if (image == nullptr) {
+            std::remove(path.c_str());
+            return "the world image couldn't be written or opened\n";
+        }
+        start = Clock::now();
+        size_t storyLength = 0;
+        for (int k = 0; k < image->getNumStoryLines(numRooms / 2); k++) {
+            storyLength += image->getStoryLine(numRooms / 2, k).size();
+        }
+        double firstReadTime = millisecondsSince(start);
+        start = Clock::now();
+        bool intact = image->verifyChecksum();
+        double checksumTime = millisecondsSince(start);
+        start = Clock::now();
+        Graph<List<std::string>, List<std::string>>* copy = image->toGraph();
+        double copyTime = millisecondsSince(start);
+
+        sout << numRooms << " rooms, " << numDoors << " edges, " << image->getFileSize() / (1024 * 1024)
+            << " MB image: build in code " << buildTime << " ms, write " << writeTime << " ms, open "
+            << openTime << " ms (validated " << validatedOpenTime << " ms), read one room " << firstReadTime << " ms (" << storyLength << " chars), "
+            << "verifyChecksum " << checksumTime << " ms" << (intact ? "" : " (CORRUPT)") << ", toGraph "
+            << copyTime << " ms" << std::endl;
+        delete copy;
+        delete image;
+        std::remove(path.c_str());
+        return sout.str();
+    }
+
+    /*
+     Reports WorldImage against building in code, for a small world and one
+     whose image is a few hundred megabytes. Opening is timed with the file
+     most likely still in the page cache from writing it.
+     */
+    static std::string benchmarkWorldImage() {
+        std::ostringstream sout;
+        sout << "GraphBenchmarks::benchmarkWorldImage" << std::endl;
+        sout << benchmarkWorldImage(10000, 40000, 8, 80);
+        sout << benchmarkWorldImage(400000, 1600000, 8, 80);
+        return sout.str();
+    }
+
+    /*
+     Writes a world description with the specified numbers of rooms, exits
+     per room and story lines per room, then times reading the file back
+     with WorldLoader, against just reading its bytes. Loading includes
+     adding the rooms and exits to the graph, so that is timed on its own
+     too, from the loaded world's rooms and exits, and taken off the load
+     time to give the rate of the parser itself. The file is written to the
+     working directory and removed. The large world of benchmarkWorldLoader()
+     loads at 110-140 MB/s on one core.
+     */
+    static std::string benchmarkWorldLoader(int numRooms, int exitsPerRoom, int linesPerRoom) {
+        std::ostringstream sout;
+        const std::string path = "GraphBenchmarks_world.txt";
+        {
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            std::string line(70, ' ');
+            unsigned int seed = 113;
+            for (int k = 0; k < numRooms; k++) {
+                out << "room r" << k << "\n";
+                for (int l = 0; l < linesPerRoom; l++) {
+                    for (char& c : line) {
+                        seed = seed * 1103515245 + 12345;
+                        c = (seed >> 16) % 6 == 0 ? ' ' : (char)('a' + (seed >> 8) % 26);
+                    }
+                    out << "| " << line << "\n";
+                }
+                for (int e = 0; e < exitsPerRoom; e++) {
+                    seed = seed * 1103515245 + 12345;
+                    // offsets differ mod exitsPerRoom, so no exit is repeated
+                    int offset = 1 + e + exitsPerRoom * (int)((seed >> 4) % (numRooms / exitsPerRoom - 1));
+                    out << "exit r" << k << " r" << (k + offset) % numRooms << " " << 1 + e * 0.25 << "\n";
+                    if (e == 0) {
+                        out << "| A passage leads on.\n";
+                    }
+                }
+            }
+        }
+
+        Clock::time_point start = Clock::now();
+        size_t fileSize = 0;
+        {
+            std::ifstream in(path, std::ios::binary);
+            std::vector<char> buffer(1 << 16);
+            while (in.read(buffer.data(), (std::streamsize)buffer.size()) || in.gcount() > 0) {
+                fileSize += (size_t)in.gcount();
+            }
+        }
+        double readTime = millisecondsSince(start);
+
+        StringArena storyText;
+        WorldLoader loader(&storyText);
+        start = Clock::now();
+        Graph<List<std::string_view>, List<std::string_view>>* world = loader.loadFile(path);
+        double loadTime = millisecondsSince(start);
+        double megabytes = fileSize / (1024.0 * 1024.0);
+        sout << numRooms << " rooms, " << (int)megabytes << " MB: read " << readTime << " ms ("
+            << megabytes * 1000 / readTime << " MB/s), load " << loadTime << " ms (" << megabytes * 1000 / loadTime
+            << " MB/s)";
+        if (world == nullptr) {
+            sout << " FAILED: " << loader.getErrorMessage() << std::endl;
+            std::remove(path.c_str());
+            return sout.str();
+        }
+
+        std::vector<Vertex<List<std::string_view>>*> rooms(world->getNumVertices());
+        for (Vertex<List<std::string_view>>*& room : rooms) {
+            room = new Vertex<List<std::string_view>>();
+        }
+        std::vector<Graph<List<std::string_view>, List<std::string_view>>::EdgeRecord> records;
+        for (Edge<List<std::string_view>, List<std::string_view>>* exit : *world->getEdges()) {
+            records.push_back({ rooms[world->getVertexIndex(exit->getInitialVertex())],
+                rooms[world->getVertexIndex(exit->getTerminalVertex())], exit->getEdgeWeight(), nullptr });
+        }
+        start = Clock::now();
+        Graph<List<std::string_view>, List<std::string_view>>* copy = new Graph<List<std::string_view>, List<std::string_view>>(true);
+        copy->addVertices(rooms);
+        copy->addEdges(records);
+        double buildTime = millisecondsSince(start);
+        sout << ", of which adding " << world->getNumVertices() << " rooms and " << world->getNumEdges()
+            << " exits to the graph " << buildTime << " ms; parsing " << megabytes * 1000 / (loadTime - buildTime)
+            << " MB/s" << std::endl;
+        delete copy;
+        delete world;
+        std::remove(path.c_str());
+        return sout.str();
+    }
+
+    static std::string benchmarkWorldLoader() {
+        std::ostringstream sout;
+        sout << "GraphBenchmarks::benchmarkWorldLoader" << std::endl;
+        sout << benchmarkWorldLoader(10000, 4, 8);
+        sout << benchmarkWorldLoader(300000, 4, 8);
+        return sout.str();
+    }
+
+    /*
+     Measures the memory a random graph with the specified numbers of
+     vertices and edges takes as a Graph and as a CompactGraph copied from
+     it, by the growth of the resident set size (so allocator overhead is
+     counted), and the time to make the copy. Also reports what each would
+     take for 100M edges at the same average degree.
+     */
+    static std::string benchmarkCompactGraph(int numVertices, int numEdges) {
+        std::ostringstream sout;
+        std::vector<Vertex<int>*> rooms;
+        long long before = MemoryUsage::residentBytes();
+        Graph<int, int>* g = buildRandomGraph(numVertices, numEdges, rooms);
+        long long graphBytes = MemoryUsage::residentBytes() - before;
+
+        before = MemoryUsage::residentBytes();
+        Clock::time_point start = Clock::now();
+        CompactGraph<int, int>* compact = new CompactGraph<int, int>(g);
+        double copyTime = millisecondsSince(start);
+        long long compactBytes = MemoryUsage::residentBytes() - before;
+
+        double scale = 1e8 / numEdges / (1024.0 * 1024.0 * 1024.0);
+        sout << numVertices << " vertices, " << numEdges << " edges: Graph " << graphBytes / (1024 * 1024)
+            << " MB (" << (double)graphBytes / numEdges << " B/edge), CompactGraph " << compactBytes / (1024 * 1024)
+            << " MB (" << (double)compactBytes / numEdges << " B/edge, " << compact->getMemoryBytes() / (1024 * 1024)
+            << " MB by its own count), copied in " << copyTime << " ms; at 100M edges "
+            << graphBytes * scale << " GB vs " << compactBytes * scale << " GB" << std::endl;
+        delete compact;
+        delete g;
+        return sout.str();
+    }
+
+    static std::string benchmarkCompactGraph() {
+        std::ostringstream sout;
+        sout << "GraphBenchmarks::benchmarkCompactGraph" << std::endl;
+        sout << benchmarkCompactGraph(100000, 1000000);
+        sout << benchmarkCompactGraph(1000000, 8000000);
+        return sout.str();
+    }
+
+    /*
+     Walks the outgoing neighbours of every vertex of a random graph with
+     the specified numbers of vertices and edges, the specified number of
+     times, through getOutgoingVertices (a new list per vertex), through
+     getOutgoingRange and through forEachOutgoing. Each walk folds the
+     neighbours' addresses into a checksum so the three can be compared.
+     */
+    static std::string benchmarkNeighborWalks(int numVertices, int numEdges, int numPasses) {
+        std::ostringstream sout;
+        std::vector<Vertex<int>*> rooms;
+        Graph<int, int>* g = buildRandomGraph(numVertices, numEdges, rooms);
+
+        size_t listSum = 0;
+        Clock::time_point start = Clock::now();
+        for (int pass = 0; pass < numPasses; pass++) {
+            for (Vertex<int>* vertex : rooms) {
+                List<Vertex<int>>* outgoing = g->getOutgoingVertices(vertex);
+                for (Vertex<int>* neighbor : *outgoing) {
+                    listSum += (size_t)neighbor;
+                }
+                delete outgoing;
+            }
+        }
+        double listTime = millisecondsSince(start);
+
+        size_t rangeSum = 0;
+        start = Clock::now();
+        for (int pass = 0; pass < numPasses; pass++) {
+            for (Vertex<int>* vertex : rooms) {
+                for (Vertex<int>* neighbor : g->getOutgoingRange(vertex)) {
+                    rangeSum += (size_t)neighbor;
+                }
+            }
+        }
+        double rangeTime = millisecondsSince(start);
+
+        size_t visitorSum = 0;
+        start = Clock::now();
+        for (int pass = 0; pass < numPasses; pass++) {
+            for (Vertex<int>* vertex : rooms) {
+                g->forEachOutgoing(vertex, [&visitorSum](Vertex<int>* neighbor) {
+                    visitorSum += (size_t)neighbor;
+                });
+            }
+        }
+        double visitorTime = millisecondsSince(start);
+
+        delete g;
+        double numWalked = (double)numEdges * numPasses;
+        sout << numEdges << " edges x " << numPasses << ": getOutgoingVertices " << listTime << " ms ("
+            << listTime * 1e6 / numWalked << " ns/neighbour), getOutgoingRange " << rangeTime << " ms ("
+            << rangeTime * 1e6 / numWalked << " ns/neighbour), forEachOutgoing " << visitorTime << " ms ("
+            << visitorTime * 1e6 / numWalked << " ns/neighbour), " << listTime / rangeTime << "x"
+            << (listSum == rangeSum && rangeSum == visitorSum ? "" : " (MISMATCH)") << std::endl;
+        return sout.str();
+    }
+
+    static std::string benchmarkNeighborWalks() {
+        std::ostringstream sout;
+        sout << "GraphBenchmarks::benchmarkNeighborWalks" << std::endl;
+        sout << benchmarkNeighborWalks(1000, 4000, 1000);
+        sout << benchmarkNeighborWalks(100000, 1000000, 5);
+        return sout.str();
+    }
+
+    /*
+     Builds a random graph with the specified numbers of vertices and edges
+     and compares the bytes its memory report accounts for with the growth
+     of the resident set size, which also includes the heap's overhead per
+     allocation. Returns the comparison followed by the report itself as
+     key=value lines.
+     */
+    static std::string benchmarkMemoryReport(int numVertices, int numEdges) {
+        std::ostringstream sout;
+        std::vector<Vertex<int>*> rooms;
+        long long before = MemoryUsage::residentBytes();
+        Graph<int, int>* g = buildRandomGraph(numVertices, numEdges, rooms);
+        long long residentBytes = MemoryUsage::residentBytes() - before;
+
+        MemoryReport report;
+        Clock::time_point start = Clock::now();
+        g->reportMemory(&report, "graph");
+        double reportTime = millisecondsSince(start);
+        delete g;
+        size_t accounted = report.getTotalBytes();
+        sout << numVertices << " vertices, " << numEdges << " edges: accounted " << accounted / (1024 * 1024)
+            << " MB (" << (double)accounted / numEdges << " B/edge), resident " << residentBytes / (1024 * 1024)
+            << " MB (" << (double)residentBytes / numEdges << " B/edge), report took " << reportTime << " ms"
+            << std::endl;
+        sout << report.toKeyValue();
+        return sout.str();
+    }
+
+    static std::string benchmarkMemoryReport() {
+        std::ostringstream sout;
+        sout << "GraphBenchmarks::benchmarkMemoryReport" << std::endl;
+        sout << benchmarkMemoryReport(1000000, 8000000);
+        return sout.str();
+    }
+
+    static std::string runAllBenchmarks() {
+        std::ostringstream sout;
+        sout << benchmarkVertexLoad() << std::endl;
+        sout << benchmarkEdgeQueries() << std::endl;
+        sout << benchmarkFrozenGraph() << std::endl;
+        sout << benchmarkBulkLoads() << std::endl;
+        sout << benchmarkGraphSearch() << std::endl;
+        sout << benchmarkPathFinder() << std::endl;
+        sout << benchmarkParallelBfs() << std::endl;
+        sout << benchmarkStrongComponents() << std::endl;
+        sout << benchmarkRemoval() << std::endl;
+        sout << benchmarkWorldImage() << std::endl;
+        sout << benchmarkWorldLoader() << std::endl;
+        sout << benchmarkCompactGraph() << std::endl;
+        sout << benchmarkNeighborWalks() << std::endl;
+        sout << benchmarkMemoryReport() << std::endl;
+        return sout.str();
+    }
+
+};
@@ -0,0 +1,348 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "Vertex.h"
+#include "Graph.h"
+#include "ArrayList.h"
+
+/*
+Breadth-first and depth-first searches over a Graph, for reachability
+checks, room discovery and map rendering.
+
+A GraphSearch keeps its frontier and its visited set between searches, so
+once its buffers have grown to fit the graph, running a search allocates
+nothing. Vertices are marked visited in a bitset indexed by their position
+in the graph's vertex list, and only the bits a search set are cleared when
+the next one begins, so short searches on a large graph stay cheap.
+
+A search is driven either one vertex at a time:
+
+	search.beginBreadthFirst(entrance, 3);
+	for (Vertex<T>* room = search.next(); room != nullptr; room = search.next()) {
+		... search.getDepth() ...
+	}
+
+where stopping early is just a matter of not calling next again, or with a
+visitor that returns false to stop:
+
+	search.breadthFirst(entrance, [](Vertex<T>* room, int depth) { return true; });
+
+Depths count edges from the start vertex, which has depth 0; a maximum depth
+of -1 means no limit. The graph must not change while a search is under way.
+*/
+template <typename T, typename U, template <typename> class Container = ArrayList>
+class GraphSearch {
+
+protected:
+
+	/*
+	A vertex on the depth-first stack, with the position in its out-vertices
+	of the next neighbour to look at.
+	*/
+	struct Frame {
+		Vertex<T>* vertex;
+		int depth;
+		int nextNeighbor;
+	};
+
+	Graph<T, U, Container>* graph;
+
+	bool searchingDepthFirst;
+
+	int maxDepth;
+
+	/*
+	The breadth-first queue, with the depth of each vertex in it, and the
+	position of the next vertex to return. Vertices stay in the queue after
+	they are returned, so it also lists every vertex visited.
+	*/
+	std::vector<Vertex<T>*> queue;
+
+	std::vector<int> queueDepths;
+
+	size_t queueHead;
+
+	std::vector<Frame> stack;
+
+	/*
+	Bit k is set if the vertex at position k of the graph's vertex list has
+	been visited by the current search.
+	*/
+	std::vector<uint64_t> visitedBits;
+
+	/*
+	The positions of the vertices the current search has visited, so their
+	bits can be cleared.
+	*/
+	std::vector<int> visitedPositions;
+
+	Vertex<T>* current;
+
+	int currentDepth;
+
+	/*
+	Marks the specified vertex visited and returns true, unless it is not
+	part of the graph or has already been visited, in which case this method
+	returns false.
+	*/
+	bool visit(Vertex<T>* vertex) {
+		int position = this->graph->getVertexIndex(vertex);
+		if (position < 0) {
+			return false;
+		}
+		uint64_t& word = this->visitedBits[position >> 6];
+		uint64_t bit = (uint64_t)1 << (position & 63);
+		if (word & bit) {
+			return false;
+		}
+		word |= bit;
+		this->visitedPositions.push_back(position);
+		return true;
+	}
+
+	/*
+	Ends the current search, clears its visited bits, and starts a search
+	from the specified vertex. Returns false, leaving no search under way,
+	if the vertex is not part of the graph.
+	*/
+	bool begin(Vertex<T>* start, int maxDepth, bool depthFirst) {
+		this->reset();
+		size_t numWords = ((size_t)this->graph->getNumVertices() + 63) / 64;
+		if (this->visitedBits.size() < numWords) {
+			this->visitedBits.resize(numWords, 0);
+		}
+		this->searchingDepthFirst = depthFirst;
+		this->maxDepth = maxDepth;
+		if (!this->visit(start)) {
+			return false;
+		}
+		if (depthFirst) {
+			this->stack.push_back({ start, 0, -1 });
+		}
+		else {
+			this->queue.push_back(start);
+			this->queueDepths.push_back(0);
+		}
+		return true;
+	}
+
+	Vertex<T>* nextBreadthFirst() {
+		if (this->queueHead == this->queue.size()) {
+			return nullptr;
+		}
+		Vertex<T>* vertex = this->queue[this->queueHead];
+		int depth = this->queueDepths[this->queueHead];
+		this->queueHead++;
+		// neighbours are queued only when their parent is returned, so a
+		// search that stops early doesn't pay for the next level
+		if (this->maxDepth < 0 || depth < this->maxDepth) {
+			int outDegree = vertex->getOutDegree();
+			for (int k = 0; k < outDegree; k++) {
+				Vertex<T>* neighbor = vertex->getOutVertex(k);
+				if (this->visit(neighbor)) {
+					this->queue.push_back(neighbor);
+					this->queueDepths.push_back(depth + 1);
+				}
+			}
+		}
+		this->current = vertex;
+		this->currentDepth = depth;
+		return vertex;
+	}
+
+	Vertex<T>* nextDepthFirst() {
+		while (!this->stack.empty()) {
+			Frame& top = this->stack.back();
+			// the start vertex is pushed with nextNeighbor -1, meaning it
+			// hasn't been returned yet
+			if (top.nextNeighbor < 0) {
+				top.nextNeighbor = 0;
+				this->current = top.vertex;
+				this->currentDepth = top.depth;
+				return top.vertex;
+			}
+			if ((this->maxDepth < 0 || top.depth < this->maxDepth)
+				&& top.nextNeighbor < top.vertex->getOutDegree()) {
+				Vertex<T>* neighbor = top.vertex->getOutVertex(top.nextNeighbor++);
+				if (this->visit(neighbor)) {
+					int depth = top.depth + 1;
+					this->stack.push_back({ neighbor, depth, 0 });
+					this->current = neighbor;
+					this->currentDepth = depth;
+					return neighbor;
+				}
+			}
+			else {
+				this->stack.pop_back();
+			}
+		}
+		return nullptr;
+	}
+
+public:
+
+	/*
+	Creates a search over the specified graph, which it does not own.
+	*/
+	GraphSearch(Graph<T, U, Container>* graph) {
+		this->graph = graph;
+		this->searchingDepthFirst = false;
+		this->maxDepth = -1;
+		this->queueHead = 0;
+		this->current = nullptr;
+		this->currentDepth = -1;
+	}
+
+	/*
+	Ends the current search, if any, keeping the buffers for the next one.
+	*/
+	void reset() {
+		for (int position : this->visitedPositions) {
+			this->visitedBits[position >> 6] = 0;
+		}
+		this->visitedPositions.clear();
+		this->queue.clear();
+		this->queueDepths.clear();
+		this->queueHead = 0;
+		this->stack.clear();
+		this->current = nullptr;
+		this->currentDepth = -1;
+	}
+
+	/*
+	Starts a breadth-first search from the specified vertex, going no more
+	than maxDepth edges from it (-1 for no limit). Vertices come out of next
+	in order of depth. Returns false if the vertex is not part of the graph.
+	*/
+	bool beginBreadthFirst(Vertex<T>* start, int maxDepth = -1) {
+		return this->begin(start, maxDepth, false);
+	}
+
+	/*
+	Starts a depth-first search from the specified vertex, going no more
+	than maxDepth edges from it (-1 for no limit). Vertices come out of next
+	in preorder, each neighbour's subtree before the next neighbour. The
+	depth of a vertex is its depth in the search tree, which can be more
+	than its distance from the start, so a depth-limited depth-first search
+	can miss vertices a breadth-first one would reach. Returns false if the
+	vertex is not part of the graph.
+	*/
+	bool beginDepthFirst(Vertex<T>* start, int maxDepth = -1) {
+		return this->begin(start, maxDepth, true);
+	}
+
+	/*
+	Returns the next vertex of the current search, or the null pointer once
+	the search has visited every vertex it can reach.
+	*/
+	Vertex<T>* next() {
+		Vertex<T>* result = this->searchingDepthFirst ? this->nextDepthFirst() : this->nextBreadthFirst();
+		if (result == nullptr) {
+			this->current = nullptr;
+			this->currentDepth = -1;
+		}
+		return result;
+	}
+
+	/*
+	Returns the depth of the vertex last returned by next, or -1 if there is
+	none.
+	*/
+	int getDepth() {
+		return this->currentDepth;
+	}
+
+	/*
+	Returns the vertex last returned by next, or the null pointer if there
+	is none.
+	*/
+	Vertex<T>* getCurrent() {
+		return this->current;
+	}
+
+	/*
+	Returns true if the current search has reached the specified vertex,
+	either by returning it from next or by queueing it to be returned.
+	*/
+	bool isVisited(Vertex<T>* vertex) {
+		int position = this->graph->getVertexIndex(vertex);
+		if (position < 0 || (size_t)(position >> 6) >= this->visitedBits.size()) {
+			return false;
+		}
+		return (this->visitedBits[position >> 6] >> (position & 63)) & 1;
+	}
+
+	/*
+	Returns the number of vertices the current search has reached.
+	*/
+	int getNumVisited() {
+		return (int)this->visitedPositions.size();
+	}
+
+	/*
+	Calls visitor(vertex, depth) on each vertex reachable from the specified
+	vertex within maxDepth edges, in breadth-first order, until the visitor
+	returns false. Returns the number of vertices visited, or -1 if the
+	start vertex is not part of the graph.
+	*/
+	template <typename Visitor>
+	int breadthFirst(Vertex<T>* start, Visitor visitor, int maxDepth = -1) {
+		if (!this->beginBreadthFirst(start, maxDepth)) {
+			return -1;
+		}
+		int numVisited = 0;
+		for (Vertex<T>* vertex = this->next(); vertex != nullptr; vertex = this->next()) {
+			numVisited++;
+			if (!visitor(vertex, this->currentDepth)) {
+				break;
+			}
+		}
+		return numVisited;
+	}
+
+	/*
+	Like breadthFirst, but in depth-first preorder.
+	*/
+	template <typename Visitor>
+	int depthFirst(Vertex<T>* start, Visitor visitor, int maxDepth = -1) {
+		if (!this->beginDepthFirst(start, maxDepth)) {
+			return -1;
+		}
+		int numVisited = 0;
+		for (Vertex<T>* vertex = this->next(); vertex != nullptr; vertex = this->next()) {
+			numVisited++;
+			if (!visitor(vertex, this->currentDepth)) {
+				break;
+			}
+		}
+		return numVisited;
+	}
+
+	/*
+	Returns the number of edges on a shortest path from the "from" vertex to
+	the "to" vertex, or -1 if there is no such path of at most maxDepth
+	edges or either vertex is not part of the graph. The search stops as
+	soon as it reaches the "to" vertex.
+	*/
+	int getDistance(Vertex<T>* from, Vertex<T>* to, int maxDepth = -1) {
+		if (!this->graph->hasVertex(to) || !this->beginBreadthFirst(from, maxDepth)) {
+			return -1;
+		}
+		for (Vertex<T>* vertex = this->next(); vertex != nullptr; vertex = this->next()) {
+			if (vertex == to) {
+				return this->currentDepth;
+			}
+		}
+		return -1;
+	}
+
+	/*
+	Returns true if and only if there is a path of at most maxDepth edges
+	(-1 for any length) from the "from" vertex to the "to" vertex.
+	*/
+	bool isReachable(Vertex<T>* from, Vertex<T>* to, int maxDepth = -1) {
+		return this->getDistance(from, to, maxDepth) >= 0;
+	}
+
+};
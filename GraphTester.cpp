@@ -0,0 +1 @@
+#include "GraphTester.h"
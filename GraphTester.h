@@ -0,0 +1,1857 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "CompactGraph.h"
+#include "Graph.h"
+#include "GraphSearch.h"
+#include "IndexedHeap.h"
+#include "MemoryReport.h"
+#include "MemoryUsage.h"
+#include "ParallelBfs.h"
+#include "PathFinder.h"
+#include "StringArena.h"
+#include "StrongComponents.h"
+#include "TestResults.h"
+#include "WorldImage.h"
+#include "WorldLoader.h"
+
+class GraphTester {
+
+public:
+
+    /*
+     Test edge lookup, duplicate edges, ownership and moving.
+     */
+    static TestResults* test0() {
+        std::ostringstream sout;
+        int pointsPossible = 0;
+        int pointsEarned = 0;
+        //
+        Graph<int, int>* g = new Graph<int, int>(true);
+        Vertex<int>* a = new Vertex<int>();
+        Vertex<int>* b = new Vertex<int>();
+        a->setData(new int(1));
+        b->setData(new int(2));
+        g->addEdge(a, b);
+        g->addEdge(a, b);
+        g->storeInEdge(new int(3), a, b);
+        //
+        pointsPossible++;
+        if (g->getNumEdges() == 1 && g->getNumVertices() == 2) {
+            pointsEarned++;
+        }
+        else {
+            sout << "addEdge added a duplicate edge" << std::endl;
+        }
+        //
+        pointsPossible++;
+        g->setEdgeWeight(2.5, a, b);
+        if (g->hasEdge(a, b) && !g->hasEdge(b, a)) {
+            pointsEarned++;
+        }
+        else {
+            sout << "hasEdge returned an incorrect value" << std::endl;
+        }
+        //
+        pointsPossible++;
+        Graph<int, int> moved(std::move(*g));
+        if (g->isEmpty() && g->getNumEdges() == 0 && moved.getNumEdges() == 1
+            && moved.getOwnsContents() && moved.getEdgeWeight(a, b) == 2.5) {
+            pointsEarned++;
+        }
+        else {
+            sout << "move construction did not take over the graph" << std::endl;
+        }
+        delete g;
+
+        std::cout << "GraphTester::test0 results:" << std::endl;
+        return new TestResults(pointsPossible, pointsEarned, sout.str());
+    }
+
+    /*
+     Soak test: millions of edge queries, and thousands of owning graphs
+     built, edited, moved and destroyed with their vertices, edges and data,
+     should run in flat memory.
+     */
+    static TestResults* test1() {
+        std::ostringstream sout;
+        int pointsPossible = 0;
+        int pointsEarned = 0;
+        //
+        Graph<int, int>* g = new Graph<int, int>(true);
+        Vertex<int>* ring[8];
+        for (int k = 0; k < 8; k++) {
+            ring[k] = new Vertex<int>();
+        }
+        for (int k = 0; k < 8; k++) {
+            g->addEdge(ring[k], ring[(k + 1) % 8]);
+        }
+        long long before = 0;
+        int hits = 0;
+        int intact = 0;
+        for (int round = 0; round < 20001; round++) {
+            if (round == 1) {
+                before = MemoryUsage::residentBytes();
+            }
+            for (int query = 0; query < 100; query++) {
+                if (g->hasEdge(ring[query % 8], ring[(query + 1) % 8])) {
+                    hits++;
+                }
+            }
+            // a ring with chords, every vertex and edge holding data
+            Graph<int, int>* rebuilt = new Graph<int, int>(true);
+            Vertex<int>* rooms[8];
+            for (int k = 0; k < 8; k++) {
+                rooms[k] = new Vertex<int>(new int(k));
+            }
+            for (int k = 0; k < 8; k++) {
+                rebuilt->addEdge(rooms[k], rooms[(k + 1) % 8]);
+                rebuilt->addEdge(rooms[k], rooms[(k + 3) % 8]);
+                rebuilt->storeInEdge(new int(k), rooms[k], rooms[(k + 1) % 8]);
+            }
+            rebuilt->removeEdge(rooms[round % 8], rooms[(round + 1) % 8]);
+            rebuilt->removeEdge(rooms[round % 8], rooms[(round + 3) % 8]);
+            rebuilt->addEdge(rooms[round % 8], rooms[(round + 5) % 8]);
+            rebuilt->storeInEdge(new int(round), rooms[round % 8], rooms[(round + 5) % 8]);
+            rebuilt->removeVertex(rooms[(round + 4) % 8]);
+            // the moved-to graph frees everything at the end of the round
+            Graph<int, int> moved(std::move(*rebuilt));
+            delete rebuilt;
+            if (moved.getNumVertices() == 7 && moved.getNumEdges() == 11
+                && moved.hasEdge(rooms[round % 8], rooms[(round + 5) % 8])
+                && *moved.getEdgeData(rooms[round % 8], rooms[(round + 5) % 8]) == round) {
+                intact++;
+            }
+        }
+        long long growth = MemoryUsage::residentBytes() - before;
+        delete g;
+        //
+        pointsPossible++;
+        if (hits == 2000100 && intact == 20001 && growth < 1024 * 1024) {
+            pointsEarned++;
+        }
+        else {
+            sout << "memory grew by " << growth << " bytes during the soak test, or " << 20001 - intact
+                << " moved graphs lost edges" << std::endl;
+        }
+
+        std::cout << "GraphTester::test1 results:" << std::endl;
+        return new TestResults(pointsPossible, pointsEarned, sout.str());
+    }
+
+    /*
+     Test a graph backed by List instead of the default ArrayList.
+     */
+    static TestResults* test2() {
+        std::ostringstream sout;
+        int pointsPossible = 0;
+        int pointsEarned = 0;
+        //
+        Graph<int, int, List>* g = new Graph<int, int, List>(true);
+        Vertex<int>* a = new Vertex<int>();
+        Vertex<int>* b = new Vertex<int>();
+        Vertex<int>* c = new Vertex<int>();
+        g->addEdge(a, b);
+        g->addEdge(b, c);
+        g->addEdge(c, c);
+        g->setEdgeWeight(4.0, b, c);
+        g->storeInVertex(new int(7), 2);
+        //
+        pointsPossible++;
+        if (g->getNumVertices() == 3 && g->getNumEdges() == 3 && g->getVertex(1) == b
+            && g->getVertexIndex(c) == 2 && g->getEdgeIndex(c, c) == 2) {
+            pointsEarned++;
+        }
+        else {
+            sout << "List-backed graph has the wrong vertices or edges" << std::endl;
+        }
+        //
+        pointsPossible++;
+        if (g->getEdgeWeight(1) == 4.0 && *g->getVertexData(c) == 7 && g->getOutDegree(c) == 1) {
+            pointsEarned++;
+        }
+        else {
+            sout << "List-backed graph returned incorrect data" << std::endl;
+        }
+        delete g;
+
+        std::cout << "GraphTester::test2 results:" << std::endl;
+        return new TestResults(pointsPossible, pointsEarned, sout.str());
+    }
+
+    /*
+     Test the edge index: on a random graph with loops and repeated edges,
+     every (from, to) query must agree with a scan of the edge list.
+     */
+    static TestResults* test3() {
+        std::ostringstream sout;
+        int pointsPossible = 0;
+        int pointsEarned = 0;
+        //
+        const int numVertices = 60;
+        Graph<int, int>* g = new Graph<int, int>(true);
+        std::vector<Vertex<int>*> rooms(numVertices);
+        for (int k = 0; k < numVertices; k++) {
+            rooms[k] = new Vertex<int>();
+        }
+        unsigned int seed = 23;
+        for (int k = 0; k < 900; k++) {
+            seed = seed * 1103515245 + 12345;
+            Vertex<int>* from = rooms[(seed >> 8) % numVertices];
+            Vertex<int>* to = rooms[(seed >> 16) % numVertices];
+            g->addEdge(from, to);
+            g->setEdgeWeight((double)k, from, to);
+        }
+        //
+        pointsPossible++;
+        bool agrees = true;
+        for (Vertex<int>* from : rooms) {
+            for (Vertex<int>* to : rooms) {
+                int expectedIndex = -1;
+                int position = 0;
+                for (Edge<int, int>* edge : *g->getEdges()) {
+                    if (edge->getInitialVertex() == from && edge->getTerminalVertex() == to) {
+                        expectedIndex = position;
+                        break;
+                    }
+                    position++;
+                }
+                if (g->getEdgeIndex(from, to) != expectedIndex || g->hasEdge(from, to) != (expectedIndex >= 0)) {
+                    agrees = false;
+                }
+                else if (expectedIndex >= 0 && g->getEdgeWeight(from, to) != g->getEdges()->peek(expectedIndex)->getEdgeWeight()) {
+                    agrees = false;
+                }
+            }
+        }
+        if (agrees) {
+            pointsEarned++;
+        }
+        else {
+            sout << "the edge index disagreed with the edge list" << std::endl;
+        }
+        //
+        pointsPossible++;
+        Vertex<int>* from = g->getEdges()->peek(0)->getInitialVertex();
+        Vertex<int>* to = g->getEdges()->peek(0)->getTerminalVertex();
+        Graph<int, int> moved(std::move(*g));
+        moved.storeInEdge(new int(5), from, to);
+        if (!g->hasEdge(from, to) && g->storeInEdge(new int(6), from, to) < 0
+            && moved.hasEdge(from, to) && *moved.getEdgeData(from, to) == 5) {
+            pointsEarned++;
+        }
+        else {
+            sout << "the edge index did not move with its graph" << std::endl;
+        }
+        delete g;
+        for (Vertex<int>* room : rooms) {
+            if (!moved.hasVertex(room)) {
+                delete room;
+            }
+        }
+
+        std::cout << "GraphTester::test3 results:" << std::endl;
+        return new TestResults(pointsPossible, pointsEarned, sout.str());
+    }
+
+    /*
+     Test freeze: the snapshot must report the same vertices, neighbours,
+     weights and data as the graph it was made from.
+     */
+    static TestResults* test4() {
+        std::ostringstream sout;
+        int pointsPossible = 0;
+        int pointsEarned = 0;
+        //
+        const int numVertices = 40;
+        Graph<int, int>* g = new Graph<int, int>(true);
+        std::vector<Vertex<int>*> rooms(numVertices);
+        for (int k = 0; k < numVertices; k++) {
+            rooms[k] = new Vertex<int>();
+            rooms[k]->setData(new int(k));
+            g->addVertex(rooms[k]);
+        }
+        unsigned int seed = 31;
+        for (int k = 0; k < 300; k++) {
+            seed = seed * 1103515245 + 12345;
+            Vertex<int>* from = rooms[(seed >> 8) % numVertices];
+            Vertex<int>* to = rooms[(seed >> 16) % numVertices];
+            g->addEdge(from, to);
+            g->setEdgeWeight(k * 0.5, from, to);
+        }
+        g->storeInEdge(new int(99), g->getEdges()->peek(3)->getInitialVertex(),
+            g->getEdges()->peek(3)->getTerminalVertex());
+        FrozenGraph<int, int>* frozen = g->freeze();
+        //
+        pointsPossible++;
+        bool sameVertices = frozen->getNumVertices() == numVertices && frozen->getNumEdges() == g->getNumEdges();
+        for (int k = 0; k < numVertices; k++) {
+            if (frozen->getVertex(k) != rooms[k] || frozen->getVertexId(rooms[k]) != k
+                || *frozen->getVertexData(k) != k || frozen->getVertexData(rooms[k]) != g->getVertexData(rooms[k])) {
+                sameVertices = false;
+            }
+        }
+        Vertex<int>* stranger = new Vertex<int>();
+        List<Vertex<int>>* strangerOutgoing = frozen->getOutgoingVertices(stranger);
+        if (sameVertices && frozen->getVertexId(stranger) < 0 && frozen->getVertex(numVertices) == nullptr
+            && strangerOutgoing->isEmpty()) {
+            pointsEarned++;
+        }
+        else {
+            sout << "the frozen graph has the wrong vertices" << std::endl;
+        }
+        delete strangerOutgoing;
+        delete stranger;
+        //
+        pointsPossible++;
+        bool sameEdges = true;
+        for (int from = 0; from < numVertices; from++) {
+            const int* neighbors = frozen->getNeighbors(from);
+            if (frozen->getOutDegree(from) != g->getOutDegree(rooms[from])) {
+                sameEdges = false;
+            }
+            for (int k = 1; k < frozen->getOutDegree(from); k++) {
+                if (neighbors[k - 1] >= neighbors[k]) {
+                    sameEdges = false;
+                }
+            }
+            for (int to = 0; to < numVertices; to++) {
+                double expected = g->getEdgeWeight(rooms[from], rooms[to]);
+                double actual = frozen->getEdgeWeight(from, to);
+                if (std::isnan(expected) != std::isnan(actual) || (!std::isnan(expected) && expected != actual)
+                    || frozen->hasEdge(rooms[from], rooms[to]) != g->hasEdge(rooms[from], rooms[to])
+                    || frozen->getEdgeData(rooms[from], rooms[to]) != g->getEdgeData(rooms[from], rooms[to])) {
+                    sameEdges = false;
+                }
+            }
+        }
+        List<Vertex<int>>* outgoing = frozen->getOutgoingVertices(rooms[0]);
+        for (Vertex<int>* neighbor : *outgoing) {
+            if (!g->hasEdge(rooms[0], neighbor)) {
+                sameEdges = false;
+            }
+        }
+        if (sameEdges && outgoing->getSize() == g->getOutDegree(rooms[0])) {
+            pointsEarned++;
+        }
+        else {
+            sout << "the frozen graph has the wrong edges" << std::endl;
+        }
+        delete outgoing;
+        delete frozen;
+        delete g;
+
+        std::cout << "GraphTester::test4 results:" << std::endl;
+        return new TestResults(pointsPossible, pointsEarned, sout.str());
+    }
+
+    static TestResults* test5() {
+        std::ostringstream sout;
+        int pointsPossible = 0;
+        int pointsEarned = 0;
+        //
+        const int numVertices = 30;
+        std::vector<Vertex<int>*> rooms(numVertices);
+        for (int k = 0; k < numVertices; k++) {
+            rooms[k] = new Vertex<int>();
+        }
+        Graph<int, int>* g = new Graph<int, int>();
+        std::vector<Vertex<int>*> someRooms(rooms.begin(), rooms.begin() + 10);
+        someRooms.push_back(rooms[3]);
+        g->addVertex(rooms[0]);
+        g->addEdge(rooms[0], rooms[1]);
+        g->setEdgeWeight(-1.0, rooms[0], rooms[1]);
+        //
+        pointsPossible++;
+        if (g->addVertices(someRooms) == 8 && g->getNumVertices() == 10) {
+            pointsEarned++;
+        }
+        else {
+            sout << "addVertices added the wrong vertices" << std::endl;
+        }
+        //
+        std::vector<Graph<int, int>::EdgeRecord> records;
+        unsigned int seed = 41;
+        for (int k = 0; k < 200; k++) {
+            seed = seed * 1103515245 + 12345;
+            Vertex<int>* from = rooms[(seed >> 8) % numVertices];
+            Vertex<int>* to = rooms[(seed >> 16) % numVertices];
+            records.push_back({ from, to, (double)k, k == 7 ? new int(7) : nullptr });
+        }
+        records.push_back({ rooms[0], rooms[1], 5.0, nullptr });
+        int numAdded = g->addEdges(records);
+        //
+        pointsPossible++;
+        std::vector<int> outDegrees(numVertices, 0);
+        for (Edge<int, int>* edge : *g->getEdges()) {
+            for (int k = 0; k < numVertices; k++) {
+                if (edge->getInitialVertex() == rooms[k]) {
+                    outDegrees[k]++;
+                }
+            }
+        }
+        bool sameAdjacency = true;
+        for (int k = 0; k < numVertices; k++) {
+            if (rooms[k]->getOutDegree() != outDegrees[k]) {
+                sameAdjacency = false;
+            }
+        }
+        if (sameAdjacency) {
+            pointsEarned++;
+        }
+        else {
+            sout << "addEdges wired the wrong vertex adjacency" << std::endl;
+        }
+        //
+        Graph<int, int>* expected = new Graph<int, int>();
+        expected->addEdge(rooms[0], rooms[1]);
+        expected->setEdgeWeight(-1.0, rooms[0], rooms[1]);
+        for (Graph<int, int>::EdgeRecord& record : records) {
+            if (!expected->hasEdge(record.from, record.to)) {
+                expected->addEdge(record.from, record.to);
+                expected->setEdgeWeight(record.weight, record.from, record.to);
+            }
+        }
+        //
+        pointsPossible++;
+        if (numAdded == expected->getNumEdges() - 1 && g->getNumEdges() == expected->getNumEdges()
+            && g->getNumVertices() == expected->getNumVertices()) {
+            pointsEarned++;
+        }
+        else {
+            sout << "addEdges added " << numAdded << " edges, expected "
+                << expected->getNumEdges() - 1 << std::endl;
+        }
+        //
+        pointsPossible++;
+        bool sameEdges = g->getEdgeWeight(rooms[0], rooms[1]) == -1.0
+            && g->getEdgeData(records[7].from, records[7].to) == records[7].data;
+        for (int from = 0; from < numVertices; from++) {
+            for (int to = 0; to < numVertices; to++) {
+                double expectedWeight = expected->getEdgeWeight(rooms[from], rooms[to]);
+                double actualWeight = g->getEdgeWeight(rooms[from], rooms[to]);
+                int index = g->getEdgeIndex(rooms[from], rooms[to]);
+                if (std::isnan(expectedWeight) != std::isnan(actualWeight)
+                    || (!std::isnan(expectedWeight) && expectedWeight != actualWeight)
+                    || (index >= 0) != g->hasEdge(rooms[from], rooms[to])
+                    || (index >= 0 && g->getEdges()->peek(index)->getTerminalVertex() != rooms[to])) {
+                    sameEdges = false;
+                }
+            }
+        }
+        if (sameEdges) {
+            pointsEarned++;
+        }
+        else {
+            sout << "addEdges stored the wrong edges" << std::endl;
+        }
+        delete records[7].data;
+        delete expected;
+        delete g;
+        // temporaries and braced lists are accepted as ranges
+        g = new Graph<int, int>();
+        int numVerticesAdded = g->addVertices(std::vector<Vertex<int>*>(rooms.begin(), rooms.begin() + 3))
+            + g->addVertices({ rooms[2], rooms[3] });
+        int numEdgesAdded = g->addEdges({ { rooms[0], rooms[1], 2.0, nullptr }, { rooms[1], rooms[4], 3.0, nullptr },
+            { rooms[0], rooms[1], 4.0, nullptr } })
+            + g->addEdges(std::vector<Graph<int, int>::EdgeRecord>{ { rooms[4], rooms[0], 5.0, nullptr } });
+        //
+        pointsPossible++;
+        if (numVerticesAdded == 4 && numEdgesAdded == 3 && g->getNumVertices() == 5 && g->getNumEdges() == 3
+            && g->getVertexIndex(rooms[4]) == 4 && g->getEdgeWeight(rooms[0], rooms[1]) == 2.0
+            && g->getEdgeWeight(rooms[4], rooms[0]) == 5.0) {
+            pointsEarned++;
+        }
+        else {
+            sout << "adding temporary or braced ranges went wrong" << std::endl;
+        }
+        delete g;
+        for (Vertex<int>* room : rooms) {
+            delete room;
+        }
+
+        std::cout << "GraphTester::test5 results:" << std::endl;
+        return new TestResults(pointsPossible, pointsEarned, sout.str());
+    }
+
+    /*
+     Collects the positions in rooms of the vertices visited by the specified
+     search, in order, with their depths.
+     */
+    static std::vector<std::pair<int, int>> collectSearch(GraphSearch<int, int>& search,
+        std::vector<Vertex<int>*>& rooms) {
+        std::vector<std::pair<int, int>> result;
+        for (Vertex<int>* vertex = search.next(); vertex != nullptr; vertex = search.next()) {
+            for (int k = 0; k < (int)rooms.size(); k++) {
+                if (rooms[k] == vertex) {
+                    result.push_back(std::make_pair(k, search.getDepth()));
+                }
+            }
+        }
+        return result;
+    }
+
+    static TestResults* test6() {
+        std::ostringstream sout;
+        int pointsPossible = 0;
+        int pointsEarned = 0;
+        //
+        // 0 -> 1 -> 3 -> 4 -> 0, 0 -> 2 -> 3, and 5 -> 6 on its own
+        Graph<int, int>* g = new Graph<int, int>(true);
+        std::vector<Vertex<int>*> rooms(7);
+        for (int k = 0; k < 7; k++) {
+            rooms[k] = new Vertex<int>();
+        }
+        int edgeList[][2] = { { 0, 1 }, { 0, 2 }, { 1, 3 }, { 2, 3 }, { 3, 4 }, { 4, 0 }, { 5, 6 } };
+        for (int k = 0; k < 7; k++) {
+            g->addEdge(rooms[edgeList[k][0]], rooms[edgeList[k][1]]);
+        }
+        GraphSearch<int, int> search(g);
+        typedef std::vector<std::pair<int, int>> Visits;
+        //
+        pointsPossible++;
+        search.beginBreadthFirst(rooms[0]);
+        Visits breadthFirst = collectSearch(search, rooms);
+        search.beginBreadthFirst(rooms[0], 2);
+        Visits limitedBreadthFirst = collectSearch(search, rooms);
+        if (breadthFirst == Visits({ { 0, 0 }, { 1, 1 }, { 2, 1 }, { 3, 2 }, { 4, 3 } })
+            && limitedBreadthFirst == Visits({ { 0, 0 }, { 1, 1 }, { 2, 1 }, { 3, 2 } })) {
+            pointsEarned++;
+        }
+        else {
+            sout << "breadth-first search visited the wrong vertices" << std::endl;
+        }
+        //
+        pointsPossible++;
+        search.beginDepthFirst(rooms[0]);
+        Visits depthFirst = collectSearch(search, rooms);
+        search.beginDepthFirst(rooms[0], 1);
+        Visits limitedDepthFirst = collectSearch(search, rooms);
+        if (depthFirst == Visits({ { 0, 0 }, { 1, 1 }, { 3, 2 }, { 4, 3 }, { 2, 1 } })
+            && limitedDepthFirst == Visits({ { 0, 0 }, { 1, 1 }, { 2, 1 } })) {
+            pointsEarned++;
+        }
+        else {
+            sout << "depth-first search visited the wrong vertices" << std::endl;
+        }
+        //
+        pointsPossible++;
+        int lastDepth = -1;
+        int numVisited = search.breadthFirst(rooms[0], [&](Vertex<int>* room, int depth) {
+            lastDepth = depth;
+            return room != rooms[3];
+        });
+        int numFromOther = search.depthFirst(rooms[5], [](Vertex<int>*, int) { return true; });
+        bool startedAfresh = !search.isVisited(rooms[0]) && search.isVisited(rooms[6]);
+        Vertex<int>* stranger = new Vertex<int>();
+        int numFromStranger = search.breadthFirst(stranger, [](Vertex<int>*, int) { return true; });
+        if (numVisited == 4 && lastDepth == 2 && numFromOther == 2 && startedAfresh
+            && numFromStranger == -1 && search.next() == nullptr) {
+            pointsEarned++;
+        }
+        else {
+            sout << "visitors didn't stop, or searches didn't start afresh" << std::endl;
+        }
+        //
+        pointsPossible++;
+        if (search.getDistance(rooms[0], rooms[4]) == 3 && search.getDistance(rooms[4], rooms[3]) == 3
+            && search.getDistance(rooms[2], rooms[2]) == 0 && search.isReachable(rooms[0], rooms[4], 3)
+            && !search.isReachable(rooms[0], rooms[4], 2) && !search.isReachable(rooms[0], rooms[5])
+            && !search.isReachable(rooms[0], stranger) && !search.isReachable(stranger, rooms[0])) {
+            pointsEarned++;
+        }
+        else {
+            sout << "the wrong distances were found" << std::endl;
+        }
+        delete stranger;
+        delete g;
+
+        std::cout << "GraphTester::test6 results:" << std::endl;
+        return new TestResults(pointsPossible, pointsEarned, sout.str());
+    }
+
+    static TestResults* test7() {
+        std::ostringstream sout;
+        int pointsPossible = 0;
+        int pointsEarned = 0;
+        //
+        const int numIds = 500;
+        IndexedHeap<double, 4> heap;
+        std::vector<double> priorities(numIds);
+        unsigned int seed = 61;
+        for (int id = 0; id < numIds; id++) {
+            seed = seed * 1103515245 + 12345;
+            priorities[id] = (seed >> 8) % 1000;
+            heap.push(id, priorities[id]);
+        }
+        // lower some priorities, raise others, and leave the rest
+        int numDecreased = 0;
+        for (int id = 0; id < numIds; id += 3) {
+            seed = seed * 1103515245 + 12345;
+            double priority = (double)((seed >> 8) % 1000);
+            if (heap.decreasePriority(id, priority)) {
+                numDecreased++;
+            }
+            if (priority < priorities[id]) {
+                priorities[id] = priority;
+            }
+        }
+        for (int id = 1; id < numIds; id += 7) {
+            priorities[id] += 500;
+            heap.push(id, priorities[id]);
+        }
+        //
+        pointsPossible++;
+        std::vector<double> popped;
+        bool sameIds = heap.getSize() == numIds && numDecreased > 0 && heap.contains(7) && !heap.contains(numIds);
+        while (!heap.isEmpty()) {
+            double priority = heap.peekMinPriority();
+            int id = heap.pop();
+            if (priority != priorities[id] || heap.contains(id)) {
+                sameIds = false;
+            }
+            popped.push_back(priority);
+        }
+        if (sameIds && popped.size() == numIds && std::is_sorted(popped.begin(), popped.end()) && heap.pop() == -1) {
+            pointsEarned++;
+        }
+        else {
+            sout << "the heap popped ids in the wrong order" << std::endl;
+        }
+        //
+        pointsPossible++;
+        heap.push(3, 5.0);
+        heap.push(1000, 2.0);
+        heap.push(4, 9.0);
+        heap.clear();
+        heap.push(4, 1.0);
+        if (heap.getSize() == 1 && !heap.contains(3) && !heap.contains(1000) && heap.getIdRange() >= 1001
+            && heap.peekMin() == 4 && !heap.decreasePriority(4, 1.0) && !heap.push(-1, 0.0)) {
+            pointsEarned++;
+        }
+        else {
+            sout << "the heap didn't clear properly" << std::endl;
+        }
+
+        std::cout << "GraphTester::test7 results:" << std::endl;
+        return new TestResults(pointsPossible, pointsEarned, sout.str());
+    }
+
+    static TestResults* test8() {
+        std::ostringstream sout;
+        int pointsPossible = 0;
+        int pointsEarned = 0;
+        //
+        const int numVertices = 40;
+        Graph<int, int>* g = new Graph<int, int>(true);
+        std::vector<Vertex<int>*> rooms(numVertices);
+        for (int k = 0; k < numVertices; k++) {
+            rooms[k] = new Vertex<int>();
+            g->addVertex(rooms[k]);
+        }
+        // room numVertices - 1 can't be reached from anywhere
+        double infinity = std::numeric_limits<double>::infinity();
+        std::vector<std::vector<double>> shortest(numVertices, std::vector<double>(numVertices, infinity));
+        unsigned int seed = 67;
+        for (int k = 0; k < 160; k++) {
+            seed = seed * 1103515245 + 12345;
+            int from = (seed >> 8) % numVertices;
+            int to = (seed >> 16) % (numVertices - 1);
+            double weight = (double)((seed >> 4) % 10);
+            if (!g->hasEdge(rooms[from], rooms[to])) {
+                g->addEdge(rooms[from], rooms[to]);
+                g->setEdgeWeight(weight, rooms[from], rooms[to]);
+                shortest[from][to] = std::min(shortest[from][to], weight);
+            }
+        }
+        for (int k = 0; k < numVertices; k++) {
+            shortest[k][k] = 0;
+        }
+        for (int via = 0; via < numVertices; via++) {
+            for (int from = 0; from < numVertices; from++) {
+                for (int to = 0; to < numVertices; to++) {
+                    shortest[from][to] = std::min(shortest[from][to], shortest[from][via] + shortest[via][to]);
+                }
+            }
+        }
+        PathFinder<int, int> paths(g);
+        std::vector<Vertex<int>*> path;
+        //
+        pointsPossible++;
+        bool sameLengths = true;
+        for (int from = 0; from < numVertices; from++) {
+            for (int to = 0; to < numVertices; to++) {
+                double length = paths.findPath(rooms[from], rooms[to]);
+                if (shortest[from][to] == infinity ? !std::isnan(length) : length != shortest[from][to]) {
+                    sameLengths = false;
+                }
+            }
+        }
+        if (sameLengths) {
+            pointsEarned++;
+        }
+        else {
+            sout << "Dijkstra found the wrong path lengths" << std::endl;
+        }
+        //
+        pointsPossible++;
+        bool samePaths = true;
+        int dijkstraSettled = 0;
+        int aStarSettled = 0;
+        for (int from = 0; from < numVertices; from++) {
+            for (int to = 0; to < numVertices; to++) {
+                if (shortest[from][to] == infinity) {
+                    continue;
+                }
+                paths.findPath(rooms[from], rooms[to]);
+                dijkstraSettled += paths.getNumSettled();
+                // half the true distance never overestimates
+                double length = paths.findPath(rooms[from], rooms[to], [&](Vertex<int>* vertex) {
+                    for (int k = 0; k < numVertices; k++) {
+                        if (rooms[k] == vertex) {
+                            return shortest[k][to] / 2;
+                        }
+                    }
+                    return 0.0;
+                });
+                aStarSettled += paths.getNumSettled();
+                int numSteps = paths.getPath(path);
+                double pathWeight = 0;
+                for (int k = 1; k < numSteps; k++) {
+                    pathWeight += g->getEdgeWeight(path[k - 1], path[k]);
+                }
+                if (length != shortest[from][to] || numSteps < 1 || path[0] != rooms[from] || path[numSteps - 1] != rooms[to]
+                    || pathWeight != length || paths.getNextStep() != (numSteps > 1 ? path[1] : nullptr)) {
+                    samePaths = false;
+                }
+            }
+        }
+        if (samePaths && aStarSettled < dijkstraSettled) {
+            pointsEarned++;
+        }
+        else {
+            sout << "A* found the wrong paths, or settled " << aStarSettled << " vertices to Dijkstra's "
+                << dijkstraSettled << std::endl;
+        }
+        //
+        pointsPossible++;
+        Vertex<int>* stranger = new Vertex<int>();
+        double unreachable = paths.findPath(rooms[0], rooms[numVertices - 1]);
+        List<Vertex<int>>* pathList = paths.getPathList();
+        if (std::isnan(unreachable) && std::isnan(paths.getPathLength()) && paths.getPath(path) == 0 && path.empty()
+            && paths.getNextStep() == nullptr && pathList->isEmpty() && std::isnan(paths.findPath(stranger, rooms[0]))
+            && std::isnan(paths.findPath(rooms[0], stranger))) {
+            pointsEarned++;
+        }
+        else {
+            sout << "a path was found where there is none" << std::endl;
+        }
+        delete pathList;
+        delete stranger;
+        delete g;
+
+        std::cout << "GraphTester::test8 results:" << std::endl;
+        return new TestResults(pointsPossible, pointsEarned, sout.str());
+    }
+
+    static TestResults* test9() {
+        std::ostringstream sout;
+        int pointsPossible = 0;
+        int pointsEarned = 0;
+        //
+        // a dense random graph, so the search goes bottom-up, plus a tail of
+        // rooms in a line, so it comes back top-down
+        const int numVertices = 5000;
+        const int tailLength = 50;
+        Graph<int, int>* g = new Graph<int, int>(true);
+        std::vector<Vertex<int>*> rooms(numVertices + tailLength);
+        for (int k = 0; k < numVertices + tailLength; k++) {
+            rooms[k] = new Vertex<int>();
+        }
+        std::vector<Graph<int, int>::EdgeRecord> records;
+        unsigned int seed = 89;
+        for (int k = 0; k < 8 * numVertices; k++) {
+            seed = seed * 1103515245 + 12345;
+            int from = (seed >> 4) % numVertices;
+            seed = seed * 1103515245 + 12345;
+            int to = (seed >> 4) % numVertices;
+            records.push_back({ rooms[from], rooms[to], 1.0, nullptr });
+        }
+        for (int k = numVertices - 1; k < numVertices + tailLength - 1; k++) {
+            records.push_back({ rooms[k], rooms[k + 1], 1.0, nullptr });
+        }
+        g->addVertices(rooms);
+        g->addEdges(records);
+        FrozenGraph<int, int>* frozen = g->freeze();
+        GraphSearch<int, int> search(g);
+        std::vector<int> expectedDepths(numVertices + tailLength, -1);
+        int expectedReached = search.breadthFirst(rooms[0], [&](Vertex<int>* room, int depth) {
+            expectedDepths[frozen->getVertexId(room)] = depth;
+            return true;
+        });
+        ParallelBfs<int, int> bfs(frozen);
+        //
+        pointsPossible++;
+        bool sameTrees = true;
+        int numBottomUpLevels = 0;
+        for (int numThreads = 1; numThreads <= 4; numThreads *= 2) {
+            for (int optimizing = 0; optimizing < 2; optimizing++) {
+                bfs.setNumThreads(numThreads);
+                bfs.setDirectionOptimizing(optimizing == 1);
+                int reached = bfs.run(rooms[0]);
+                numBottomUpLevels += bfs.getNumBottomUpLevels();
+                const std::vector<int>& depths = bfs.getDepths();
+                const std::vector<int>& parents = bfs.getParents();
+                if (reached != expectedReached || depths != expectedDepths || parents[0] != 0) {
+                    sameTrees = false;
+                }
+                for (int id = 1; id < numVertices + tailLength; id++) {
+                    if (depths[id] >= 0 && (depths[parents[id]] != depths[id] - 1 || !frozen->hasEdge(parents[id], id))) {
+                        sameTrees = false;
+                    }
+                    if (depths[id] < 0 && parents[id] != -1) {
+                        sameTrees = false;
+                    }
+                }
+            }
+        }
+        if (sameTrees) {
+            pointsEarned++;
+        }
+        else {
+            sout << "the parallel search found the wrong depths or parents" << std::endl;
+        }
+        //
+        pointsPossible++;
+        bfs.setDirectionOptimizing(true);
+        int fromTail = bfs.run(rooms[numVertices + tailLength - 2]);
+        if (numBottomUpLevels > 0 && bfs.getNumTopDownLevels() == 2 && fromTail == 2
+            && bfs.getDepths()[0] == -1 && bfs.run(-1) == -1 && bfs.run(numVertices + tailLength) == -1) {
+            pointsEarned++;
+        }
+        else {
+            sout << "the parallel search went the wrong direction or didn't start afresh" << std::endl;
+        }
+        delete frozen;
+        delete g;
+
+        std::cout << "GraphTester::test9 results:" << std::endl;
+        return new TestResults(pointsPossible, pointsEarned, sout.str());
+    }
+
+    /*
+     Returns true if the two component finders put the same pairs of the
+     specified vertices together, and agree on which vertices are in sinks.
+     */
+    static bool sameComponents(StrongComponents<int, int>& first, StrongComponents<int, int>& second,
+        std::vector<Vertex<int>*>& rooms) {
+        for (size_t a = 0; a < rooms.size(); a++) {
+            int firstA = first.getComponentId(rooms[a]);
+            int secondA = second.getComponentId(rooms[a]);
+            if (first.isSink(firstA) != second.isSink(secondA)) {
+                return false;
+            }
+            for (size_t b = a + 1; b < rooms.size(); b++) {
+                if ((firstA == first.getComponentId(rooms[b])) != (secondA == second.getComponentId(rooms[b]))) {
+                    return false;
+                }
+            }
+        }
+        return first.getNumComponents() == second.getNumComponents();
+    }
+
+    static TestResults* test10() {
+        std::ostringstream sout;
+        int pointsPossible = 0;
+        int pointsEarned = 0;
+        //
+        const int numVertices = 60;
+        Graph<int, int>* g = new Graph<int, int>(true);
+        std::vector<Vertex<int>*> rooms(numVertices);
+        for (int k = 0; k < numVertices; k++) {
+            rooms[k] = new Vertex<int>();
+            g->addVertex(rooms[k]);
+        }
+        unsigned int seed = 97;
+        for (int k = 0; k < 80; k++) {
+            seed = seed * 1103515245 + 12345;
+            g->addEdge(rooms[(seed >> 8) % numVertices], rooms[(seed >> 16) % numVertices]);
+        }
+        StrongComponents<int, int> components(g);
+        int numComponents = components.compute();
+        GraphSearch<int, int> search(g);
+        //
+        pointsPossible++;
+        bool sameAsReachability = numComponents == components.getNumComponents() && numComponents > 1;
+        int totalSize = 0;
+        for (int c = 0; c < numComponents; c++) {
+            totalSize += components.getComponentSize(c);
+        }
+        for (int a = 0; a < numVertices; a++) {
+            for (int b = 0; b < numVertices; b++) {
+                bool together = search.isReachable(rooms[a], rooms[b]) && search.isReachable(rooms[b], rooms[a]);
+                if (together != components.isStronglyConnected(rooms[a], rooms[b])) {
+                    sameAsReachability = false;
+                }
+            }
+        }
+        if (sameAsReachability && totalSize == numVertices) {
+            pointsEarned++;
+        }
+        else {
+            sout << "the components don't match mutual reachability" << std::endl;
+        }
+        //
+        pointsPossible++;
+        bool sameCondensation = true;
+        int numSinks = 0;
+        for (int c = 0; c < numComponents; c++) {
+            for (int successor : components.getSuccessors(c)) {
+                const std::vector<int>& backEdges = components.getPredecessors(successor);
+                if (successor >= c || !std::binary_search(backEdges.begin(), backEdges.end(), c)) {
+                    sameCondensation = false;
+                }
+            }
+            numSinks += components.isSink(c) ? 1 : 0;
+        }
+        for (Edge<int, int>* edge : *g->getEdges()) {
+            int from = components.getComponentId(edge->getInitialVertex());
+            int to = components.getComponentId(edge->getTerminalVertex());
+            const std::vector<int>& condensed = components.getSuccessors(from);
+            if (from != to && !std::binary_search(condensed.begin(), condensed.end(), to)) {
+                sameCondensation = false;
+            }
+        }
+        List<Vertex<int>>* trapped = components.getTrappedVertices(components.getComponentId(rooms[0]));
+        for (Vertex<int>* room : *trapped) {
+            if (!components.isSink(components.getComponentId(room)) || components.isStronglyConnected(room, rooms[0])) {
+                sameCondensation = false;
+            }
+        }
+        if (sameCondensation && numSinks > 0 && components.isSink(0) && !trapped->isEmpty()) {
+            pointsEarned++;
+        }
+        else {
+            sout << "the condensation is wrong" << std::endl;
+        }
+        delete trapped;
+        //
+        pointsPossible++;
+        StrongComponents<int, int> recomputed(g);
+        bool sameIncrementally = true;
+        int numMerges = 0;
+        for (int k = 0; k < 120; k++) {
+            seed = seed * 1103515245 + 12345;
+            Vertex<int>* from = rooms[(seed >> 8) % numVertices];
+            Vertex<int>* to = rooms[(seed >> 16) % numVertices];
+            if (k % 10 == 0) {
+                // a new room, joined to the rest
+                Vertex<int>* room = new Vertex<int>();
+                rooms.push_back(room);
+                to = room;
+            }
+            if (components.addEdge(from, to) > 0) {
+                numMerges++;
+            }
+            recomputed.compute();
+            if (!sameComponents(components, recomputed, rooms)) {
+                sameIncrementally = false;
+            }
+        }
+        if (sameIncrementally && numMerges > 0 && components.addEdge(rooms[0], rooms[0]) == 0) {
+            pointsEarned++;
+        }
+        else {
+            sout << "incremental updates disagree with recomputing" << std::endl;
+        }
+        delete g;
+        //
+        // a path far longer than a recursive search's stack could follow,
+        // closed into one cycle
+        pointsPossible++;
+        const int pathLength = 300000;
+        Graph<int, int>* path = new Graph<int, int>(true);
+        std::vector<Vertex<int>*> pathRooms(pathLength);
+        std::vector<Graph<int, int>::EdgeRecord> records(pathLength - 1);
+        for (int k = 0; k < pathLength; k++) {
+            pathRooms[k] = new Vertex<int>();
+            if (k > 0) {
+                records[k - 1] = { pathRooms[k - 1], pathRooms[k], 1.0, nullptr };
+            }
+        }
+        path->addVertices(pathRooms);
+        path->addEdges(records);
+        StrongComponents<int, int> pathComponents(path);
+        int numOnPath = pathComponents.compute();
+        bool linedUp = pathComponents.getComponentId(pathRooms[0]) == pathLength - 1
+            && pathComponents.isSink(pathComponents.getComponentId(pathRooms[pathLength - 1]));
+        int merged = pathComponents.addEdge(pathRooms[pathLength - 1], pathRooms[0]);
+        if (numOnPath == pathLength && linedUp && merged == pathLength && pathComponents.getNumComponents() == 1
+            && pathComponents.getComponentSize(pathComponents.getComponentId(pathRooms[7])) == pathLength) {
+            pointsEarned++;
+        }
+        else {
+            sout << "a long path wasn't handled" << std::endl;
+        }
+        delete path;
+
+        std::cout << "GraphTester::test10 results:" << std::endl;
+        return new TestResults(pointsPossible, pointsEarned, sout.str());
+    }
+
+    /*
+     Builds a random graph on the specified container, removes random edges
+     and then random vertices from it, and checks after each removal that
+     the graph agrees with a plain record of which edges should remain.
+     */
+    template <template <typename> class Container>
+    static bool removalsMatch(std::ostringstream& sout) {
+        const int numVertices = 30;
+        Graph<int, int, Container>* g = new Graph<int, int, Container>(true);
+        std::vector<Vertex<int>*> rooms(numVertices);
+        for (int k = 0; k < numVertices; k++) {
+            rooms[k] = new Vertex<int>();
+            rooms[k]->setData(new int(k));
+            g->addVertex(rooms[k]);
+        }
+        // weights[a][b] is the weight of the edge from room a to room b, or -1
+        std::vector<std::vector<double>> weights(numVertices, std::vector<double>(numVertices, -1));
+        unsigned int seed = 103;
+        for (int k = 0; k < 200; k++) {
+            seed = seed * 1103515245 + 12345;
+            int from = (seed >> 8) % numVertices;
+            int to = (seed >> 16) % numVertices;
+            if (!g->hasEdge(rooms[from], rooms[to])) {
+                g->addEdge(rooms[from], rooms[to]);
+                g->setEdgeWeight(k, rooms[from], rooms[to]);
+                g->storeInEdge(new int(k), rooms[from], rooms[to]);
+                weights[from][to] = k;
+            }
+        }
+        std::vector<bool> present(numVertices, true);
+        bool matches = true;
+        for (int step = 0; step < 150 && matches; step++) {
+            seed = seed * 1103515245 + 12345;
+            int from = (seed >> 8) % numVertices;
+            int to = (seed >> 16) % numVertices;
+            if (step < 120) {
+                bool removed = present[from] && present[to] && g->removeEdge(rooms[from], rooms[to]);
+                if (removed != (present[from] && present[to] && weights[from][to] >= 0)) {
+                    sout << "removeEdge returned " << removed << " for an edge that was "
+                        << (weights[from][to] >= 0 ? "present" : "absent") << std::endl;
+                    matches = false;
+                }
+                weights[from][to] = -1;
+            }
+            else if (present[from]) {
+                if (!g->removeVertex(rooms[from]) || g->removeVertex(rooms[from])) {
+                    sout << "removeVertex didn't remove the vertex exactly once" << std::endl;
+                    matches = false;
+                }
+                present[from] = false;
+                for (int k = 0; k < numVertices; k++) {
+                    weights[from][k] = -1;
+                    weights[k][from] = -1;
+                }
+            }
+
+            int numPresent = 0;
+            int numEdges = 0;
+            for (int a = 0; a < numVertices; a++) {
+                if (!present[a]) {
+                    continue;
+                }
+                numPresent++;
+                int index = g->getVertexIndex(rooms[a]);
+                int outDegree = 0;
+                int inDegree = 0;
+                for (int b = 0; b < numVertices; b++) {
+                    if (!present[b]) {
+                        continue;
+                    }
+                    int edgeIndex = g->getEdgeIndex(rooms[a], rooms[b]);
+                    if ((edgeIndex >= 0) != (weights[a][b] >= 0)
+                        || (edgeIndex >= 0 && (g->getEdgeWeight(edgeIndex) != weights[a][b]
+                            || *g->getEdgeData(edgeIndex) != (int)weights[a][b]
+                            || g->getEdges()->peek(edgeIndex)->getTerminalVertex() != rooms[b]))) {
+                        matches = false;
+                    }
+                    outDegree += weights[a][b] >= 0 ? 1 : 0;
+                    inDegree += weights[b][a] >= 0 ? 1 : 0;
+                }
+                numEdges += outDegree;
+                if (index < 0 || g->getVertex(index) != rooms[a] || *g->getVertexData(index) != a
+                    || g->getOutDegree(rooms[a]) != outDegree || g->getInDegree(rooms[a]) != inDegree) {
+                    matches = false;
+                }
+            }
+            if (g->getNumVertices() != numPresent || g->getNumEdges() != numEdges) {
+                matches = false;
+            }
+        }
+        delete g;
+        return matches;
+    }
+
+    static TestResults* test11() {
+        std::ostringstream sout;
+        int pointsPossible = 0;
+        int pointsEarned = 0;
+        //
+        pointsPossible++;
+        if (removalsMatch<List>(sout)) {
+            pointsEarned++;
+        }
+        else {
+            sout << "removal from a List-backed graph went wrong" << std::endl;
+        }
+        //
+        pointsPossible++;
+        if (removalsMatch<ArrayList>(sout)) {
+            pointsEarned++;
+        }
+        else {
+            sout << "removal from an ArrayList-backed graph went wrong" << std::endl;
+        }
+        //
+        pointsPossible++;
+        Graph<int, int>* g = new Graph<int, int>();
+        Vertex<int>* room = new Vertex<int>();
+        Vertex<int>* other = new Vertex<int>();
+        g->addEdge(room, room);
+        g->addEdge(room, other);
+        bool loopRemoved = g->removeVertex(room) && g->getNumEdges() == 0 && g->getNumVertices() == 1
+            && room->getOutDegree() == 0 && room->getInDegree() == 0 && other->getInDegree() == 0;
+        if (loopRemoved && !g->removeEdge(room, other) && !g->removeVertex(room)) {
+            pointsEarned++;
+        }
+        else {
+            sout << "a vertex with a loop wasn't removed cleanly" << std::endl;
+        }
+        delete g;
+        delete room;
+        delete other;
+        // a hub joined both ways to a ring of rooms, losing edges and rooms in a
+        // scattered order, must keep every adjacency entry matched to its edge
+        pointsPossible++;
+        const int numSpokes = 200;
+        g = new Graph<int, int>();
+        Vertex<int>* hub = new Vertex<int>();
+        std::vector<Vertex<int>*> spokes(numSpokes);
+        for (int k = 0; k < numSpokes; k++) {
+            spokes[k] = new Vertex<int>();
+            g->addEdge(hub, spokes[k]);
+            g->addEdge(spokes[k], hub);
+        }
+        for (int k = 0; k < numSpokes; k++) {
+            g->addEdge(spokes[k], spokes[(k + 1) % numSpokes]);
+        }
+        unsigned int seed = 17;
+        for (int k = 0; k < numSpokes / 2; k++) {
+            seed = seed * 1103515245 + 12345;
+            Vertex<int>* spoke = spokes[(seed >> 8) % numSpokes];
+            if (k % 3 == 0) {
+                g->removeVertex(spoke);
+            }
+            else {
+                g->removeEdge(hub, spoke);
+                g->removeEdge(spoke, spokes[((seed >> 8) + 1) % numSpokes]);
+            }
+        }
+        bool consistent = true;
+        int numOut = 0;
+        int numIn = 0;
+        for (Vertex<int>* vertex : *g->getVertices()) {
+            for (int k = 0; k < vertex->getOutDegree(); k++) {
+                int index = g->getEdgeIndex(vertex, vertex->getOutVertex(k));
+                if (index < 0 || g->getEdges()->peek(index)->getOutPosition() != k) {
+                    consistent = false;
+                }
+            }
+            for (int k = 0; k < vertex->getInDegree(); k++) {
+                if (!g->hasEdge(vertex->getInVertex(k), vertex)) {
+                    consistent = false;
+                }
+            }
+            numOut += vertex->getOutDegree();
+            numIn += vertex->getInDegree();
+        }
+        if (consistent && numOut == g->getNumEdges() && numIn == g->getNumEdges() && g->getNumEdges() < 3 * numSpokes) {
+            pointsEarned++;
+        }
+        else {
+            sout << "removal around a hub left the adjacency out of step with the edges" << std::endl;
+        }
+        delete g;
+        delete hub;
+        for (Vertex<int>* spoke : spokes) {
+            delete spoke;
+        }
+
+        std::cout << "GraphTester::test11 results:" << std::endl;
+        return new TestResults(pointsPossible, pointsEarned, sout.str());
+    }
+
+    static TestResults* test12() {
+        std::ostringstream sout;
+        int pointsPossible = 0;
+        int pointsEarned = 0;
+        const std::string path = "GraphTester_world.img";
+        Graph<List<std::string>, List<std::string>>* world = new Graph<List<std::string>, List<std::string>>(true);
+        Vertex<List<std::string>>* rooms[3];
+        for (int k = 0; k < 3; k++) {
+            rooms[k] = new Vertex<List<std::string>>();
+            world->addVertex(rooms[k]);
+        }
+        List<std::string>* story = new List<std::string>();
+        story->setOwnsData(true);
+        story->insertAtEnd(new std::string("A dragon sleeps here."));
+        story->insertAtEnd(new std::string(""));
+        story->insertAtEnd(new std::string("Gold glitters."));
+        world->storeInVertex(story, 0);
+        List<std::string>* emptyStory = new List<std::string>();
+        emptyStory->setOwnsData(true);
+        world->storeInVertex(emptyStory, 1);
+        List<std::string>* doorStory = new List<std::string>();
+        doorStory->setOwnsData(true);
+        doorStory->insertAtEnd(new std::string("The door creaks."));
+        int doors[4][2] = { { 2, 0 }, { 0, 1 }, { 0, 2 }, { 1, 2 } };
+        double lengths[4] = { 1.0, 2.5, 4.0, 0.5 };
+        for (int k = 0; k < 4; k++) {
+            world->addEdge(rooms[doors[k][0]], rooms[doors[k][1]]);
+            world->setEdgeWeight(lengths[k], rooms[doors[k][0]], rooms[doors[k][1]]);
+        }
+        world->storeInEdge(doorStory, rooms[0], rooms[1]);
+        //
+        pointsPossible++;
+        WorldImage* image = WorldImage::write(world, path) ? WorldImage::open(path) : nullptr;
+        if (image != nullptr && image->getNumVertices() == 3 && image->getNumEdges() == 4
+            && image->getOutDegree(0) == 2 && image->getOutDegree(2) == 1 && image->getOutDegree(3) == -1
+            && image->getEdgeWeight(image->findEdge(0, 1)) == 2.5 && image->getEdgeWeight(image->findEdge(1, 2)) == 0.5
+            && image->getNeighbors(2)[0] == 0 && image->getNeighborWeights(2)[0] == 1.0 && image->findEdge(1, 0) == -1
+            && image->verifyChecksum()) {
+            pointsEarned++;
+        }
+        else {
+            sout << "the rooms and edges of the world didn't survive the round trip" << std::endl;
+        }
+        //
+        pointsPossible++;
+        if (image != nullptr && image->hasStory(0) && image->getNumStoryLines(0) == 3
+            && image->getStoryLine(0, 0) == "A dragon sleeps here." && image->getStoryLine(0, 1).empty()
+            && image->getStoryLine(0, 2) == "Gold glitters." && image->hasStory(1) && image->getNumStoryLines(1) == 0
+            && !image->hasStory(2) && image->edgeHasStory(image->findEdge(0, 1))
+            && image->getEdgeStoryLine(image->findEdge(0, 1), 0) == "The door creaks." && !image->edgeHasStory(image->findEdge(0, 2))) {
+            pointsEarned++;
+        }
+        else {
+            sout << "the story lines of the world didn't survive the round trip" << std::endl;
+        }
+        //
+        pointsPossible++;
+        Graph<List<std::string>, List<std::string>>* copy = image != nullptr ? image->toGraph() : nullptr;
+        bool copied = copy != nullptr && copy->getNumVertices() == 3 && copy->getNumEdges() == 4
+            && copy->getVertexData(1) != nullptr && copy->getVertexData(1)->getSize() == 0 && copy->getVertexData(2) == nullptr
+            && *copy->getVertexData(0)->peek(2) == "Gold glitters.";
+        if (copied) {
+            Vertex<List<std::string>>* lair = copy->getVertices()->peek(0);
+            Vertex<List<std::string>>* hall = copy->getVertices()->peek(1);
+            copied = copy->getEdgeWeight(lair, hall) == 2.5 && *copy->getEdgeData(lair, hall)->peek(0) == "The door creaks.";
+        }
+        StringArena text;
+        Graph<List<std::string_view>, List<std::string_view>>* interned = image != nullptr ? image->toGraph(&text) : nullptr;
+        copied = copied && interned != nullptr && interned->getNumEdges() == 4 && interned->getVertexData(2) == nullptr
+            && *interned->getVertexData(0)->peek(0) == "A dragon sleeps here." && text.getNumStrings() == 4;
+        if (copied) {
+            pointsEarned++;
+        }
+        else {
+            sout << "toGraph didn't reproduce the world" << std::endl;
+        }
+        delete interned;
+        delete copy;
+        delete image;
+        //
+        pointsPossible++;
+        std::string bytes;
+        {
+            std::ifstream in(path, std::ios::binary);
+            std::ostringstream contents;
+            contents << in.rdbuf();
+            bytes = contents.str();
+        }
+        auto rewrite = [&](const std::string& newBytes) {
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            out.write(newBytes.data(), (std::streamsize)newBytes.size());
+        };
+        std::string corrupted = bytes;
+        corrupted[corrupted.size() - 9] ^= 0x20;
+        rewrite(corrupted);
+        image = WorldImage::open(path);
+        bool detected = image != nullptr && !image->verifyChecksum();
+        delete image;
+        std::string badMagic = bytes;
+        badMagic[0] = 'X';
+        rewrite(badMagic);
+        image = WorldImage::open(path);
+        detected = detected && image == nullptr;
+        rewrite(bytes.substr(0, bytes.size() - 8));
+        image = WorldImage::open(path);
+        detected = detected && image == nullptr;
+        // an edge to a room that doesn't exist, and story lines out of order
+        WorldImage::Header header;
+        std::memcpy(&header, bytes.data(), sizeof(header));
+        std::string badTarget = bytes;
+        uint32_t farRoom = 1000000;
+        std::memcpy(&badTarget[header.edgeTargetsOffset], &farRoom, sizeof(farRoom));
+        rewrite(badTarget);
+        image = WorldImage::open(path);
+        bool indexesChecked = image == nullptr;
+        image = WorldImage::open(path, false);
+        indexesChecked = indexesChecked && image != nullptr && !image->validate() && image->toGraph() == nullptr;
+        delete image;
+        std::string badLines = bytes;
+        uint64_t farLine = header.textSize;
+        std::memcpy(&badLines[header.lineOffsetsOffset + sizeof(uint64_t)], &farLine, sizeof(farLine));
+        rewrite(badLines);
+        image = WorldImage::open(path);
+        indexesChecked = indexesChecked && image == nullptr;
+        std::remove(path.c_str());
+        detected = detected && WorldImage::open(path) == nullptr;
+        if (detected) {
+            pointsEarned++;
+        }
+        else {
+            sout << "a damaged or missing world image wasn't detected" << std::endl;
+        }
+        //
+        pointsPossible++;
+        if (indexesChecked) {
+            pointsEarned++;
+        }
+        else {
+            sout << "a world image with a corrupt index entry wasn't rejected" << std::endl;
+        }
+        delete world;
+
+        std::cout << "GraphTester::test12 results:" << std::endl;
+        return new TestResults(pointsPossible, pointsEarned, sout.str());
+    }
+
+    /*
+     Loads the specified world description with a small chunk size, so
+     lines cross chunk boundaries, and returns the graph or the null
+     pointer.
+     */
+    static Graph<List<std::string_view>, List<std::string_view>>* loadWorld(WorldLoader& loader, const std::string& text) {
+        std::istringstream in(text);
+        return loader.load(in);
+    }
+
+    static TestResults* test13() {
+        std::ostringstream sout;
+        int pointsPossible = 0;
+        int pointsEarned = 0;
+        StringArena storyText;
+        WorldLoader loader(&storyText, 16);
+        //
+        pointsPossible++;
+        std::string text =
+            "# the start\n"
+            "room lair\n"
+            "  | A dragon sleeps here.\n"
+            "|\n"
+            "\t|  Gold glitters.\r\n"
+            "exit lair tunnel 2.5\n"
+            "| The crack is narrow.\n"
+            "room tunnel\n"
+            "exit tunnel lair\n"
+            "room vault\n"
+            "| A dragon sleeps here.\n"
+            "exit vault vault 0";
+        Graph<List<std::string_view>, List<std::string_view>>* world = loadWorld(loader, text);
+        bool loaded = world != nullptr && world->getNumVertices() == 3 && world->getNumEdges() == 3
+            && loader.getErrorMessage().empty() && loader.getNumLinesRead() == 12;
+        if (loaded) {
+            Vertex<List<std::string_view>>* lair = world->getVertex(0);
+            Vertex<List<std::string_view>>* tunnel = world->getVertex(1);
+            Vertex<List<std::string_view>>* vault = world->getVertex(2);
+            List<std::string_view>* story = lair->getData();
+            List<std::string_view>* crack = world->getEdgeData(lair, tunnel);
+            loaded = story != nullptr && story->getSize() == 3 && *story->peek(0) == "A dragon sleeps here."
+                && story->peek(1)->empty() && *story->peek(2) == " Gold glitters." && tunnel->getData() == nullptr
+                && world->getEdgeWeight(lair, tunnel) == 2.5 && world->getEdgeWeight(tunnel, lair) == 1
+                && world->getEdgeWeight(vault, vault) == 0 && crack != nullptr && crack->getSize() == 1
+                && *crack->peek(0) == "The crack is narrow." && world->getEdgeData(tunnel, lair) == nullptr
+                && vault->getData()->peek(0) == story->peek(0);
+        }
+        if (loaded) {
+            pointsEarned++;
+        }
+        else {
+            sout << "a valid world wasn't loaded as described" << std::endl;
+        }
+        delete world;
+        //
+        pointsPossible++;
+        std::string longLine(1000, 'x');
+        world = loadWorld(loader, "room a\n| " + longLine + "\nroom b");
+        if (world != nullptr && world->getNumVertices() == 2 && *world->getVertexData(0)->peek(0) == longLine) {
+            pointsEarned++;
+        }
+        else {
+            sout << "a line longer than the chunk size wasn't read whole" << std::endl;
+        }
+        delete world;
+        //
+        pointsPossible++;
+        struct BadWorld {
+            const char* text;
+            int line;
+            int column;
+        };
+        BadWorld badWorlds[] = {
+            { "room a\n| ok\nroom a\n", 3, 6 },
+            { "| too early\n", 1, 1 },
+            { "room a\n  door a\n", 2, 3 },
+            { "room a\nexit a\n", 2, 7 },
+            { "room a\nexit a a -1\n", 2, 10 },
+            { "room a\nexit a a 2x\n", 2, 10 },
+            { "room a b\n", 1, 8 },
+            { "room a\nexit a a\nexit a a 2\n", 3, 6 },
+            { "room a\n\nexit a b\nexit c a\n", 3, 8 },
+        };
+        bool reported = true;
+        for (BadWorld& bad : badWorlds) {
+            world = loadWorld(loader, bad.text);
+            if (world != nullptr || loader.getErrorLine() != bad.line || loader.getErrorColumn() != bad.column
+                || loader.getErrorMessage().empty()) {
+                sout << "error in \"" << bad.text << "\" reported at " << loader.getErrorLine() << ":"
+                    << loader.getErrorColumn() << " (" << loader.getErrorMessage() << ")" << std::endl;
+                reported = false;
+            }
+            delete world;
+        }
+        if (reported && loader.loadFile("GraphTester_no_such_world.txt") == nullptr
+            && loader.getErrorMessage().find("couldn't open") == 0) {
+            pointsEarned++;
+        }
+        else {
+            sout << "an invalid world wasn't reported where it went wrong" << std::endl;
+        }
+
+        std::cout << "GraphTester::test13 results:" << std::endl;
+        return new TestResults(pointsPossible, pointsEarned, sout.str());
+    }
+
+    /*
+     Applies the same random edge and vertex removals to a CompactGraph and
+     to a weight matrix (negative for no edge) and reports whether the
+     graph's edges, degrees and data match the matrix at the end. Vertex
+     data records each vertex's row so renumbered ids can be followed.
+     */
+    static bool compactRemovalsMatch(std::ostringstream& sout) {
+        const int numRooms = 12;
+        std::vector<std::vector<double>> weights(numRooms, std::vector<double>(numRooms, -1));
+        std::vector<int> rows(numRooms);
+        CompactGraph<int, int> g;
+        unsigned int seed = 23;
+        for (int a = 0; a < numRooms; a++) {
+            rows[a] = a;
+            g.addVertex(&rows[a]);
+        }
+        for (int k = 0; k < 60; k++) {
+            seed = seed * 1103515245 + 12345;
+            int a = (seed >> 8) % numRooms;
+            int b = (seed >> 16) % numRooms;
+            if (g.addEdge(a, b, k) >= 0) {
+                weights[a][b] = k;
+            }
+        }
+        for (int k = 0; k < 25; k++) {
+            seed = seed * 1103515245 + 12345;
+            int a = (seed >> 8) % g.getNumVertices();
+            int b = (seed >> 16) % g.getNumVertices();
+            if (k % 6 == 5) {
+                int row = *g.getVertexData(a);
+                for (int c = 0; c < numRooms; c++) {
+                    weights[row][c] = -1;
+                    weights[c][row] = -1;
+                }
+                g.removeVertex(a);
+            }
+            else if (g.removeEdge(a, b) != (weights[*g.getVertexData(a)][*g.getVertexData(b)] >= 0)) {
+                sout << "removeEdge(" << a << ", " << b << ") disagreed with the matrix" << std::endl;
+                return false;
+            }
+            else {
+                weights[*g.getVertexData(a)][*g.getVertexData(b)] = -1;
+            }
+        }
+        int numEdges = 0;
+        for (int a = 0; a < g.getNumVertices(); a++) {
+            int outDegree = 0;
+            int inDegree = 0;
+            for (int b = 0; b < g.getNumVertices(); b++) {
+                double weight = weights[*g.getVertexData(a)][*g.getVertexData(b)];
+                int edge = g.findEdge(a, b);
+                if ((edge >= 0) != (weight >= 0) || (edge >= 0 && (g.getEdgeWeight(edge) != weight
+                    || g.getEdgeFrom(edge) != a || g.getEdgeTo(edge) != b))) {
+                    return false;
+                }
+                outDegree += weight >= 0 ? 1 : 0;
+                inDegree += weights[*g.getVertexData(b)][*g.getVertexData(a)] >= 0 ? 1 : 0;
+            }
+            int walked = 0;
+            for (uint32_t e = g.getFirstOutEdge(a); e != g.NoEdge; e = g.getNextOutEdge(e)) {
+                walked += g.getEdgeFrom((int)e) == a ? 1 : 0;
+            }
+            if (g.getOutDegree(a) != outDegree || g.getInDegree(a) != inDegree || walked != outDegree) {
+                return false;
+            }
+            numEdges += outDegree;
+        }
+        return g.getNumEdges() == numEdges;
+    }
+
+    static TestResults* test14() {
+        std::ostringstream sout;
+        int pointsPossible = 0;
+        int pointsEarned = 0;
+        //
+        pointsPossible++;
+        Vertex<int>* from = new Vertex<int>();
+        Vertex<int>* to = new Vertex<int>();
+        Edge<int, int> edge(from, to);
+        Edge<int, int> copy(edge);
+        Edge<int, int> moved(std::move(copy));
+        if (edge.getInitialVertex() == from && edge.getTerminalVertex() == to
+            && edge.getVertexPair()->first == from && moved.getTerminalVertex() == to
+            && copy.getInitialVertex() == nullptr) {
+            pointsEarned++;
+        }
+        else {
+            sout << "an edge doesn't keep its vertex pair" << std::endl;
+        }
+        delete from;
+        delete to;
+        //
+        pointsPossible++;
+        Graph<int, int>* graph = new Graph<int, int>(true);
+        for (int k = 0; k < 4; k++) {
+            Vertex<int>* vertex = new Vertex<int>();
+            vertex->setData(new int(k));
+            graph->addVertex(vertex);
+        }
+        bool added = graph->addEdge(0, 1, 2.5) && graph->addEdge(1, 2) && graph->addEdge(2, 0, 4)
+            && graph->addEdge(3, 3, 0.5) && !graph->addEdge(0, 1) && !graph->addEdge(0, 4) && !graph->addEdge(-1, 0);
+        if (added && graph->getNumEdges() == 4 && graph->getVertexId(graph->getVertex(2)) == 2
+            && graph->hasEdge(0, 1) && !graph->hasEdge(1, 0) && graph->getEdgeWeight(0, 1) == 2.5
+            && graph->getEdgeWeight(1, 2) == 1 && std::isnan(graph->getEdgeWeight(1, 0))
+            && graph->setEdgeWeight(3, 1, 2) == 0 && graph->getEdgeWeight(1, 2) == 3 && graph->setEdgeWeight(3, 1, 3) < 0
+            && graph->getOutDegree(3) == 1 && graph->getInDegree(0) == 1 && graph->getOutDegree(4) < 0
+            && graph->removeEdge(2, 0) && !graph->removeEdge(2, 0) && graph->getInDegree(0) == 0 && graph->getNumEdges() == 3) {
+            pointsEarned++;
+        }
+        else {
+            sout << "the id-based Graph methods went wrong" << std::endl;
+        }
+        //
+        pointsPossible++;
+        CompactGraph<int, int>* compact = new CompactGraph<int, int>(graph);
+        bool copied = compact->getNumVertices() == 4 && compact->getNumEdges() == 3;
+        for (int a = 0; a < 4 && copied; a++) {
+            copied = *compact->getVertexData(a) == a && compact->getOutDegree(a) == graph->getOutDegree(a)
+                && compact->getInDegree(a) == graph->getInDegree(a);
+            for (int b = 0; b < 4 && copied; b++) {
+                int e = compact->findEdge(a, b);
+                copied = graph->hasEdge(a, b) ? e >= 0 && compact->getEdgeWeight(e) == graph->getEdgeWeight(a, b) : e < 0;
+            }
+        }
+        if (copied && compact->getEdgeData(0) == nullptr && compact->addEdge(1, 0) == 3 && compact->addEdge(1, 0) < 0
+            && compact->addEdge(0, 4) < 0 && std::isnan(compact->getEdgeWeight(4)) && compact->getEdgeFrom(-1) < 0) {
+            pointsEarned++;
+        }
+        else {
+            sout << "a CompactGraph doesn't match the Graph it was made from" << std::endl;
+            sout << compact->toString();
+        }
+        delete compact;
+        delete graph;
+        //
+        pointsPossible++;
+        if (compactRemovalsMatch(sout)) {
+            pointsEarned++;
+        }
+        else {
+            sout << "removal from a CompactGraph went wrong" << std::endl;
+        }
+        //
+        pointsPossible++;
+        CompactGraph<int, std::string, void> unweighted;
+        std::string label = "door";
+        unweighted.addVertex();
+        unweighted.addVertex();
+        int door = unweighted.addEdge(0, 1, 7);
+        bool weightless = unweighted.getEdgeWeight(door) == 1 && unweighted.setEdgeWeight(2, door) < 0;
+        bool dataKept = unweighted.setEdgeData(door, &label) == 0 && unweighted.getEdgeData(door) == &label
+            && unweighted.addEdge(1, 0) == 1 && unweighted.getEdgeData(1) == nullptr;
+        // removing the first edge moves the second into its id, data and all
+        if (sizeof(CompactEdge<void>) == 16 && sizeof(CompactEdge<float>) == 20 && weightless && dataKept
+            && unweighted.removeEdge(door) && unweighted.getNumEdges() == 1 && unweighted.getEdgeFrom(0) == 1
+            && unweighted.getEdgeData(0) == nullptr && unweighted.getInDegree(1) == 0) {
+            pointsEarned++;
+        }
+        else {
+            sout << "an unweighted CompactGraph went wrong" << std::endl;
+        }
+
+        std::cout << "GraphTester::test14 results:" << std::endl;
+        return new TestResults(pointsPossible, pointsEarned, sout.str());
+    }
+
+    static TestResults* test15() {
+        std::ostringstream sout;
+        int pointsPossible = 0;
+        int pointsEarned = 0;
+        Graph<int, int>* g = new Graph<int, int>(true);
+        Vertex<int>* rooms[4];
+        for (int k = 0; k < 4; k++) {
+            rooms[k] = new Vertex<int>();
+            g->addVertex(rooms[k]);
+        }
+        int doors[5][2] = { { 0, 1 }, { 0, 2 }, { 0, 3 }, { 2, 0 }, { 3, 0 } };
+        for (int k = 0; k < 5; k++) {
+            g->addEdge(rooms[doors[k][0]], rooms[doors[k][1]]);
+        }
+        Vertex<int>* stranger = new Vertex<int>();
+        //
+        pointsPossible++;
+        List<Vertex<int>>* outgoing = g->getOutgoingVertices(rooms[0]);
+        Graph<int, int>::NeighborRange range = g->getOutgoingRange(rooms[0]);
+        bool sameNeighbors = range.size() == 3 && !range.empty();
+        int position = 0;
+        for (Vertex<int>* neighbor : range) {
+            sameNeighbors = sameNeighbors && neighbor == outgoing->peek(position) && range[position] == neighbor;
+            position++;
+        }
+        delete outgoing;
+        if (sameNeighbors && position == 3 && g->getOutgoingRange(rooms[1]).empty()) {
+            pointsEarned++;
+        }
+        else {
+            sout << "the outgoing range doesn't match getOutgoingVertices" << std::endl;
+        }
+        //
+        pointsPossible++;
+        List<Vertex<int>>* incoming = g->getIncomingVertices(rooms[0]);
+        position = 0;
+        for (Vertex<int>* neighbor : g->getIncomingRange(rooms[0])) {
+            sameNeighbors = sameNeighbors && neighbor == incoming->peek(position);
+            position++;
+        }
+        delete incoming;
+        if (sameNeighbors && position == 2 && g->getIncomingRange(rooms[2]).size() == 1
+            && g->getOutgoingRange(stranger).empty() && g->getIncomingRange(stranger).begin() == g->getIncomingRange(stranger).end()) {
+            pointsEarned++;
+        }
+        else {
+            sout << "the incoming range doesn't match getIncomingVertices" << std::endl;
+        }
+        //
+        pointsPossible++;
+        std::vector<Vertex<int>*> visited;
+        int outVisited = g->forEachOutgoing(rooms[0], [&visited](Vertex<int>* neighbor) {
+            visited.push_back(neighbor);
+        });
+        int inVisited = g->forEachIncoming(rooms[0], [&visited](Vertex<int>* neighbor) {
+            visited.push_back(neighbor);
+        });
+        std::vector<Vertex<int>*> expected = { rooms[1], rooms[2], rooms[3], rooms[2], rooms[3] };
+        std::sort(visited.begin(), visited.end());
+        std::sort(expected.begin(), expected.end());
+        int strangerVisits = 0;
+        int strangerResult = g->forEachOutgoing(stranger, [&strangerVisits](Vertex<int>*) {
+            strangerVisits++;
+        });
+        if (outVisited == 3 && inVisited == 2 && visited == expected
+            && strangerResult < 0 && strangerVisits == 0) {
+            pointsEarned++;
+        }
+        else {
+            sout << "the neighbour visitors went wrong" << std::endl;
+        }
+        delete stranger;
+        delete g;
+
+        std::cout << "GraphTester::test15 results:" << std::endl;
+        return new TestResults(pointsPossible, pointsEarned, sout.str());
+    }
+
+    static TestResults* test16() {
+        std::ostringstream sout;
+        int pointsPossible = 0;
+        int pointsEarned = 0;
+        Graph<int, int>* g = new Graph<int, int>(true);
+        Vertex<int>* rooms[3];
+        for (int k = 0; k < 3; k++) {
+            rooms[k] = new Vertex<int>();
+            g->addVertex(rooms[k]);
+        }
+        g->addEdge(rooms[0], rooms[1]);
+        g->addEdge(rooms[1], rooms[2]);
+        g->addEdge(rooms[2], rooms[2]);
+        //
+        pointsPossible++;
+        MemoryReport report;
+        g->reportMemory(&report, "world");
+        size_t parts = report.getBytes("world.object") + report.getBytes("world.vertices")
+            + report.getBytes("world.vertex_objects") + report.getBytes("world.vertex_adjacency")
+            + report.getBytes("world.edges") + report.getBytes("world.edge_objects") + report.getBytes("world.edge_index");
+        if (report.getCount("world.vertex_objects") == 3 && report.getBytes("world.vertex_objects") == 3 * sizeof(Vertex<int>)
+            && report.getCount("world.edge_objects") == 3 && report.getBytes("world.edge_objects") == 3 * sizeof(Edge<int, int>)
+            && report.getCount("world.vertex_adjacency") == 6 && report.getBytes("world.vertex_adjacency") >= 6 * sizeof(Vertex<int>*)
+            && report.getCount("world.vertices.items") == 3
+            && report.getCount("world.edges.items") == 3 && report.getCount("world.vertices.index.slots") >= 6
+            && report.getBytes("world.edge_index.slots") >= 3 * sizeof(Pair<Vertex<int>, Vertex<int>>)
+            && parts == report.getTotalBytes() && report.getBytes("world") == report.getTotalBytes()) {
+            pointsEarned++;
+        }
+        else {
+            sout << "a graph reported its memory wrong:" << std::endl << report.toString();
+        }
+        //
+        pointsPossible++;
+        g->removeVertex(rooms[1]);
+        MemoryReport smaller;
+        g->reportMemory(&smaller, "world");
+        CompactGraph<int, int> compact(g);
+        MemoryReport compactReport;
+        compact.reportMemory(&compactReport, "compact");
+        StringArena arena;
+        arena.intern("A dragon sleeps here.");
+        arena.intern("Gold glitters.");
+        MemoryReport arenaReport;
+        arena.reportMemory(&arenaReport, "text");
+        if (smaller.getCount("world.edge_objects") == 1 && smaller.getCount("world.vertex_adjacency") == 2
+            && smaller.getTotalBytes() < report.getTotalBytes()
+            && compactReport.getTotalBytes() == compact.getMemoryBytes() + sizeof(compact)
+            && compactReport.getCount("compact.edges") == 1
+            && arenaReport.getTotalBytes() == arena.getBytesAllocated() + sizeof(arena)
+            && arenaReport.getCount("text.handles") == 2) {
+            pointsEarned++;
+        }
+        else {
+            sout << "removal, CompactGraph or StringArena memory was reported wrong:" << std::endl
+                << smaller.toString() << compactReport.toString() << arenaReport.toString();
+        }
+        delete g;
+
+        std::cout << "GraphTester::test16 results:" << std::endl;
+        return new TestResults(pointsPossible, pointsEarned, sout.str());
+    }
+
+    static TestResults* runAllTests() {
+        int totalPossible = 0;
+        int totalEarned = 0;
+
+        TestResults* r;
+
+        r = test0();
+        totalPossible += r->pointsPossible;
+        totalEarned += r->pointsEarned;
+        std::cout << r->toString() << std::endl;
+
+        r = test1();
+        totalPossible += r->pointsPossible;
+        totalEarned += r->pointsEarned;
+        std::cout << r->toString() << std::endl;
+
+        r = test2();
+        totalPossible += r->pointsPossible;
+        totalEarned += r->pointsEarned;
+        std::cout << r->toString() << std::endl;
+
+        r = test3();
+        totalPossible += r->pointsPossible;
+        totalEarned += r->pointsEarned;
+        std::cout << r->toString() << std::endl;
+
+        r = test4();
+        totalPossible += r->pointsPossible;
+        totalEarned += r->pointsEarned;
+        std::cout << r->toString() << std::endl;
+
+        r = test5();
+        totalPossible += r->pointsPossible;
+        totalEarned += r->pointsEarned;
+        std::cout << r->toString() << std::endl;
+
+        r = test6();
+        totalPossible += r->pointsPossible;
+        totalEarned += r->pointsEarned;
+        std::cout << r->toString() << std::endl;
+
+        r = test7();
+        totalPossible += r->pointsPossible;
+        totalEarned += r->pointsEarned;
+        std::cout << r->toString() << std::endl;
+
+        r = test8();
+        totalPossible += r->pointsPossible;
+        totalEarned += r->pointsEarned;
+        std::cout << r->toString() << std::endl;
+
+        r = test9();
+        totalPossible += r->pointsPossible;
+        totalEarned += r->pointsEarned;
+        std::cout << r->toString() << std::endl;
+
+        r = test10();
+        totalPossible += r->pointsPossible;
+        totalEarned += r->pointsEarned;
+        std::cout << r->toString() << std::endl;
+
+        r = test11();
+        totalPossible += r->pointsPossible;
+        totalEarned += r->pointsEarned;
+        std::cout << r->toString() << std::endl;
+
+        r = test12();
+        totalPossible += r->pointsPossible;
+        totalEarned += r->pointsEarned;
+        std::cout << r->toString() << std::endl;
+
+        r = test13();
+        totalPossible += r->pointsPossible;
+        totalEarned += r->pointsEarned;
+        std::cout << r->toString() << std::endl;
+        r = test14();
+        totalPossible += r->pointsPossible;
+        totalEarned += r->pointsEarned;
+        std::cout << r->toString() << std::endl;
+        r = test15();
+        totalPossible += r->pointsPossible;
+        totalEarned += r->pointsEarned;
+        std::cout << r->toString() << std::endl;
+        r = test16();
+        totalPossible += r->pointsPossible;
+        totalEarned += r->pointsEarned;
+        std::cout << r->toString() << std::endl;
+
+        return new TestResults(totalPossible, totalEarned, "");
+    }
+
+};
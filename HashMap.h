@@ -0,0 +1,518 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+#include "MemoryReport.h"
+#include "Pair.h"
+
+/*
+ The hash used by HashMap for keys of type K. For std::string keys it hashes
+ through std::string_view, so a map with string keys can be searched with a
+ std::string_view or a string literal without building a std::string.
+ */
+template <typename K>
+struct HashMapHash {
+    size_t operator()(const K& key) const {
+        return std::hash<K>()(key);
+    }
+};
+
+template <>
+struct HashMapHash<std::string> {
+    size_t operator()(std::string_view key) const {
+        return std::hash<std::string_view>()(key);
+    }
+};
+
+/*
+ A templated class representing hash maps. A HashMap<K, V> stores its
+ entries as Pair<K, V>, so like a Pair it manages pointers to keys of type K
+ and values of type V; two keys are the same if the objects they point to
+ compare equal.
+
+ The map uses open addressing with one control byte per slot, in the style
+ of SwissTable. A control byte says whether its slot is empty, deleted, or
+ full, and for a full slot holds 7 bits of the key's hash. Lookups scan the
+ control bytes eight at a time, and only follow the key pointer of a slot
+ whose 7 bits match, so a probe rarely touches anything but the small,
+ dense control array. The table grows when it is 7/8 full.
+
+ If the map owns its data (see setOwnsData), clearing or destroying it
+ deletes every key and value in it.
+ */
+template <typename K, typename V, typename Hash = HashMapHash<K>>
+class HashMap {
+
+protected:
+
+    static const int GroupSize = 8;
+
+    static const signed char Empty = -128;
+
+    static const signed char Deleted = -2;
+
+    /*
+     One control byte per slot: Empty, Deleted, or 7 bits of the hash.
+     */
+    signed char* control;
+
+    Pair<K, V>* slots;
+
+    int numSlots;
+
+    /*
+     The number of bits of the mixed hash left over after taking the slot
+     index from its top bits.
+     */
+    int shift;
+
+    int numEntries;
+
+    int numDeleted;
+
+    bool ownsData;
+
+    Hash hasher;
+
+    /*
+     Spreads the specified hash over all 64 bits, since std::hash is often
+     the identity on integers.
+     */
+    static uint64_t mix(size_t hash) {
+        return (uint64_t)hash * 0x9E3779B97F4A7C15ULL;
+    }
+
+    int groupOf(uint64_t mixed) {
+        return (int)(mixed >> this->shift) & ~(GroupSize - 1);
+    }
+
+    static signed char tagOf(uint64_t mixed) {
+        return (signed char)(mixed & 0x7F);
+    }
+
+    uint64_t loadGroup(int group) {
+        uint64_t bytes;
+        std::memcpy(&bytes, this->control + group, GroupSize);
+        return bytes;
+    }
+
+    /*
+     Returns a word with the high bit set in each byte of the specified
+     group of control bytes that might equal the specified tag. False
+     positives are possible and are weeded out by comparing keys.
+     */
+    static uint64_t matchTag(uint64_t bytes, signed char tag) {
+        uint64_t x = bytes ^ (0x0101010101010101ULL * (unsigned char)tag);
+        return (x - 0x0101010101010101ULL) & ~x & 0x8080808080808080ULL;
+    }
+
+    /*
+     Returns a word with the high bit set in each byte of the specified
+     group of control bytes that is Empty.
+     */
+    static uint64_t matchEmpty(uint64_t bytes) {
+        return bytes & ~(bytes << 6) & 0x8080808080808080ULL;
+    }
+
+    /*
+     Returns a word with the high bit set in each byte of the specified
+     group of control bytes that is Empty or Deleted.
+     */
+    static uint64_t matchFree(uint64_t bytes) {
+        return bytes & 0x8080808080808080ULL;
+    }
+
+    /*
+     Returns the position within its group of the lowest byte flagged in the
+     specified match word, which must not be zero.
+     */
+    static int lowestMatch(uint64_t match) {
+        int k = 0;
+        while ((match & 0x80) == 0) {
+            match >>= 8;
+            k++;
+        }
+        return k;
+    }
+
+    /*
+     Returns the slot holding the specified key, or a negative number if the
+     key is not in this map.
+     */
+    template <typename Key>
+    int findSlot(const Key& key) {
+        uint64_t mixed = mix(this->hasher(key));
+        signed char tag = tagOf(mixed);
+        int group = this->groupOf(mixed);
+        while (true) {
+            uint64_t bytes = this->loadGroup(group);
+            uint64_t match = matchTag(bytes, tag);
+            while (match != 0) {
+                int slot = group + lowestMatch(match);
+                if (this->control[slot] == tag && *this->slots[slot].first == key) {
+                    return slot;
+                }
+                match &= match - 1;
+            }
+            if (matchEmpty(bytes) != 0) {
+                return -1;
+            }
+            group = (group + GroupSize) & (this->numSlots - 1);
+        }
+    }
+
+    /*
+     Puts the specified entry into the first free slot on its probe
+     sequence. The key must not already be in the map, and there must be a
+     free slot.
+     */
+    void place(K* key, V* value, uint64_t mixed) {
+        int group = this->groupOf(mixed);
+        uint64_t free = matchFree(this->loadGroup(group));
+        while (free == 0) {
+            group = (group + GroupSize) & (this->numSlots - 1);
+            free = matchFree(this->loadGroup(group));
+        }
+        int slot = group + lowestMatch(free);
+        if (this->control[slot] == Deleted) {
+            this->numDeleted--;
+        }
+        this->control[slot] = tagOf(mixed);
+        this->slots[slot].first = key;
+        this->slots[slot].second = value;
+        this->numEntries++;
+    }
+
+    /*
+     Allocates an empty table with the specified number of slots, which must
+     be a power of two no smaller than GroupSize.
+     */
+    void allocate(int slotCount) {
+        this->numSlots = slotCount;
+        this->control = new signed char[slotCount];
+        std::memset(this->control, Empty, slotCount);
+        this->slots = new Pair<K, V>[slotCount];
+        this->shift = 64;
+        for (int n = slotCount; n > 1; n /= 2) {
+            this->shift--;
+        }
+        this->numEntries = 0;
+        this->numDeleted = 0;
+    }
+
+    /*
+     Returns the number of entries the table can hold before growing.
+     */
+    int getMaxLoad() {
+        return this->numSlots - this->numSlots / 8;
+    }
+
+    /*
+     Returns the smallest table size that holds the specified number of
+     entries without growing.
+     */
+    static int slotsFor(int entries) {
+        int slotCount = GroupSize;
+        while (slotCount - slotCount / 8 < entries) {
+            slotCount *= 2;
+        }
+        return slotCount;
+    }
+
+public:
+
+    /*
+     An iterator over the entries of a HashMap, in no particular order.
+     The iterator is invalidated by any insertion or rehash.
+     */
+    class iterator {
+
+    protected:
+
+        HashMap<K, V, Hash>* map;
+
+        int slot;
+
+        void skipFree() {
+            while (this->slot < this->map->numSlots && this->map->control[this->slot] < 0) {
+                this->slot++;
+            }
+        }
+
+    public:
+
+        iterator(HashMap<K, V, Hash>* map, int slot) {
+            this->map = map;
+            this->slot = slot;
+            this->skipFree();
+        }
+
+        Pair<K, V>& operator*() const {
+            return this->map->slots[this->slot];
+        }
+
+        Pair<K, V>* operator->() const {
+            return &this->map->slots[this->slot];
+        }
+
+        iterator& operator++() {
+            this->slot++;
+            this->skipFree();
+            return *this;
+        }
+
+        iterator operator++(int) {
+            iterator result = *this;
+            ++(*this);
+            return result;
+        }
+
+        bool operator==(const iterator& other) const {
+            return this->slot == other.slot && this->map == other.map;
+        }
+
+        bool operator!=(const iterator& other) const {
+            return !(*this == other);
+        }
+
+    };
+
+    /*
+     Creates an empty map.
+     */
+    HashMap() {
+        this->allocate(GroupSize);
+        this->ownsData = false;
+    }
+
+    /*
+     Creates an empty map with room for the specified number of entries.
+     */
+    HashMap(int capacity) {
+        this->allocate(slotsFor(capacity));
+        this->ownsData = false;
+    }
+
+    HashMap(const HashMap<K, V, Hash>& other) = delete;
+
+    HashMap<K, V, Hash>& operator=(const HashMap<K, V, Hash>& other) = delete;
+
+    /*
+     Creates a map by taking over the table of the specified map, which is
+     left empty. Runs in constant time.
+     */
+    HashMap(HashMap<K, V, Hash>&& other) {
+        this->control = other.control;
+        this->slots = other.slots;
+        this->numSlots = other.numSlots;
+        this->shift = other.shift;
+        this->numEntries = other.numEntries;
+        this->numDeleted = other.numDeleted;
+        this->ownsData = other.ownsData;
+        other.allocate(GroupSize);
+        other.ownsData = false;
+    }
+
+    /*
+     Destroys this map, and its keys and values if it owns them.
+     */
+    ~HashMap() {
+        this->clear();
+        delete[] this->control;
+        delete[] this->slots;
+    }
+
+    /*
+     Removes every entry from this map, keeping its capacity. If this map
+     owns its data, every key and value is deleted as well.
+     */
+    void clear() {
+        for (int slot = 0; slot < this->numSlots; slot++) {
+            if (this->control[slot] >= 0 && this->ownsData) {
+                delete this->slots[slot].first;
+                delete this->slots[slot].second;
+            }
+            this->slots[slot].first = nullptr;
+            this->slots[slot].second = nullptr;
+        }
+        std::memset(this->control, Empty, this->numSlots);
+        this->numEntries = 0;
+        this->numDeleted = 0;
+    }
+
+    bool getOwnsData() {
+        return this->ownsData;
+    }
+
+    void setOwnsData(bool ownsData) {
+        this->ownsData = ownsData;
+    }
+
+    bool isEmpty() {
+        return this->numEntries == 0;
+    }
+
+    /*
+     Returns the number of entries in this map.
+     */
+    int getSize() {
+        return this->numEntries;
+    }
+
+    /*
+     Returns the number of entries this map can hold before it grows.
+     */
+    int getCapacity() {
+        return this->getMaxLoad();
+    }
+
+    /*
+     Rebuilds the table with at least the specified number of slots, or more
+     if that many can't hold the current entries. Deleted slots are dropped
+     in the process. Invalidates iterators.
+     */
+    void rehash(int slotCount) {
+        int needed = slotsFor(this->numEntries);
+        int newSlots = GroupSize;
+        while (newSlots < slotCount || newSlots < needed) {
+            newSlots *= 2;
+        }
+        signed char* oldControl = this->control;
+        Pair<K, V>* oldSlots = this->slots;
+        int oldNumSlots = this->numSlots;
+        this->allocate(newSlots);
+        for (int slot = 0; slot < oldNumSlots; slot++) {
+            if (oldControl[slot] >= 0) {
+                K* key = oldSlots[slot].first;
+                this->place(key, oldSlots[slot].second, mix(this->hasher(*key)));
+            }
+        }
+        delete[] oldControl;
+        delete[] oldSlots;
+    }
+
+    /*
+     Makes room for the specified number of entries, so that inserting up to
+     that many does not rehash.
+     */
+    void reserve(int capacity) {
+        if (capacity > this->getMaxLoad() - this->numDeleted) {
+            this->rehash(slotsFor(capacity));
+        }
+    }
+
+    /*
+     Adds an entry with the specified key and value. If an equal key is
+     already in the map, returns false and leaves the map unaltered, and the
+     caller keeps responsibility for the specified key and value.
+     */
+    bool insert(K* key, V* value) {
+        if (this->findSlot(*key) >= 0) {
+            return false;
+        }
+        if (this->numEntries + this->numDeleted >= this->getMaxLoad()) {
+            // grow if the table is really full, or just sweep out deleted slots
+            if (this->numEntries >= this->numSlots / 2) {
+                this->rehash(this->numSlots * 2);
+            }
+            else {
+                this->rehash(this->numSlots);
+            }
+        }
+        this->place(key, value, mix(this->hasher(*key)));
+        return true;
+    }
+
+    /*
+     Returns the entry whose key equals the specified key, or the null
+     pointer if there is none. The entry's value may be changed through the
+     returned pair, but not its key. The key can be of any type that hashes
+     like K and compares equal with it; for std::string keys, a
+     std::string_view or a string literal works.
+     */
+    template <typename Key>
+    Pair<K, V>* find(const Key& key) {
+        int slot = this->findSlot(key);
+        return slot >= 0 ? &this->slots[slot] : nullptr;
+    }
+
+    /*
+     Returns the value stored under the specified key, or the null pointer
+     if the key is not in this map.
+     */
+    template <typename Key>
+    V* get(const Key& key) {
+        int slot = this->findSlot(key);
+        return slot >= 0 ? this->slots[slot].second : nullptr;
+    }
+
+    template <typename Key>
+    bool contains(const Key& key) {
+        return this->findSlot(key) >= 0;
+    }
+
+    /*
+     Removes the entry whose key equals the specified key, and returns it.
+     If there is no such entry, returns an empty pair. The caller becomes
+     responsible for the returned key and value, even if this map owns its
+     data.
+     */
+    template <typename Key>
+    Pair<K, V> remove(const Key& key) {
+        Pair<K, V> result;
+        int slot = this->findSlot(key);
+        if (slot >= 0) {
+            result = this->slots[slot];
+            this->slots[slot].first = nullptr;
+            this->slots[slot].second = nullptr;
+            // if this group already stops every probe, the slot can be empty
+            int group = slot & ~(GroupSize - 1);
+            if (matchEmpty(this->loadGroup(group)) != 0) {
+                this->control[slot] = Empty;
+            }
+            else {
+                this->control[slot] = Deleted;
+                this->numDeleted++;
+            }
+            this->numEntries--;
+        }
+        return result;
+    }
+
+    iterator begin() {
+        return iterator(this, 0);
+    }
+
+    iterator end() {
+        return iterator(this, this->numSlots);
+    }
+
+    /*
+     Adds the memory held by this map to the specified report, under the
+     specified name: the map object, its control bytes and its slots,
+     counting the empty ones. The keys and values the slots point to are
+     not counted.
+     */
+    void reportMemory(MemoryReport* report, const std::string& name) {
+        report->add(name + ".object", 1, sizeof(*this));
+        report->add(name + ".control", this->numSlots, (size_t)this->numSlots);
+        report->add(name + ".slots", this->numSlots, this->numSlots * sizeof(Pair<K, V>));
+    }
+
+    /*
+     Returns a string representation of this map.
+     */
+    std::string toString() {
+        std::ostringstream sout;
+        sout << "HashMap at " << this << std::endl;
+        sout << this->numEntries << " entries, " << this->numDeleted << " deleted, "
+            << this->numSlots << " slots" << std::endl;
+        return sout.str();
+    }
+
+};
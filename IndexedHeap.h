@@ -0,0 +1,237 @@
+#pragma once
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+/*
+ A templated class representing min-heaps of integer ids, each with a
+ priority of type P, that can lower the priority of an id already in the
+ heap. Ids run from 0 to the heap's id range minus one, which grows as
+ needed; an IndexedHeap is meant to be kept and reused, as PathFinder does,
+ so after the first few uses it allocates nothing.
+
+ The heap is a d-ary tree in an array, with Arity children per node. A wider
+ node makes the tree shallower, so decreasePriority, which moves an id up,
+ does fewer steps, at the cost of more comparisons in pop; 4 suits shortest
+ path searches, which do many more decreases than pops. The position of each
+ id in the array is kept in a second array, which is what lets
+ decreasePriority find it.
+ */
+template <typename P = double, int Arity = 4>
+class IndexedHeap {
+
+protected:
+
+    struct Entry {
+        P priority;
+        int id;
+    };
+
+    std::vector<Entry> entries;
+
+    /*
+     positions[id] is the position of the id in entries, or -1 if the id is
+     not in the heap.
+     */
+    std::vector<int> positions;
+
+    /*
+     Moves the entry at the specified position up until its parent's
+     priority is no greater.
+     */
+    void siftUp(int position) {
+        Entry entry = this->entries[position];
+        while (position > 0) {
+            int parent = (position - 1) / Arity;
+            if (!(entry.priority < this->entries[parent].priority)) {
+                break;
+            }
+            this->entries[position] = this->entries[parent];
+            this->positions[this->entries[position].id] = position;
+            position = parent;
+        }
+        this->entries[position] = entry;
+        this->positions[entry.id] = position;
+    }
+
+    /*
+     Moves the entry at the specified position down until no child has a
+     smaller priority.
+     */
+    void siftDown(int position) {
+        Entry entry = this->entries[position];
+        int size = (int)this->entries.size();
+        while (true) {
+            int firstChild = position * Arity + 1;
+            if (firstChild >= size) {
+                break;
+            }
+            int lastChild = firstChild + Arity < size ? firstChild + Arity : size;
+            int smallest = firstChild;
+            for (int child = firstChild + 1; child < lastChild; child++) {
+                if (this->entries[child].priority < this->entries[smallest].priority) {
+                    smallest = child;
+                }
+            }
+            if (!(this->entries[smallest].priority < entry.priority)) {
+                break;
+            }
+            this->entries[position] = this->entries[smallest];
+            this->positions[this->entries[position].id] = position;
+            position = smallest;
+        }
+        this->entries[position] = entry;
+        this->positions[entry.id] = position;
+    }
+
+public:
+
+    /*
+     Creates an empty heap for ids 0 to idRange - 1.
+     */
+    IndexedHeap(int idRange = 0) {
+        this->setIdRange(idRange);
+    }
+
+    /*
+     Makes room for ids 0 to idRange - 1. The range never shrinks.
+     */
+    void setIdRange(int idRange) {
+        if (idRange > (int)this->positions.size()) {
+            this->positions.resize(idRange, -1);
+        }
+    }
+
+    /*
+     Returns the number of ids the heap has room for.
+     */
+    int getIdRange() {
+        return (int)this->positions.size();
+    }
+
+    /*
+     Returns the number of ids in this heap.
+     */
+    int getSize() {
+        return (int)this->entries.size();
+    }
+
+    bool isEmpty() {
+        return this->entries.empty();
+    }
+
+    /*
+     Returns true if and only if the specified id is in this heap.
+     */
+    bool contains(int id) {
+        return id >= 0 && id < (int)this->positions.size() && this->positions[id] >= 0;
+    }
+
+    /*
+     Returns the priority of the specified id. The id must be in this heap.
+     */
+    P getPriority(int id) {
+        return this->entries[this->positions[id]].priority;
+    }
+
+    /*
+     Adds the specified id with the specified priority, or, if it is already
+     in this heap, changes its priority. Returns false, and does nothing, if
+     the id is negative.
+     */
+    bool push(int id, P priority) {
+        if (id < 0) {
+            return false;
+        }
+        if (this->contains(id)) {
+            int position = this->positions[id];
+            P oldPriority = this->entries[position].priority;
+            this->entries[position].priority = priority;
+            if (priority < oldPriority) {
+                this->siftUp(position);
+            }
+            else {
+                this->siftDown(position);
+            }
+            return true;
+        }
+        this->setIdRange(id + 1);
+        this->entries.push_back({ priority, id });
+        this->siftUp((int)this->entries.size() - 1);
+        return true;
+    }
+
+    /*
+     Lowers the priority of the specified id, adding the id if it isn't in
+     this heap. Returns true if the priority was lowered or the id added,
+     and false if the id already had a priority no greater than the
+     specified one.
+     */
+    bool decreasePriority(int id, P priority) {
+        if (this->contains(id)) {
+            int position = this->positions[id];
+            if (!(priority < this->entries[position].priority)) {
+                return false;
+            }
+            this->entries[position].priority = priority;
+            this->siftUp(position);
+            return true;
+        }
+        return this->push(id, priority);
+    }
+
+    /*
+     Returns the id with the smallest priority, or -1 if this heap is empty.
+     */
+    int peekMin() {
+        return this->entries.empty() ? -1 : this->entries[0].id;
+    }
+
+    /*
+     Returns the smallest priority in this heap. The heap must not be empty.
+     */
+    P peekMinPriority() {
+        return this->entries[0].priority;
+    }
+
+    /*
+     Removes and returns the id with the smallest priority, or returns -1 if
+     this heap is empty.
+     */
+    int pop() {
+        if (this->entries.empty()) {
+            return -1;
+        }
+        int id = this->entries[0].id;
+        this->positions[id] = -1;
+        Entry last = this->entries.back();
+        this->entries.pop_back();
+        if (!this->entries.empty()) {
+            this->entries[0] = last;
+            this->siftDown(0);
+        }
+        return id;
+    }
+
+    /*
+     Removes every id from this heap, keeping its memory for reuse.
+     */
+    void clear() {
+        for (Entry& entry : this->entries) {
+            this->positions[entry.id] = -1;
+        }
+        this->entries.clear();
+    }
+
+    /*
+     Returns a string representation of this heap.
+     */
+    std::string toString() {
+        std::ostringstream sout;
+        sout << "IndexedHeap at " << this << std::endl;
+        sout << this->getSize() << " ids, range " << this->getIdRange() << std::endl;
+        return sout.str();
+    }
+
+};
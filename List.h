@@ -18,6 +18,7 @@ protected:
      Creates a list consisting of the specified node.
      */
     List(Node<T>* existingNode) {
+        this->nodePool = nullptr;
         if (existingNode == nullptr) {
             this->startNode = nullptr;
             this->endNode = nullptr;
@@ -44,6 +45,62 @@ protected:
         }
     }
 
+    /*
+     Unlinks the specified run of nodes, from firstNode to lastNode
+     inclusive, count nodes long and starting at the specified position,
+     and returns it as a new list with the same node pool, ownership
+     mode and indexing as this one. A count of zero returns an empty
+     list. The indexes of both lists are kept exact.
+     */
+    List<T>* detachRange(Node<T>* firstNode, Node<T>* lastNode, int count, int position) {
+        List<T>* result = new List<T>(this->nodePool);
+        result->ownsData = this->ownsData;
+        if (this->pointerIndex != nullptr) {
+            result->pointerIndex = new PointerIndex<T>();
+        }
+        if (count > 0) {
+            Node<T>* previousNode = firstNode->getPreviousNode();
+            Node<T>* nextNode = lastNode->getNextNode();
+            if (previousNode != nullptr) {
+                previousNode->setNextNode(nextNode);
+            }
+            else {
+                this->startNode = nextNode;
+            }
+            if (nextNode != nullptr) {
+                nextNode->setPreviousNode(previousNode);
+            }
+            else {
+                this->endNode = previousNode;
+            }
+            firstNode->setPreviousNode(nullptr);
+            lastNode->setNextNode(nullptr);
+            this->numNodes -= count;
+            this->resetFinger();
+            if (this->pointerIndex != nullptr) {
+                // last to first, so a pointer repeated within the run is removed cleanly
+                Node<T>* node = lastNode;
+                for (int k = count - 1; k >= 0; k--) {
+                    this->pointerIndex->removeAt(node->getData(), position + k);
+                    node = node->getPreviousNode();
+                }
+                this->reindexAfterShift(previousNode, position, nextNode, position, -count);
+            }
+
+            result->startNode = firstNode;
+            result->endNode = lastNode;
+            result->numNodes = count;
+            if (result->pointerIndex != nullptr) {
+                Node<T>* node = firstNode;
+                for (int k = 0; k < count; k++) {
+                    result->pointerIndex->insertAt(node->getData(), k);
+                    node = node->getNextNode();
+                }
+            }
+        }
+        return result;
+    }
+
 public:
 
     /*
@@ -51,6 +108,11 @@ public:
      */
     List() : Chain<T>() {}
 
+    /*
+     Creates an empty list that takes its nodes from the specified pool.
+     */
+    List(NodePool<T>* nodePool) : Chain<T>(nodePool) {}
+
     /*
      Returns the index of the first occurance of the specified
      data in this chain, or, if the specified data is not in
@@ -58,19 +120,23 @@ public:
 
      Note: the specified data is considered to be in this chain
      iff its pointer has the same value as one of the pointers
-     managed by this list.
+     managed by this list. If this list is indexed (see
+     setIndexed), the lookup takes constant expected time.
      */
     int getIndex(T* data) {
-        int result = -1;
-        int sz = this->getSize();
+        if (this->pointerIndex != nullptr) {
+            return this->getFreshIndex()->getPosition(data);
+        }
 
-        for (int k = 0; k < sz; k++) {
-            T* peekResult = this->peek(k);
+        int result = -1;
+        int k = 0;
 
-            if (peekResult == data) {
+        for (T* item : *this) {
+            if (item == data) {
                 result = k;
                 break;
             }
+            k++;
         }
         return result;
     }
@@ -79,92 +145,173 @@ public:
      Removes the node at the specified position, and returns the
      data from that node. If there is no node in the specified
      position, this method leaves the list unaltered and returns
-     the null pointer.
+     the null pointer. The node is unlinked in place, walking from
+     whichever end of the list is nearer.
      */
-
-
-
     T* removeFromPosition(int position) {
         T* result;
-        Node<T>* currentNode = this->startNode;
-
-        for (int k = 0; k < position; k++) {
-            currentNode = currentNode->getNextNode();
+        if (position < 0 || position >= this->numNodes) {
+            result = nullptr;
+        }
+        else if (position == 0) {
+            result = this->removeFromStart();
+        }
+        else if (position == this->numNodes - 1) {
+            result = this->removeFromEnd();
+        }
+        else {
+            Node<T>* currentNode = this->nodeAt(position);
+            Node<T>* previousNode = currentNode->getPreviousNode();
+            Node<T>* nextNode = currentNode->getNextNode();
+            previousNode->setNextNode(nextNode);
+            nextNode->setPreviousNode(previousNode);
+            result = currentNode->getData();
+            // the node after the removed one takes over its position
+            this->fingerNode = nextNode;
+            this->destroyNode(currentNode);
+            this->numNodes--;
+            if (this->pointerIndex != nullptr) {
+                this->pointerIndex->removeAt(result, position);
+                this->reindexAfterShift(previousNode, position, nextNode, position, -1);
+            }
         }
-
-        List<T>* lastHalf = this->splitAfter(position);
-        result = this->removeFromEnd();
-        this->append(lastHalf);
         return result;
     }
 
     /*
      Inserts the specified data into the list as a new node in
-     the specified position.
+     the specified position. Positions past the end of the list
+     insert at the end. The node is linked in place, walking from
+     whichever end of the list is nearer.
      */
     void insertAtPosition(int position, T* data) {
-        if (this->isEmpty()) {
-            this->startNode = new Node<T>(data);
-            this->endNode = this->startNode;
-            this->numNodes = 1;
-
+        if (position <= 0 || this->isEmpty()) {
+            this->insertAtStart(data);
         }
-        else if (position == 0) {
-            Node<T>* newStart = new Node<T>(data);
-            this->startNode->setPreviousNode(newStart);
-            newStart->setNextNode(this->startNode);
-            this->startNode = newStart;
+        else if (position >= this->numNodes) {
+            this->insertAtEnd(data);
+        }
+        else {
+            Node<T>* nextNode = this->nodeAt(position);
+            Node<T>* previousNode = nextNode->getPreviousNode();
+            Node<T>* newNode = this->createNode(data);
+            newNode->setPreviousNode(previousNode);
+            newNode->setNextNode(nextNode);
+            previousNode->setNextNode(newNode);
+            nextNode->setPreviousNode(newNode);
             this->numNodes++;
+            this->fingerNode = newNode;
+            this->fingerPosition = position;
+            if (this->pointerIndex != nullptr) {
+                this->reindexAfterShift(previousNode, position, nextNode, position + 1, 1);
+                this->pointerIndex->insertAt(data, position);
+            }
+        }
+    }
 
+    /*
+     Moves all nodes of the specified list into this list, so that
+     the first of them ends up in the specified position. The
+     specified list is left empty. Finding the position walks from
+     whichever end of this list is nearer; the nodes themselves are
+     spliced in constant time. Both lists must use the same node pool.
+     */
+    void insertRangeAt(int position, List<T>* range) {
+        if (range->isEmpty()) {
+            return;
+        }
+        if (position <= 0 || this->isEmpty()) {
+            this->prepend(range);
+        }
+        else if (position >= this->numNodes) {
+            this->append(range);
         }
         else {
-            List<T>* lastHalf = this->splitAfter(position - 1);
-            this->insertAtEnd(data);
-            this->append(lastHalf);
-            this->numNodes++;
+            Node<T>* nextNode = this->nodeAt(position);
+            Node<T>* previousNode = nextNode->getPreviousNode();
+            previousNode->setNextNode(range->startNode);
+            range->startNode->setPreviousNode(previousNode);
+            nextNode->setPreviousNode(range->endNode);
+            range->endNode->setNextNode(nextNode);
+            int count = range->numNodes;
+            this->numNodes += count;
+            this->fingerNode = range->startNode;
+            this->fingerPosition = position;
+            if (this->pointerIndex != nullptr) {
+                this->reindexAfterShift(previousNode, position, nextNode, position + count, count);
+                Node<T>* node = range->startNode;
+                for (int k = 0; k < count; k++) {
+                    this->pointerIndex->insertAt(node->getData(), position + k);
+                    node = node->getNextNode();
+                }
+            }
+            range->release();
+        }
+    }
+
+    /*
+     Removes the specified number of nodes starting at the specified
+     position, and returns them, in order, as another list. If the
+     range runs past the end of this list, it is cut short there. As
+     with splitAfter, the caller is responsible for deleting the
+     returned list; deleting it deletes the data too if this list
+     owns its data. Runs in time proportional to the distance to the
+     position plus the length of the range.
+     */
+    List<T>* eraseRange(int position, int count) {
+        if (position < 0) {
+            count += position;
+            position = 0;
+        }
+        if (count > this->numNodes - position) {
+            count = this->numNodes - position;
+        }
+        if (count <= 0) {
+            return this->detachRange(nullptr, nullptr, 0, 0);
         }
+        Node<T>* firstNode = this->nodeAt(position);
+        Node<T>* lastNode = firstNode;
+        for (int k = 1; k < count; k++) {
+            lastNode = lastNode->getNextNode();
+        }
+        return this->detachRange(firstNode, lastNode, count, position);
     }
 
     /*
      Splits this list after the specified position, removing all
      nodes after that position from this list, and returning these
-     nodes as another list.
+     nodes as another list. The returned list uses the same node pool
+     and ownership mode as this one, and the caller is responsible
+     for deleting it.
      */
     List<T>* splitAfter(int position) {
         List<T>* result;
 
-        if (this->numNodes < 2) {
-            result = new List<T>();
-
+        if (position < 0 || position >= this->numNodes - 1) {
+            result = this->detachRange(nullptr, nullptr, 0, 0);
         }
         else {
-            Node<T>* currentNode = this->startNode;
-
-            for (int k = 0; k < position; k++) {
-                currentNode = currentNode->getNextNode();
-            }
-
-            if (currentNode == this->endNode) {
-                result = new List<T>();
-
-            }
-            else {
-                Node<T>* newRoot = currentNode->getNextNode();
-                newRoot->setPreviousNode(nullptr);
-                currentNode->setNextNode(nullptr);
-                this->endNode = currentNode;
-                this->numNodes = position + 1;
-                result = new List<T>(newRoot);
-            }
+            Node<T>* newRoot = this->nodeAt(position + 1);
+            result = this->detachRange(newRoot, this->endNode, this->numNodes - position - 1, position + 1);
         }
         return result;
     }
 
     /*
-     Appends the specified list to this one.
+     Appends the specified list to this one. The nodes of the specified
+     list are moved into this list, so the specified list is left empty;
+     its data is owned by this list from then on if this list owns its
+     data. Both lists must use the same node pool.
      */
     void append(List<T>* suffix) {
         if (!suffix->isEmpty()) {
+            if (this->pointerIndex != nullptr) {
+                int position = this->numNodes;
+                for (T* item : *suffix) {
+                    this->pointerIndex->addAtEnd(item, position);
+                    position++;
+                }
+            }
 
             if (this->isEmpty()) {
                 this->startNode = suffix->startNode;
@@ -178,14 +325,21 @@ public:
                 this->endNode = suffix->endNode;
                 this->numNodes += suffix->getSize();
             }
+            suffix->release();
         }
     }
 
     /*
-     Prepends the specified list to this one.
+     Prepends the specified list to this one. As with append, the nodes
+     of the specified list are moved into this list, leaving it empty.
      */
     void prepend(List<T>* prefix) {
         if (!prefix->isEmpty()) {
+            if (this->pointerIndex != nullptr) {
+                for (Node<T>* node = prefix->endNode; node != nullptr; node = node->getPreviousNode()) {
+                    this->pointerIndex->addAtStart(node->getData());
+                }
+            }
 
             if (this->isEmpty()) {
                 this->startNode = prefix->startNode;
@@ -198,7 +352,9 @@ public:
                 prefix->endNode->setNextNode(this->startNode);
                 this->startNode = prefix->startNode;
                 this->numNodes += prefix->getSize();
+                this->fingerPosition += prefix->getSize();
             }
+            prefix->release();
         }
     }
 
@@ -0,0 +1,495 @@
+#pragma once
+
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "HashMap.h"
+#include "OrderedMap.h"
+#include "Pair.h"
+#include "StringArena.h"
+#include "TestResults.h"
+
+class MapTester {
+
+protected:
+
+    /*
+     An item that keeps count of how many instances of it are alive, so the
+     tests can tell whether a map deleted its data.
+     */
+    class CountedItem {
+
+    public:
+
+        int* counter;
+
+        CountedItem(int* counter) {
+            this->counter = counter;
+            (*this->counter)++;
+        }
+
+        ~CountedItem() {
+            (*this->counter)--;
+        }
+
+    };
+
+public:
+
+    /*
+     Test insert, get, remove and iteration on string keys, including
+     lookups by std::string_view and string literals.
+     */
+    static TestResults* test0() {
+        std::ostringstream sout;
+        int pointsPossible = 0;
+        int pointsEarned = 0;
+        //
+        pointsPossible++;
+        HashMap<std::string, int>* map = new HashMap<std::string, int>();
+        map->setOwnsData(true);
+        bool inserted = map->insert(new std::string("Walk"), new int(1))
+            && map->insert(new std::string("Talk"), new int(2))
+            && map->insert(new std::string("Fight"), new int(3));
+        std::string duplicateKey = "Talk";
+        int duplicateValue = 9;
+        std::string_view talk = std::string_view("TalkAJoke").substr(0, 4);
+        if (inserted && !map->insert(&duplicateKey, &duplicateValue) && map->getSize() == 3
+            && *map->get(talk) == 2 && *map->get("Fight") == 3 && *map->get(std::string("Walk")) == 1
+            && map->get("Run") == nullptr && map->contains(talk) && !map->contains("Tal")) {
+            pointsEarned++;
+        }
+        else {
+            sout << "insert or lookup by string_view went wrong" << std::endl;
+        }
+        //
+        pointsPossible++;
+        Pair<std::string, int> removed = map->remove("Talk");
+        Pair<std::string, int> missing = map->remove("Talk");
+        bool removedRight = removed.isComplete() && *removed.first == "Talk" && *removed.second == 2
+            && missing.isEmpty() && map->getSize() == 2 && !map->contains("Talk");
+        delete removed.first;
+        delete removed.second;
+        *map->find("Walk")->second += 10;
+        int sum = 0;
+        int count = 0;
+        for (Pair<std::string, int>& entry : *map) {
+            sum += *entry.second;
+            count++;
+        }
+        if (removedRight && count == 2 && sum == 14) {
+            pointsEarned++;
+        }
+        else {
+            sout << "remove, find or iteration went wrong" << std::endl;
+        }
+        delete map;
+
+        std::cout << "MapTester::test0 results:" << std::endl;
+        return new TestResults(pointsPossible, pointsEarned, sout.str());
+    }
+
+    /*
+     Test a long random run of inserts, removes and lookups against
+     std::unordered_map, with reserve and rehash mixed in.
+     */
+    static TestResults* test1() {
+        std::ostringstream sout;
+        int pointsPossible = 0;
+        int pointsEarned = 0;
+        //
+        const int numKeys = 5000;
+        std::vector<long long> keys(numKeys);
+        std::vector<int> values(numKeys);
+        for (int k = 0; k < numKeys; k++) {
+            keys[k] = (long long)k * 4096;
+            values[k] = k;
+        }
+        HashMap<long long, int>* map = new HashMap<long long, int>();
+        std::unordered_map<long long, int*> expected;
+        unsigned int seed = 3;
+        bool matches = true;
+        for (int step = 0; step < 200000; step++) {
+            seed = seed * 1103515245 + 12345;
+            int k = (int)((seed >> 8) % numKeys);
+            int choice = (seed >> 4) % 8;
+            if (choice < 4) {
+                bool isNew = expected.find(keys[k]) == expected.end();
+                if (map->insert(&keys[k], &values[k]) != isNew) {
+                    matches = false;
+                }
+                expected[keys[k]] = &values[k];
+            }
+            else if (choice < 6) {
+                Pair<long long, int> removed = map->remove(keys[k]);
+                bool wasThere = expected.erase(keys[k]) == 1;
+                if (removed.isComplete() != wasThere || (wasThere && removed.second != &values[k])) {
+                    matches = false;
+                }
+            }
+            else {
+                std::unordered_map<long long, int*>::iterator found = expected.find(keys[k]);
+                int* value = map->get(keys[k]);
+                if (value != (found == expected.end() ? nullptr : found->second)) {
+                    matches = false;
+                }
+            }
+            if (step % 50000 == 0) {
+                map->reserve(numKeys);
+            }
+            if (step % 70000 == 0) {
+                map->rehash(16);
+            }
+        }
+        //
+        pointsPossible++;
+        int count = 0;
+        for (Pair<long long, int>& entry : *map) {
+            if (expected[*entry.first] != entry.second) {
+                matches = false;
+            }
+            count++;
+        }
+        if (matches && count == (int)expected.size() && map->getSize() == count) {
+            pointsEarned++;
+        }
+        else {
+            sout << "HashMap disagreed with std::unordered_map" << std::endl;
+        }
+        //
+        pointsPossible++;
+        HashMap<long long, int> moved(std::move(*map));
+        if (map->isEmpty() && map->get(keys[0]) == nullptr && moved.getSize() == count) {
+            pointsEarned++;
+        }
+        else {
+            sout << "moving a map did not hand over its entries" << std::endl;
+        }
+        delete map;
+
+        std::cout << "MapTester::test1 results:" << std::endl;
+        return new TestResults(pointsPossible, pointsEarned, sout.str());
+    }
+
+    /*
+     Test that an owning map deletes its keys and values, and that a
+     non-owning one leaves them alone.
+     */
+    static TestResults* test2() {
+        std::ostringstream sout;
+        int pointsPossible = 0;
+        int pointsEarned = 0;
+        //
+        pointsPossible++;
+        int liveItems = 0;
+        HashMap<int, CountedItem>* map = new HashMap<int, CountedItem>(100);
+        int capacity = map->getCapacity();
+        map->setOwnsData(true);
+        for (int k = 0; k < 100; k++) {
+            map->insert(new int(k), new CountedItem(&liveItems));
+        }
+        bool noGrowth = map->getCapacity() == capacity;
+        Pair<int, CountedItem> removed = map->remove(7);
+        delete map;
+        if (noGrowth && liveItems == 1) {
+            pointsEarned++;
+        }
+        else {
+            sout << "an owning map did not delete exactly its own data" << std::endl;
+        }
+        delete removed.first;
+        delete removed.second;
+        //
+        pointsPossible++;
+        CountedItem* item = new CountedItem(&liveItems);
+        int key = 1;
+        HashMap<int, CountedItem>* borrower = new HashMap<int, CountedItem>();
+        borrower->insert(&key, item);
+        delete borrower;
+        if (liveItems == 1) {
+            pointsEarned++;
+        }
+        else {
+            sout << "a non-owning map deleted data it did not own" << std::endl;
+        }
+        delete item;
+
+        std::cout << "MapTester::test2 results:" << std::endl;
+        return new TestResults(pointsPossible, pointsEarned, sout.str());
+    }
+
+    /*
+     Test a long random run of inserts, removes, lookups and bound queries
+     on OrderedMap against std::map, then iteration in both directions.
+     */
+    static TestResults* test3() {
+        std::ostringstream sout;
+        int pointsPossible = 0;
+        int pointsEarned = 0;
+        //
+        const int numKeys = 3000;
+        std::vector<int> keys(numKeys);
+        std::vector<int> values(numKeys);
+        for (int k = 0; k < numKeys; k++) {
+            keys[k] = k * 3;
+            values[k] = k;
+        }
+        OrderedMap<int, int>* map = new OrderedMap<int, int>();
+        std::map<int, int*> expected;
+        unsigned int seed = 5;
+        bool matches = true;
+        for (int step = 0; step < 100000; step++) {
+            seed = seed * 1103515245 + 12345;
+            int k = (int)((seed >> 8) % numKeys);
+            int choice = (seed >> 4) % 8;
+            if (choice < 3) {
+                bool isNew = expected.find(keys[k]) == expected.end();
+                if (map->insert(&keys[k], &values[k]) != isNew) {
+                    matches = false;
+                }
+                expected[keys[k]] = &values[k];
+            }
+            else if (choice < 5) {
+                Pair<int, int> removed = map->remove(keys[k]);
+                bool wasThere = expected.erase(keys[k]) == 1;
+                if (removed.isComplete() != wasThere || (wasThere && removed.second != &values[k])) {
+                    matches = false;
+                }
+            }
+            else if (choice < 6) {
+                std::map<int, int*>::iterator found = expected.find(keys[k]);
+                if (map->get(keys[k]) != (found == expected.end() ? nullptr : found->second)) {
+                    matches = false;
+                }
+            }
+            else {
+                // probe between and on keys
+                int probe = keys[k] - (int)(seed % 2);
+                std::map<int, int*>::iterator lower = expected.lower_bound(probe);
+                std::map<int, int*>::iterator upper = expected.upper_bound(probe);
+                OrderedMap<int, int>::iterator mapLower = map->lowerBound(probe);
+                OrderedMap<int, int>::iterator mapUpper = map->upperBound(probe);
+                if ((lower == expected.end()) != (mapLower == map->end())
+                    || (lower != expected.end() && *mapLower->first != lower->first)
+                    || (upper == expected.end()) != (mapUpper == map->end())
+                    || (upper != expected.end() && *mapUpper->first != upper->first)) {
+                    matches = false;
+                }
+            }
+        }
+        //
+        pointsPossible++;
+        int count = 0;
+        std::map<int, int*>::iterator next = expected.begin();
+        for (Pair<int, int>& entry : *map) {
+            if (next == expected.end() || *entry.first != next->first || entry.second != next->second) {
+                matches = false;
+            }
+            else {
+                ++next;
+            }
+            count++;
+        }
+        if (matches && count == (int)expected.size() && map->getSize() == count) {
+            pointsEarned++;
+        }
+        else {
+            sout << "OrderedMap disagreed with std::map" << std::endl;
+        }
+        //
+        pointsPossible++;
+        bool backwards = true;
+        std::map<int, int*>::reverse_iterator previous = expected.rbegin();
+        OrderedMap<int, int>::iterator entry = map->end();
+        while (entry != map->begin()) {
+            --entry;
+            if (previous == expected.rend() || *entry->first != previous->first) {
+                backwards = false;
+                break;
+            }
+            ++previous;
+        }
+        if (backwards && previous == expected.rend() && *map->first()->first == expected.begin()->first
+            && *map->last()->first == expected.rbegin()->first) {
+            pointsEarned++;
+        }
+        else {
+            sout << "OrderedMap iterated backwards in the wrong order" << std::endl;
+        }
+        delete map;
+
+        std::cout << "MapTester::test3 results:" << std::endl;
+        return new TestResults(pointsPossible, pointsEarned, sout.str());
+    }
+
+    /*
+     Test an owning OrderedMap with string keys: string_view lookups, range
+     scans and deleting its data.
+     */
+    static TestResults* test4() {
+        std::ostringstream sout;
+        int pointsPossible = 0;
+        int pointsEarned = 0;
+        //
+        pointsPossible++;
+        int liveItems = 0;
+        OrderedMap<std::string, CountedItem>* map = new OrderedMap<std::string, CountedItem>();
+        map->setOwnsData(true);
+        const char* names[] = { "room07", "room03", "room12", "room01", "room09" };
+        for (const char* name : names) {
+            map->insert(new std::string(name), new CountedItem(&liveItems));
+        }
+        std::string inRange;
+        for (OrderedMap<std::string, CountedItem>::iterator entry = map->lowerBound(std::string_view("room03"));
+            entry != map->upperBound("room09"); ++entry) {
+            inRange += *entry->first + " ";
+        }
+        if (inRange == "room03 room07 room09 " && map->contains(std::string_view("room12"))
+            && !map->contains("room10") && map->getSize() == 5) {
+            pointsEarned++;
+        }
+        else {
+            sout << "string keys were ordered or looked up wrong" << std::endl;
+        }
+        //
+        pointsPossible++;
+        Pair<std::string, CountedItem> removed = map->remove("room01");
+        OrderedMap<std::string, CountedItem> moved(std::move(*map));
+        delete map;
+        bool survivedMove = liveItems == 5 && moved.getSize() == 4;
+        moved.clear();
+        if (survivedMove && liveItems == 1 && moved.isEmpty()) {
+            pointsEarned++;
+        }
+        else {
+            sout << "an owning OrderedMap did not delete exactly its own data" << std::endl;
+        }
+        delete removed.first;
+        delete removed.second;
+
+        std::cout << "MapTester::test4 results:" << std::endl;
+        return new TestResults(pointsPossible, pointsEarned, sout.str());
+    }
+
+    static TestResults* test5() {
+        std::ostringstream sout;
+        int pointsPossible = 0;
+        int pointsEarned = 0;
+        StringArena* arena = new StringArena(64);
+        //
+        pointsPossible++;
+        std::string text = "A dragon sleeps here.";
+        std::string_view* dragon = arena->intern(text);
+        text[0] = 'X';
+        std::string_view* empty = arena->intern("");
+        std::string longLine(100, 'g');
+        std::string_view* gold = arena->intern(longLine);
+        if (*dragon == "A dragon sleeps here." && arena->intern("A dragon sleeps here.") == dragon
+            && empty->empty() && arena->intern(std::string_view()) == empty && *gold == longLine
+            && arena->find("A dragon sleeps here.") == dragon && arena->find(text) == nullptr
+            && arena->getNumStrings() == 3 && arena->getNumInterned() == 5) {
+            pointsEarned++;
+        }
+        else {
+            sout << "equal text wasn't interned to one handle" << std::endl;
+        }
+        //
+        pointsPossible++;
+        // enough strings to fill many blocks and grow the table several times
+        std::vector<std::string_view*> handles;
+        for (int k = 0; k < 5000; k++) {
+            handles.push_back(arena->intern("line " + std::to_string(k)));
+        }
+        bool stable = *dragon == "A dragon sleeps here." && *gold == longLine;
+        for (int k = 0; k < 5000 && stable; k++) {
+            stable = *handles[k] == "line " + std::to_string(k) && arena->intern("line " + std::to_string(k)) == handles[k];
+        }
+        if (stable && arena->getNumStrings() == 5003 && arena->getBytesAllocated() >= arena->getTextBytes()) {
+            pointsEarned++;
+        }
+        else {
+            sout << "handles moved or changed as the arena grew" << std::endl;
+        }
+        //
+        pointsPossible++;
+        // a batch holding old text, new text and new text twice over
+        std::vector<std::string> batchText;
+        for (int k = 4990; k < 7000; k++) {
+            batchText.push_back("line " + std::to_string(k % 6000));
+        }
+        std::vector<std::string_view> batch(batchText.begin(), batchText.end());
+        std::vector<std::string_view*> batchHandles;
+        batchHandles.push_back(dragon);
+        arena->internAll(batch, batchHandles);
+        bool matched = batchHandles.size() == batch.size() + 1 && batchHandles[0] == dragon;
+        for (size_t k = 0; k < batch.size() && matched; k++) {
+            matched = *batchHandles[k + 1] == batch[k] && arena->intern(batch[k]) == batchHandles[k + 1];
+        }
+        if (matched && batchHandles[1] == handles[4990] && arena->getNumStrings() == 6003) {
+            pointsEarned++;
+        }
+        else {
+            sout << "internAll didn't give the handles intern gives" << std::endl;
+        }
+        //
+        pointsPossible++;
+        arena->clear();
+        if (arena->getNumStrings() == 0 && arena->getBytesAllocated() == 0 && arena->find("line 7") == nullptr
+            && *arena->intern("line 7") == "line 7" && arena->getNumStrings() == 1) {
+            pointsEarned++;
+        }
+        else {
+            sout << "a cleared arena still held strings" << std::endl;
+        }
+        delete arena;
+
+        std::cout << "MapTester::test5 results:" << std::endl;
+        return new TestResults(pointsPossible, pointsEarned, sout.str());
+    }
+
+    static TestResults* runAllTests() {
+        int totalPossible = 0;
+        int totalEarned = 0;
+
+        TestResults* r;
+
+        r = test0();
+        totalPossible += r->pointsPossible;
+        totalEarned += r->pointsEarned;
+        std::cout << r->toString() << std::endl;
+
+        r = test1();
+        totalPossible += r->pointsPossible;
+        totalEarned += r->pointsEarned;
+        std::cout << r->toString() << std::endl;
+
+        r = test2();
+        totalPossible += r->pointsPossible;
+        totalEarned += r->pointsEarned;
+        std::cout << r->toString() << std::endl;
+
+        r = test3();
+        totalPossible += r->pointsPossible;
+        totalEarned += r->pointsEarned;
+        std::cout << r->toString() << std::endl;
+
+        r = test4();
+        totalPossible += r->pointsPossible;
+        totalEarned += r->pointsEarned;
+        std::cout << r->toString() << std::endl;
+
+        r = test5();
+        totalPossible += r->pointsPossible;
+        totalEarned += r->pointsEarned;
+        std::cout << r->toString() << std::endl;
+
+        return new TestResults(totalPossible, totalEarned, "");
+    }
+
+};
@@ -0,0 +1,176 @@
+#pragma once
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+/*
+ A breakdown of the memory held by a data structure, filled in by its
+ reportMemory method. Each entry names one kind of storage, such as the
+ nodes of a list or the edge objects of a graph, with the number of items
+ of that kind and the bytes they take. Names are dotted paths, so a graph
+ named "world" reports its vertex list under "world.vertices" and that
+ list's index under "world.vertices.index".
+
+ Entries never overlap: the total is the sum of the entries. Bytes are the
+ sizes of the objects and arrays themselves (sizeof times the number
+ allocated, counting spare capacity), so they don't include the heap
+ allocator's own overhead per allocation; compare against
+ MemoryUsage::residentBytes to see that. Data that structures point to but
+ don't describe, such as the objects stored in a list, is not counted.
+
+ toKeyValue and toJson give the report in forms that are easy to scrape.
+ */
+class MemoryReport {
+
+public:
+
+    struct Entry {
+        std::string name;
+        long long count;
+        size_t bytes;
+    };
+
+protected:
+
+    std::vector<Entry> entries;
+
+    /*
+     Writes the specified text as a JSON string.
+     */
+    static void writeJsonString(std::ostringstream& sout, const std::string& text) {
+        sout << '"';
+        for (char c : text) {
+            if (c == '"' || c == '\\') {
+                sout << '\\' << c;
+            }
+            else if ((unsigned char)c < 0x20) {
+                static const char hex[] = "0123456789abcdef";
+                sout << "\\u00" << hex[(c >> 4) & 0xF] << hex[c & 0xF];
+            }
+            else {
+                sout << c;
+            }
+        }
+        sout << '"';
+    }
+
+public:
+
+    /*
+     Adds an entry for the specified number of items taking the specified
+     number of bytes. An entry with the same name as an earlier one is
+     merged into it.
+     */
+    void add(const std::string& name, long long count, size_t bytes) {
+        for (Entry& entry : this->entries) {
+            if (entry.name == name) {
+                entry.count += count;
+                entry.bytes += bytes;
+                return;
+            }
+        }
+        this->entries.push_back({ name, count, bytes });
+    }
+
+    int getNumEntries() {
+        return (int)this->entries.size();
+    }
+
+    /*
+     Returns the entry at the specified position, in the order entries were
+     added. The position must be less than getNumEntries().
+     */
+    const Entry& getEntry(int position) {
+        return this->entries[position];
+    }
+
+    /*
+     Returns the bytes of the entry with the specified name and of every
+     entry below it (whose name starts with the name and a dot), or 0 if
+     there are none.
+     */
+    size_t getBytes(const std::string& name) {
+        size_t bytes = 0;
+        for (Entry& entry : this->entries) {
+            if (entry.name == name
+                || (entry.name.size() > name.size() && entry.name.compare(0, name.size(), name) == 0
+                    && entry.name[name.size()] == '.')) {
+                bytes += entry.bytes;
+            }
+        }
+        return bytes;
+    }
+
+    /*
+     Returns the number of items of the entry with the specified name, or 0
+     if there is no such entry.
+     */
+    long long getCount(const std::string& name) {
+        for (Entry& entry : this->entries) {
+            if (entry.name == name) {
+                return entry.count;
+            }
+        }
+        return 0;
+    }
+
+    /*
+     Returns the sum of the bytes of every entry.
+     */
+    size_t getTotalBytes() {
+        size_t bytes = 0;
+        for (Entry& entry : this->entries) {
+            bytes += entry.bytes;
+        }
+        return bytes;
+    }
+
+    void clear() {
+        this->entries.clear();
+    }
+
+    /*
+     Returns the report as key=value lines, two per entry ("name.count=" and
+     "name.bytes="), followed by "total.bytes=".
+     */
+    std::string toKeyValue() {
+        std::ostringstream sout;
+        for (Entry& entry : this->entries) {
+            sout << entry.name << ".count=" << entry.count << std::endl;
+            sout << entry.name << ".bytes=" << entry.bytes << std::endl;
+        }
+        sout << "total.bytes=" << this->getTotalBytes() << std::endl;
+        return sout.str();
+    }
+
+    /*
+     Returns the report as a JSON object:
+         {"entries":[{"name":"...","count":n,"bytes":n},...],"total_bytes":n}
+     */
+    std::string toJson() {
+        std::ostringstream sout;
+        sout << "{\"entries\":[";
+        for (size_t k = 0; k < this->entries.size(); k++) {
+            sout << (k == 0 ? "" : ",") << "{\"name\":";
+            writeJsonString(sout, this->entries[k].name);
+            sout << ",\"count\":" << this->entries[k].count << ",\"bytes\":" << this->entries[k].bytes << "}";
+        }
+        sout << "],\"total_bytes\":" << this->getTotalBytes() << "}";
+        return sout.str();
+    }
+
+    /*
+     Returns a string representation of this report, one entry per line.
+     */
+    std::string toString() {
+        std::ostringstream sout;
+        sout << "MemoryReport at " << this << std::endl;
+        for (Entry& entry : this->entries) {
+            sout << entry.name << ": " << entry.count << " items, " << entry.bytes << " bytes" << std::endl;
+        }
+        sout << "total: " << this->getTotalBytes() << " bytes" << std::endl;
+        return sout.str();
+    }
+
+};
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <fstream>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
+#include <malloc.h>
+#pragma comment(lib, "psapi.lib")
+#else
+#include <unistd.h>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+#endif
+
+/*
+ Queries about the memory used by this process, for the soak tests and
+ benchmarks.
+ */
+class MemoryUsage {
+
+public:
+
+    /*
+     Returns the resident set size of this process in bytes, or 0 if it
+     cannot be determined on this platform.
+     */
+    static long long residentBytes() {
+#ifdef _WIN32
+        PROCESS_MEMORY_COUNTERS counters;
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+            return (long long)counters.WorkingSetSize;
+        }
+        return 0;
+#else
+        long long totalPages = 0;
+        long long residentPages = 0;
+        std::ifstream statm("/proc/self/statm");
+        if (statm >> totalPages >> residentPages) {
+            return residentPages * sysconf(_SC_PAGESIZE);
+        }
+        return 0;
+#endif
+    }
+
+    /*
+     Asks the heap to give the memory it holds free back to the system, so
+     that the resident set only counts what is in use. Does nothing where
+     the heap can't be asked.
+     */
+    static void releaseFreeMemory() {
+#ifdef _WIN32
+        _heapmin();
+#elif defined(__GLIBC__)
+        malloc_trim(0);
+#endif
+    }
+
+};
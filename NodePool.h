@@ -0,0 +1,148 @@
+#pragma once
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "MemoryReport.h"
+#include "Node.h"
+
+/*
+ A slab allocator for chain nodes. Nodes are carved out of slabs holding a
+ fixed number of nodes each, and released nodes are kept on a free list so
+ that later insertions reuse them instead of going back to the heap. Slabs
+ are only returned to the heap when the pool itself is destroyed.
+
+ A pool can be owned by one chain or shared by several. Chains that hand
+ nodes to each other (for example through List::splitAfter and append) must
+ use the same pool, since a node is always released to the pool of the chain
+ that removes it.
+ */
+template <typename T>
+class NodePool {
+
+protected:
+
+    /*
+     The number of nodes in each slab.
+     */
+    int nodesPerSlab;
+
+    /*
+     The slabs allocated so far.
+     */
+    std::vector<Node<T>*> slabs;
+
+    /*
+     Start of the free list. Free nodes are linked through their next node.
+     */
+    Node<T>* freeNodes;
+
+    /*
+     The number of nodes currently handed out by this pool.
+     */
+    int numLiveNodes;
+
+    /*
+     Allocates another slab and threads its nodes onto the free list.
+     */
+    void addSlab() {
+        Node<T>* slab = new Node<T>[this->nodesPerSlab];
+        for (int k = this->nodesPerSlab - 1; k >= 0; k--) {
+            slab[k].setNextNode(this->freeNodes);
+            this->freeNodes = &slab[k];
+        }
+        this->slabs.push_back(slab);
+    }
+
+public:
+
+    /*
+     Creates an empty pool that allocates the specified number of nodes at a
+     time.
+     */
+    NodePool(int nodesPerSlab = 256) {
+        this->nodesPerSlab = nodesPerSlab > 0 ? nodesPerSlab : 1;
+        this->freeNodes = nullptr;
+        this->numLiveNodes = 0;
+    }
+
+    NodePool(const NodePool<T>&) = delete;
+    NodePool<T>& operator=(const NodePool<T>&) = delete;
+
+    /*
+     Returns every slab to the heap. Any node still in use by a chain becomes
+     invalid, so a pool must outlive the chains that use it.
+     */
+    ~NodePool() {
+        for (Node<T>* slab : this->slabs) {
+            delete[] slab;
+        }
+    }
+
+    /*
+     Returns an unlinked node containing the specified data.
+     */
+    Node<T>* allocate(T* data) {
+        if (this->freeNodes == nullptr) {
+            this->addSlab();
+        }
+        Node<T>* result = this->freeNodes;
+        this->freeNodes = result->getNextNode();
+        result->setData(data);
+        result->setNextNode(nullptr);
+        result->setPreviousNode(nullptr);
+        this->numLiveNodes++;
+        return result;
+    }
+
+    /*
+     Puts the specified node back on the free list. The node must have been
+     allocated by this pool.
+     */
+    void release(Node<T>* node) {
+        node->setData(nullptr);
+        node->setPreviousNode(nullptr);
+        node->setNextNode(this->freeNodes);
+        this->freeNodes = node;
+        this->numLiveNodes--;
+    }
+
+    /*
+     Returns the number of nodes currently in use.
+     */
+    int getNumLiveNodes() {
+        return this->numLiveNodes;
+    }
+
+    /*
+     Returns the total number of nodes this pool has allocated from the heap.
+     */
+    int getCapacity() {
+        return (int)this->slabs.size() * this->nodesPerSlab;
+    }
+
+    /*
+     Adds the memory held by this pool to the specified report, under the
+     specified name: the pool object, its list of slabs and the nodes not
+     in use. Nodes in use are counted by the chains holding them.
+     */
+    void reportMemory(MemoryReport* report, const std::string& name) {
+        int numSpareNodes = this->getCapacity() - this->numLiveNodes;
+        report->add(name + ".object", 1, sizeof(*this));
+        report->add(name + ".slabs", (long long)this->slabs.size(), this->slabs.capacity() * sizeof(Node<T>*));
+        report->add(name + ".spare_nodes", numSpareNodes, numSpareNodes * sizeof(Node<T>));
+    }
+
+    /*
+     Returns a string representation of this pool.
+     */
+    std::string toString() {
+        std::ostringstream sout;
+        sout << "NodePool at " << this << std::endl;
+        sout << "Slabs: " << this->slabs.size() << " of " << this->nodesPerSlab << " nodes" << std::endl;
+        sout << "Live nodes: " << this->numLiveNodes << std::endl;
+        return sout.str();
+    }
+
+};
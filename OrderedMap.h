@@ -0,0 +1,482 @@
+#pragma once
+
+#include <functional>
+#include <iterator>
+#include <new>
+#include <sstream>
+#include <string>
+
+#include "Pair.h"
+
+/*
+ A templated class representing ordered maps. An OrderedMap<K, V> stores its
+ entries as Pair<K, V> sorted by key, and, like HashMap, manages pointers to
+ keys of type K and values of type V, comparing keys by the objects they
+ point to.
+
+ The map is a skip list: a sorted doubly linked list of nodes, the first
+ level, with sparser express lists stacked above it. Each node is on the
+ first level and, with probability 1/4 for each further level, on the
+ levels above, so a search starts on the top level and drops down a level
+ whenever the next node would overshoot. Insert, find and remove take
+ O(log n) expected time, and iterating from lowerBound or upperBound walks
+ the first level like a List.
+
+ The comparison is std::less<> by default, which lets a map with
+ std::string keys be searched with a std::string_view or a string literal.
+ If the map owns its data (see setOwnsData), clearing or destroying it
+ deletes every key and value in it.
+ */
+template <typename K, typename V, typename Compare = std::less<>>
+class OrderedMap {
+
+protected:
+
+    static const int MaxLevels = 24;
+
+    /*
+     A node of the skip list, with one forward link for each level it is on
+     and a backward link on the first level.
+     */
+    struct SkipNode {
+        Pair<K, V> entry;
+        SkipNode* previous;
+        int numLevels;
+        SkipNode** next;
+    };
+
+    /*
+     A sentinel on every level. Its forward links are the first node of
+     each level; it holds no entry.
+     */
+    SkipNode* head;
+
+    /*
+     The last node on the first level, or the null pointer if the map is
+     empty.
+     */
+    SkipNode* lastNode;
+
+    /*
+     The number of levels currently in use.
+     */
+    int numLevels;
+
+    int numEntries;
+
+    bool ownsData;
+
+    Compare less;
+
+    /*
+     State of the generator that picks node heights.
+     */
+    unsigned int seed;
+
+    /*
+     Creates a node on the specified number of levels. The forward links are
+     allocated in the same block, right after the node, so a search that
+     reaches a node finds its links on the same cache line.
+     */
+    static SkipNode* createNode(K* key, V* value, int numLevels) {
+        char* memory = new char[sizeof(SkipNode) + numLevels * sizeof(SkipNode*)];
+        SkipNode* node = new (memory) SkipNode();
+        node->entry.first = key;
+        node->entry.second = value;
+        node->previous = nullptr;
+        node->numLevels = numLevels;
+        node->next = reinterpret_cast<SkipNode**>(memory + sizeof(SkipNode));
+        for (int level = 0; level < numLevels; level++) {
+            node->next[level] = nullptr;
+        }
+        return node;
+    }
+
+    static void destroyNode(SkipNode* node) {
+        node->~SkipNode();
+        delete[] reinterpret_cast<char*>(node);
+    }
+
+    /*
+     Returns a random height, each extra level with probability 1/4.
+     */
+    int randomLevels() {
+        // xorshift, good enough for coin flips
+        this->seed ^= this->seed << 13;
+        this->seed ^= this->seed >> 17;
+        this->seed ^= this->seed << 5;
+        unsigned int bits = this->seed;
+        int levels = 1;
+        while (levels < MaxLevels && (bits & 3) == 0) {
+            levels++;
+            bits >>= 2;
+        }
+        return levels;
+    }
+
+    /*
+     Fills the specified array, for each level in use, with the last node on
+     that level whose key is less than the specified key (or the head).
+     */
+    template <typename Key>
+    void findPredecessors(const Key& key, SkipNode** predecessors) {
+        SkipNode* currentNode = this->head;
+        for (int level = this->numLevels - 1; level >= 0; level--) {
+            while (currentNode->next[level] != nullptr
+                && this->less(*currentNode->next[level]->entry.first, key)) {
+                currentNode = currentNode->next[level];
+            }
+            predecessors[level] = currentNode;
+        }
+    }
+
+    /*
+     Returns the first node whose key is not less than the specified key, or
+     the null pointer if there is none.
+     */
+    template <typename Key>
+    SkipNode* lowerBoundNode(const Key& key) {
+        SkipNode* currentNode = this->head;
+        for (int level = this->numLevels - 1; level >= 0; level--) {
+            while (currentNode->next[level] != nullptr
+                && this->less(*currentNode->next[level]->entry.first, key)) {
+                currentNode = currentNode->next[level];
+            }
+        }
+        return currentNode->next[0];
+    }
+
+    /*
+     Returns the first node whose key is greater than the specified key, or
+     the null pointer if there is none.
+     */
+    template <typename Key>
+    SkipNode* upperBoundNode(const Key& key) {
+        SkipNode* currentNode = this->head;
+        for (int level = this->numLevels - 1; level >= 0; level--) {
+            while (currentNode->next[level] != nullptr
+                && !this->less(key, *currentNode->next[level]->entry.first)) {
+                currentNode = currentNode->next[level];
+            }
+        }
+        return currentNode->next[0];
+    }
+
+    /*
+     Returns the node whose key equals the specified key, or the null
+     pointer if there is none.
+     */
+    template <typename Key>
+    SkipNode* findNode(const Key& key) {
+        SkipNode* node = this->lowerBoundNode(key);
+        if (node != nullptr && !this->less(key, *node->entry.first)) {
+            return node;
+        }
+        return nullptr;
+    }
+
+public:
+
+    /*
+     A bidirectional iterator over the entries of an OrderedMap, in key
+     order. Removing an entry invalidates only iterators at that entry.
+     */
+    class iterator {
+
+    protected:
+
+        OrderedMap<K, V, Compare>* map;
+
+        SkipNode* currentNode;
+
+    public:
+
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef Pair<K, V> value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef Pair<K, V>* pointer;
+        typedef Pair<K, V>& reference;
+
+        iterator(OrderedMap<K, V, Compare>* map, SkipNode* currentNode) {
+            this->map = map;
+            this->currentNode = currentNode;
+        }
+
+        Pair<K, V>& operator*() const {
+            return this->currentNode->entry;
+        }
+
+        Pair<K, V>* operator->() const {
+            return &this->currentNode->entry;
+        }
+
+        iterator& operator++() {
+            this->currentNode = this->currentNode->next[0];
+            return *this;
+        }
+
+        iterator operator++(int) {
+            iterator result = *this;
+            ++(*this);
+            return result;
+        }
+
+        /*
+         Moves back one entry. Decrementing end() reaches the last entry.
+         */
+        iterator& operator--() {
+            if (this->currentNode == nullptr) {
+                this->currentNode = this->map->lastNode;
+            }
+            else {
+                this->currentNode = this->currentNode->previous;
+            }
+            return *this;
+        }
+
+        iterator operator--(int) {
+            iterator result = *this;
+            --(*this);
+            return result;
+        }
+
+        bool operator==(const iterator& other) const {
+            return this->currentNode == other.currentNode;
+        }
+
+        bool operator!=(const iterator& other) const {
+            return this->currentNode != other.currentNode;
+        }
+
+    };
+
+    /*
+     Creates an empty map.
+     */
+    OrderedMap() {
+        this->head = createNode(nullptr, nullptr, MaxLevels);
+        this->lastNode = nullptr;
+        this->numLevels = 1;
+        this->numEntries = 0;
+        this->ownsData = false;
+        this->seed = 2463534242u;
+    }
+
+    OrderedMap(const OrderedMap<K, V, Compare>& other) = delete;
+
+    OrderedMap<K, V, Compare>& operator=(const OrderedMap<K, V, Compare>& other) = delete;
+
+    /*
+     Creates a map by taking over the nodes of the specified map, which is
+     left empty. Runs in constant time.
+     */
+    OrderedMap(OrderedMap<K, V, Compare>&& other) {
+        this->head = other.head;
+        this->lastNode = other.lastNode;
+        this->numLevels = other.numLevels;
+        this->numEntries = other.numEntries;
+        this->ownsData = other.ownsData;
+        this->seed = other.seed;
+        other.head = createNode(nullptr, nullptr, MaxLevels);
+        other.lastNode = nullptr;
+        other.numLevels = 1;
+        other.numEntries = 0;
+        other.ownsData = false;
+    }
+
+    /*
+     Destroys this map, and its keys and values if it owns them.
+     */
+    ~OrderedMap() {
+        this->clear();
+        destroyNode(this->head);
+    }
+
+    /*
+     Removes every entry from this map. If this map owns its data, every
+     key and value is deleted as well.
+     */
+    void clear() {
+        SkipNode* currentNode = this->head->next[0];
+        while (currentNode != nullptr) {
+            SkipNode* nextNode = currentNode->next[0];
+            if (this->ownsData) {
+                delete currentNode->entry.first;
+                delete currentNode->entry.second;
+            }
+            destroyNode(currentNode);
+            currentNode = nextNode;
+        }
+        for (int level = 0; level < MaxLevels; level++) {
+            this->head->next[level] = nullptr;
+        }
+        this->lastNode = nullptr;
+        this->numLevels = 1;
+        this->numEntries = 0;
+    }
+
+    bool getOwnsData() {
+        return this->ownsData;
+    }
+
+    void setOwnsData(bool ownsData) {
+        this->ownsData = ownsData;
+    }
+
+    bool isEmpty() {
+        return this->numEntries == 0;
+    }
+
+    /*
+     Returns the number of entries in this map.
+     */
+    int getSize() {
+        return this->numEntries;
+    }
+
+    /*
+     Adds an entry with the specified key and value. If an equal key is
+     already in the map, returns false and leaves the map unaltered, and the
+     caller keeps responsibility for the specified key and value.
+     */
+    bool insert(K* key, V* value) {
+        SkipNode* predecessors[MaxLevels];
+        this->findPredecessors(*key, predecessors);
+        SkipNode* following = predecessors[0]->next[0];
+        if (following != nullptr && !this->less(*key, *following->entry.first)) {
+            return false;
+        }
+
+        int levels = this->randomLevels();
+        while (this->numLevels < levels) {
+            predecessors[this->numLevels] = this->head;
+            this->numLevels++;
+        }
+        SkipNode* newNode = createNode(key, value, levels);
+        for (int level = 0; level < levels; level++) {
+            newNode->next[level] = predecessors[level]->next[level];
+            predecessors[level]->next[level] = newNode;
+        }
+        newNode->previous = predecessors[0] == this->head ? nullptr : predecessors[0];
+        if (following != nullptr) {
+            following->previous = newNode;
+        }
+        else {
+            this->lastNode = newNode;
+        }
+        this->numEntries++;
+        return true;
+    }
+
+    /*
+     Returns the entry whose key equals the specified key, or the null
+     pointer if there is none. The entry's value may be changed through the
+     returned pair, but not its key.
+     */
+    template <typename Key>
+    Pair<K, V>* find(const Key& key) {
+        SkipNode* node = this->findNode(key);
+        return node != nullptr ? &node->entry : nullptr;
+    }
+
+    /*
+     Returns the value stored under the specified key, or the null pointer
+     if the key is not in this map.
+     */
+    template <typename Key>
+    V* get(const Key& key) {
+        SkipNode* node = this->findNode(key);
+        return node != nullptr ? node->entry.second : nullptr;
+    }
+
+    template <typename Key>
+    bool contains(const Key& key) {
+        return this->findNode(key) != nullptr;
+    }
+
+    /*
+     Removes the entry whose key equals the specified key, and returns it.
+     If there is no such entry, returns an empty pair. The caller becomes
+     responsible for the returned key and value, even if this map owns its
+     data.
+     */
+    template <typename Key>
+    Pair<K, V> remove(const Key& key) {
+        Pair<K, V> result;
+        SkipNode* predecessors[MaxLevels];
+        this->findPredecessors(key, predecessors);
+        SkipNode* node = predecessors[0]->next[0];
+        if (node == nullptr || this->less(key, *node->entry.first)) {
+            return result;
+        }
+        for (int level = 0; level < node->numLevels; level++) {
+            predecessors[level]->next[level] = node->next[level];
+        }
+        if (node->next[0] != nullptr) {
+            node->next[0]->previous = node->previous;
+        }
+        else {
+            this->lastNode = node->previous;
+        }
+        while (this->numLevels > 1 && this->head->next[this->numLevels - 1] == nullptr) {
+            this->numLevels--;
+        }
+        result = node->entry;
+        destroyNode(node);
+        this->numEntries--;
+        return result;
+    }
+
+    /*
+     Returns an iterator at the first entry whose key is not less than the
+     specified key, or end() if there is none.
+     */
+    template <typename Key>
+    iterator lowerBound(const Key& key) {
+        return iterator(this, this->lowerBoundNode(key));
+    }
+
+    /*
+     Returns an iterator at the first entry whose key is greater than the
+     specified key, or end() if there is none.
+     */
+    template <typename Key>
+    iterator upperBound(const Key& key) {
+        return iterator(this, this->upperBoundNode(key));
+    }
+
+    /*
+     Returns the entry with the smallest key, or the null pointer if this
+     map is empty.
+     */
+    Pair<K, V>* first() {
+        return this->head->next[0] != nullptr ? &this->head->next[0]->entry : nullptr;
+    }
+
+    /*
+     Returns the entry with the largest key, or the null pointer if this map
+     is empty.
+     */
+    Pair<K, V>* last() {
+        return this->lastNode != nullptr ? &this->lastNode->entry : nullptr;
+    }
+
+    iterator begin() {
+        return iterator(this, this->head->next[0]);
+    }
+
+    iterator end() {
+        return iterator(this, nullptr);
+    }
+
+    /*
+     Returns a string representation of this map.
+     */
+    std::string toString() {
+        std::ostringstream sout;
+        sout << "OrderedMap at " << this << std::endl;
+        sout << this->numEntries << " entries on " << this->numLevels << " levels" << std::endl;
+        return sout.str();
+    }
+
+};
@@ -36,6 +36,42 @@ public:
         this->second = second;
     }
 
+    /*
+     Creates a pair pointing to the same data as the specified pair. A pair
+     never owns the data it points to, so copies are shallow.
+     */
+    Pair(const Pair<T, U>& other) {
+        this->first = other.first;
+        this->second = other.second;
+    }
+
+    /*
+     Creates a pair pointing to the data of the specified pair, and empties
+     the specified pair.
+     */
+    Pair(Pair<T, U>&& other) {
+        this->first = other.first;
+        this->second = other.second;
+        other.first = nullptr;
+        other.second = nullptr;
+    }
+
+    Pair<T, U>& operator=(const Pair<T, U>& other) {
+        this->first = other.first;
+        this->second = other.second;
+        return *this;
+    }
+
+    Pair<T, U>& operator=(Pair<T, U>&& other) {
+        if (this != &other) {
+            this->first = other.first;
+            this->second = other.second;
+            other.first = nullptr;
+            other.second = nullptr;
+        }
+        return *this;
+    }
+
     /*
      Returns true if and only if both elements of this pair are null.
      */
@@ -51,7 +87,8 @@ public:
     }
 
     /*
-     Swaps the elements of the pair.
+     Swaps the elements of the pair. The caller is responsible for deleting
+     the returned pair.
      */
     Pair<U, T>* swap() {
         return new Pair<U, T>(second, first);
@@ -122,7 +159,7 @@ public:
  same data item.
  */
 template <typename T, typename U>
-bool operator==(Pair<T, U>& lhs, Pair<T, U>& rhs) {
+bool operator==(const Pair<T, U>& lhs, const Pair<T, U>& rhs) {
     //    std::cout << "operator== here" << std::endl;
     return (lhs.first == rhs.first && lhs.second == rhs.second);
 }
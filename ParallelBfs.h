@@ -0,0 +1,521 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Vertex.h"
+#include "FrozenGraph.h"
+
+/*
+A breadth-first search of a FrozenGraph that spreads each level over
+several threads, for graphs with millions of rooms.
+
+The search is level-synchronous: every vertex at depth d is expanded before
+any at depth d + 1, the threads taking chunks of the level from a shared
+counter. A vertex is claimed by setting its bit in an atomic visited bitset,
+so each vertex gets exactly one parent however many threads reach it at
+once. Threads gather the next level in local buffers and copy them into the
+shared frontier a block at a time.
+
+The threads are started when the ParallelBfs is created and kept until it
+is destroyed. Between jobs they wait on a condition variable, so each level
+of a run, and each of the resets at its start, costs one wake-up of the
+pool rather than creating and joining threads.
+
+Each level is expanded in one of two directions. Top-down, the usual way,
+goes through the out-edges of the frontier. Bottom-up goes through every
+vertex not yet visited and looks through its in-edges for one in the
+frontier, stopping at the first it finds; when the frontier is a large part
+of the graph, that looks at far fewer edges. The search switches to
+bottom-up when the frontier's out-edges outnumber one fourteenth of the
+out-edges of the unvisited vertices, and back to top-down when the frontier
+shrinks below one twenty-fourth of the vertices (the thresholds of Beamer,
+Asanovic and Patterson's direction-optimizing BFS). The in-edges bottom-up
+needs are built once, when the ParallelBfs is created.
+
+After a run, getDepths and getParents give each vertex's depth and parent
+in the search tree, by id, with -1 for vertices the search didn't reach;
+the source is its own parent.
+*/
+template <typename T, typename U>
+class ParallelBfs {
+
+protected:
+
+	static const int ChunkSize = 1024;
+
+	/*
+	The number of next-level vertices a thread gathers before copying them
+	into the shared frontier.
+	*/
+	static const int BlockSize = 256;
+
+	static const int Alpha = 14;
+
+	static const int Beta = 24;
+
+	FrozenGraph<T, U>* graph;
+
+	int numThreads;
+
+	bool directionOptimizing;
+
+	int numVertices;
+
+	/*
+	The in-edges of each vertex, in compressed sparse row form like the
+	graph's out-edges.
+	*/
+	std::vector<int> inOffsets;
+
+	std::vector<int> inNeighbors;
+
+	std::vector<int> depths;
+
+	std::vector<int> parents;
+
+	int numWords;
+
+	std::atomic<uint64_t>* visited;
+
+	/*
+	The current level as a bitset, for bottom-up steps.
+	*/
+	std::atomic<uint64_t>* frontierBits;
+
+	std::atomic<uint64_t>* nextFrontierBits;
+
+	/*
+	The current and next levels. Both are numVertices long; the first
+	frontierSize and nextSize entries are in use.
+	*/
+	std::vector<int> frontier;
+
+	int frontierSize;
+
+	std::vector<int> nextFrontier;
+
+	std::atomic<int> nextSize;
+
+	std::atomic<int> nextChunk;
+
+	int numTopDownLevels;
+
+	int numBottomUpLevels;
+
+	/*
+	The pool: numThreads - 1 helper threads, the calling thread being the
+	last. The fields below are guarded by poolMutex.
+	*/
+	std::vector<std::thread> helpers;
+
+	std::mutex poolMutex;
+
+	/*
+	Signalled when a job is posted or the pool is stopping.
+	*/
+	std::condition_variable jobPosted;
+
+	/*
+	Signalled when the last helper on a job finishes it.
+	*/
+	std::condition_variable jobFinished;
+
+	/*
+	The current job, as a function called with jobArgument, and the number
+	of helpers it wants. Helpers numbered past that sit it out.
+	*/
+	void (*jobFunction)(void*);
+
+	void* jobArgument;
+
+	int jobHelpers;
+
+	/*
+	Counts the jobs posted, so a helper can tell a new job from the last one.
+	*/
+	uint64_t jobNumber;
+
+	int numBusyHelpers;
+
+	bool stopping;
+
+	template <typename Body>
+	static void callBody(void* body) {
+		(*(Body*)body)();
+	}
+
+	/*
+	Runs helper number helperNumber (from 1) until the pool is stopped,
+	taking every job posted after lastJob.
+	*/
+	void helperLoop(int helperNumber, uint64_t lastJob) {
+		std::unique_lock<std::mutex> lock(this->poolMutex);
+		while (true) {
+			this->jobPosted.wait(lock, [this, lastJob]() { return this->stopping || this->jobNumber != lastJob; });
+			if (this->stopping) {
+				return;
+			}
+			lastJob = this->jobNumber;
+			if (helperNumber > this->jobHelpers) {
+				continue;
+			}
+			void (*function)(void*) = this->jobFunction;
+			void* argument = this->jobArgument;
+			lock.unlock();
+			function(argument);
+			lock.lock();
+			this->numBusyHelpers--;
+			if (this->numBusyHelpers == 0) {
+				this->jobFinished.notify_one();
+			}
+		}
+	}
+
+	void startHelpers() {
+		this->stopping = false;
+		for (int k = 1; k < this->numThreads; k++) {
+			this->helpers.emplace_back(&ParallelBfs<T, U>::helperLoop, this, k, this->jobNumber);
+		}
+	}
+
+	void stopHelpers() {
+		{
+			std::lock_guard<std::mutex> lock(this->poolMutex);
+			this->stopping = true;
+		}
+		this->jobPosted.notify_all();
+		for (std::thread& helper : this->helpers) {
+			helper.join();
+		}
+		this->helpers.clear();
+	}
+
+	/*
+	Calls work(first, last) on chunks of the range 0 to count - 1, spread
+	over the pool, and returns when every chunk is done.
+	*/
+	template <typename Work>
+	void parallelFor(int count, Work work) {
+		this->nextChunk.store(0, std::memory_order_relaxed);
+		auto body = [this, count, &work]() {
+			for (int first = this->nextChunk.fetch_add(ChunkSize, std::memory_order_relaxed); first < count;
+				first = this->nextChunk.fetch_add(ChunkSize, std::memory_order_relaxed)) {
+				work(first, std::min(first + ChunkSize, count));
+			}
+		};
+		int numWorkers = std::min(this->numThreads, (count + ChunkSize - 1) / ChunkSize);
+		if (numWorkers <= 1) {
+			body();
+			return;
+		}
+		{
+			std::lock_guard<std::mutex> lock(this->poolMutex);
+			this->jobFunction = &callBody<decltype(body)>;
+			this->jobArgument = &body;
+			this->jobHelpers = numWorkers - 1;
+			this->numBusyHelpers = numWorkers - 1;
+			this->jobNumber++;
+		}
+		this->jobPosted.notify_all();
+		body();
+		std::unique_lock<std::mutex> lock(this->poolMutex);
+		this->jobFinished.wait(lock, [this]() { return this->numBusyHelpers == 0; });
+	}
+
+	/*
+	Copies the specified vertices to the end of the next level.
+	*/
+	void flush(std::vector<int>& block) {
+		if (!block.empty()) {
+			int start = this->nextSize.fetch_add((int)block.size(), std::memory_order_relaxed);
+			std::copy(block.begin(), block.end(), this->nextFrontier.begin() + start);
+			block.clear();
+		}
+	}
+
+	/*
+	Expands the frontier through its out-edges. Returns the number of
+	out-edges of the vertices found, which are at depth level + 1.
+	*/
+	long long stepTopDown(int level) {
+		std::atomic<long long> nextEdges(0);
+		this->parallelFor(this->frontierSize, [this, level, &nextEdges](int first, int last) {
+			std::vector<int> block;
+			block.reserve(BlockSize);
+			long long edgesFound = 0;
+			for (int k = first; k < last; k++) {
+				int vertex = this->frontier[k];
+				int outDegree = this->graph->getOutDegree(vertex);
+				const int* neighbors = this->graph->getNeighbors(vertex);
+				for (int j = 0; j < outDegree; j++) {
+					int neighbor = neighbors[j];
+					std::atomic<uint64_t>& word = this->visited[neighbor >> 6];
+					uint64_t bit = (uint64_t)1 << (neighbor & 63);
+					// check before claiming, since most neighbours are already taken
+					if ((word.load(std::memory_order_relaxed) & bit)
+						|| (word.fetch_or(bit, std::memory_order_relaxed) & bit)) {
+						continue;
+					}
+					this->parents[neighbor] = vertex;
+					this->depths[neighbor] = level + 1;
+					edgesFound += this->graph->getOutDegree(neighbor);
+					block.push_back(neighbor);
+					if ((int)block.size() == BlockSize) {
+						this->flush(block);
+					}
+				}
+			}
+			this->flush(block);
+			nextEdges.fetch_add(edgesFound, std::memory_order_relaxed);
+		});
+		return nextEdges.load();
+	}
+
+	/*
+	Finds the parent of each unvisited vertex among its in-neighbours in the
+	frontier. Returns the number of out-edges of the vertices found. Chunks
+	are whole words of the bitsets, so no two threads write the same word of
+	nextFrontierBits; visited words are still updated atomically, since the
+	search may go back to top-down.
+	*/
+	long long stepBottomUp(int level) {
+		std::atomic<long long> nextEdges(0);
+		this->parallelFor(this->numWords, [this, level, &nextEdges](int firstWord, int lastWord) {
+			std::vector<int> block;
+			block.reserve(BlockSize);
+			long long edgesFound = 0;
+			for (int w = firstWord; w < lastWord; w++) {
+				uint64_t unvisited = ~this->visited[w].load(std::memory_order_relaxed);
+				uint64_t found = 0;
+				for (int b = 0; b < 64 && unvisited != 0; b++) {
+					int vertex = w * 64 + b;
+					if (!((unvisited >> b) & 1) || vertex >= this->numVertices) {
+						continue;
+					}
+					for (int k = this->inOffsets[vertex]; k < this->inOffsets[vertex + 1]; k++) {
+						int inNeighbor = this->inNeighbors[k];
+						if ((this->frontierBits[inNeighbor >> 6].load(std::memory_order_relaxed) >> (inNeighbor & 63)) & 1) {
+							this->parents[vertex] = inNeighbor;
+							this->depths[vertex] = level + 1;
+							edgesFound += this->graph->getOutDegree(vertex);
+							found |= (uint64_t)1 << b;
+							block.push_back(vertex);
+							if ((int)block.size() == BlockSize) {
+								this->flush(block);
+							}
+							break;
+						}
+					}
+				}
+				this->nextFrontierBits[w].store(found, std::memory_order_relaxed);
+				if (found != 0) {
+					this->visited[w].fetch_or(found, std::memory_order_relaxed);
+				}
+			}
+			this->flush(block);
+			nextEdges.fetch_add(edgesFound, std::memory_order_relaxed);
+		});
+		return nextEdges.load();
+	}
+
+public:
+
+	/*
+	Prepares to search the specified graph, which must outlive this object,
+	with the specified number of threads (by default, one per hardware
+	thread).
+	*/
+	ParallelBfs(FrozenGraph<T, U>* graph, int numThreads = 0) {
+		this->graph = graph;
+		this->numThreads = numThreads > 0 ? numThreads : std::max(1, (int)std::thread::hardware_concurrency());
+		this->directionOptimizing = true;
+		this->numVertices = graph->getNumVertices();
+		this->numWords = (this->numVertices + 63) / 64;
+		this->numTopDownLevels = 0;
+		this->numBottomUpLevels = 0;
+
+		// count the in-edges of each vertex, then place them
+		this->inOffsets.assign(this->numVertices + 1, 0);
+		for (int vertex = 0; vertex < this->numVertices; vertex++) {
+			const int* neighbors = graph->getNeighbors(vertex);
+			for (int k = 0; k < graph->getOutDegree(vertex); k++) {
+				this->inOffsets[neighbors[k] + 1]++;
+			}
+		}
+		for (int vertex = 0; vertex < this->numVertices; vertex++) {
+			this->inOffsets[vertex + 1] += this->inOffsets[vertex];
+		}
+		this->inNeighbors.resize(graph->getNumEdges());
+		std::vector<int> rowEnds(this->inOffsets.begin(), this->inOffsets.end() - 1);
+		for (int vertex = 0; vertex < this->numVertices; vertex++) {
+			const int* neighbors = graph->getNeighbors(vertex);
+			for (int k = 0; k < graph->getOutDegree(vertex); k++) {
+				this->inNeighbors[rowEnds[neighbors[k]]++] = vertex;
+			}
+		}
+
+		this->depths.assign(this->numVertices, -1);
+		this->parents.assign(this->numVertices, -1);
+		this->visited = new std::atomic<uint64_t>[this->numWords];
+		this->frontierBits = new std::atomic<uint64_t>[this->numWords];
+		this->nextFrontierBits = new std::atomic<uint64_t>[this->numWords];
+		this->frontier.resize(this->numVertices);
+		this->frontierSize = 0;
+		this->nextFrontier.resize(this->numVertices);
+		this->nextSize.store(0);
+		this->nextChunk.store(0);
+
+		this->jobFunction = nullptr;
+		this->jobArgument = nullptr;
+		this->jobHelpers = 0;
+		this->jobNumber = 0;
+		this->numBusyHelpers = 0;
+		this->startHelpers();
+	}
+
+	ParallelBfs(const ParallelBfs<T, U>& other) = delete;
+
+	ParallelBfs<T, U>& operator=(const ParallelBfs<T, U>& other) = delete;
+
+	~ParallelBfs() {
+		this->stopHelpers();
+		delete[] this->visited;
+		delete[] this->frontierBits;
+		delete[] this->nextFrontierBits;
+	}
+
+	/*
+	Sets the number of threads later runs use, restarting the pool if that
+	changes its size.
+	*/
+	void setNumThreads(int numThreads) {
+		numThreads = std::max(1, numThreads);
+		if (numThreads != this->numThreads) {
+			this->stopHelpers();
+			this->numThreads = numThreads;
+			this->startHelpers();
+		}
+	}
+
+	int getNumThreads() {
+		return this->numThreads;
+	}
+
+	/*
+	If directionOptimizing is false, later runs expand every level top-down.
+	*/
+	void setDirectionOptimizing(bool directionOptimizing) {
+		this->directionOptimizing = directionOptimizing;
+	}
+
+	/*
+	Searches the graph from the vertex with the specified id, and returns
+	the number of vertices reached, including the source, or -1 if there is
+	no such id.
+	*/
+	int run(int sourceId) {
+		if (sourceId < 0 || sourceId >= this->numVertices) {
+			return -1;
+		}
+		this->parallelFor(this->numVertices, [this](int first, int last) {
+			std::fill(this->depths.begin() + first, this->depths.begin() + last, -1);
+			std::fill(this->parents.begin() + first, this->parents.begin() + last, -1);
+		});
+		this->parallelFor(this->numWords, [this](int first, int last) {
+			for (int w = first; w < last; w++) {
+				this->visited[w].store(0, std::memory_order_relaxed);
+			}
+		});
+		this->numTopDownLevels = 0;
+		this->numBottomUpLevels = 0;
+
+		this->depths[sourceId] = 0;
+		this->parents[sourceId] = sourceId;
+		this->visited[sourceId >> 6].store((uint64_t)1 << (sourceId & 63));
+		this->frontier[0] = sourceId;
+		this->frontierSize = 1;
+		int numReached = 1;
+		long long frontierEdges = this->graph->getOutDegree(sourceId);
+		long long unexploredEdges = this->graph->getNumEdges() - frontierEdges;
+		bool bottomUp = false;
+		for (int level = 0; this->frontierSize > 0; level++) {
+			if (this->directionOptimizing) {
+				if (!bottomUp && frontierEdges > unexploredEdges / Alpha) {
+					// the frontier bitset is only kept up to date bottom-up
+					bottomUp = true;
+					this->parallelFor(this->numWords, [this](int first, int last) {
+						for (int w = first; w < last; w++) {
+							this->frontierBits[w].store(0, std::memory_order_relaxed);
+						}
+					});
+					for (int k = 0; k < this->frontierSize; k++) {
+						int vertex = this->frontier[k];
+						this->frontierBits[vertex >> 6].fetch_or((uint64_t)1 << (vertex & 63), std::memory_order_relaxed);
+					}
+				}
+				else if (bottomUp && this->frontierSize < this->numVertices / Beta) {
+					bottomUp = false;
+				}
+			}
+			this->nextSize.store(0, std::memory_order_relaxed);
+			if (bottomUp) {
+				frontierEdges = this->stepBottomUp(level);
+				std::swap(this->frontierBits, this->nextFrontierBits);
+				this->numBottomUpLevels++;
+			}
+			else {
+				frontierEdges = this->stepTopDown(level);
+				this->numTopDownLevels++;
+			}
+			unexploredEdges -= frontierEdges;
+			std::swap(this->frontier, this->nextFrontier);
+			this->frontierSize = this->nextSize.load();
+			numReached += this->frontierSize;
+		}
+		return numReached;
+	}
+
+	/*
+	Searches the graph from the specified vertex. Returns the number of
+	vertices reached, or -1 if the vertex is not part of the graph.
+	*/
+	int run(Vertex<T>* source) {
+		return this->run(this->graph->getVertexId(source));
+	}
+
+	/*
+	Returns the depth of each vertex in the last run, by id, or -1 for
+	vertices it didn't reach.
+	*/
+	const std::vector<int>& getDepths() {
+		return this->depths;
+	}
+
+	/*
+	Returns the parent of each vertex in the last run's search tree, by id,
+	or -1 for vertices it didn't reach. The source is its own parent.
+	*/
+	const std::vector<int>& getParents() {
+		return this->parents;
+	}
+
+	/*
+	Returns the number of levels the last run expanded top-down.
+	*/
+	int getNumTopDownLevels() {
+		return this->numTopDownLevels;
+	}
+
+	/*
+	Returns the number of levels the last run expanded bottom-up.
+	*/
+	int getNumBottomUpLevels() {
+		return this->numBottomUpLevels;
+	}
+
+};
@@ -0,0 +1,258 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include "Vertex.h"
+#include "Graph.h"
+#include "IndexedHeap.h"
+#include "ArrayList.h"
+#include "List.h"
+
+/*
+Shortest paths over the edge weights of a Graph, by Dijkstra's algorithm or
+by A* with a heuristic supplied by the caller.
+
+A PathFinder answers one query at a time and keeps everything it works with
+between queries: the distance and predecessor of each vertex, by position
+in the graph's vertex list, and an IndexedHeap of the vertices still to be
+settled. Only the entries a query touched are reset before the next one, so
+once the buffers have grown to fit the graph a query allocates nothing,
+however large the graph and however short the path.
+
+	PathFinder<T, U> paths(graph);
+	if (!std::isnan(paths.findPath(npcRoom, playerRoom))) {
+		npc->moveTo(paths.getNextStep());
+	}
+
+Edge weights must not be negative. The graph must not change during a
+query; it may change between queries.
+*/
+template <typename T, typename U, template <typename> class Container = ArrayList>
+class PathFinder {
+
+protected:
+
+	Graph<T, U, Container>* graph;
+
+	/*
+	The length of the shortest path found so far to each vertex, by position,
+	or infinity for vertices the current query hasn't reached.
+	*/
+	std::vector<double> distances;
+
+	/*
+	The position of the vertex before each vertex on the shortest path found
+	so far to it, or -1.
+	*/
+	std::vector<int> predecessors;
+
+	/*
+	Each vertex reached by the current query, by position, so paths can be
+	read back without looking vertices up by position in the graph.
+	*/
+	std::vector<Vertex<T>*> reached;
+
+	/*
+	The positions the current query has reached, so their entries can be
+	reset.
+	*/
+	std::vector<int> reachedPositions;
+
+	IndexedHeap<double, 4> heap;
+
+	int sourcePosition;
+
+	int targetPosition;
+
+	double pathLength;
+
+	int numSettled;
+
+	/*
+	Resets the entries touched by the last query and makes room for every
+	vertex of the graph.
+	*/
+	void reset() {
+		for (int position : this->reachedPositions) {
+			this->distances[position] = std::numeric_limits<double>::infinity();
+			this->predecessors[position] = -1;
+			this->reached[position] = nullptr;
+		}
+		this->reachedPositions.clear();
+		this->heap.clear();
+		size_t numVertices = (size_t)this->graph->getNumVertices();
+		if (this->distances.size() < numVertices) {
+			this->distances.resize(numVertices, std::numeric_limits<double>::infinity());
+			this->predecessors.resize(numVertices, -1);
+			this->reached.resize(numVertices, nullptr);
+			this->heap.setIdRange((int)numVertices);
+		}
+		this->sourcePosition = -1;
+		this->targetPosition = -1;
+		this->pathLength = std::nan("");
+		this->numSettled = 0;
+	}
+
+	/*
+	Returns the position of the specified vertex, recording it as reached,
+	or -1 if it is not part of the graph.
+	*/
+	int reach(Vertex<T>* vertex) {
+		int position = this->graph->getVertexIndex(vertex);
+		if (position >= 0 && this->reached[position] == nullptr) {
+			this->reached[position] = vertex;
+			this->reachedPositions.push_back(position);
+		}
+		return position;
+	}
+
+	/*
+	A* from the "from" vertex to the "to" vertex; Dijkstra's algorithm when
+	the heuristic is always 0. A vertex whose distance improves after it has
+	been settled, which only an inconsistent heuristic can cause, goes back
+	into the heap, so any admissible heuristic gives shortest paths.
+	*/
+	template <typename Heuristic>
+	double search(Vertex<T>* from, Vertex<T>* to, Heuristic& heuristic) {
+		this->reset();
+		if (!this->graph->hasVertex(to)) {
+			return this->pathLength;
+		}
+		this->sourcePosition = this->reach(from);
+		if (this->sourcePosition < 0) {
+			return this->pathLength;
+		}
+		this->targetPosition = this->reach(to);
+		this->distances[this->sourcePosition] = 0;
+		this->heap.push(this->sourcePosition, heuristic(from));
+		while (!this->heap.isEmpty()) {
+			int position = this->heap.pop();
+			this->numSettled++;
+			if (position == this->targetPosition) {
+				this->pathLength = this->distances[position];
+				return this->pathLength;
+			}
+			Vertex<T>* vertex = this->reached[position];
+			double distance = this->distances[position];
+			int outDegree = vertex->getOutDegree();
+			for (int k = 0; k < outDegree; k++) {
+				Vertex<T>* neighbor = vertex->getOutVertex(k);
+				double weight = this->graph->getEdgeWeight(vertex, neighbor);
+				int neighborPosition = this->reach(neighbor);
+				// NaN weights and vertices outside the graph are skipped
+				if (neighborPosition < 0 || !(distance + weight < this->distances[neighborPosition])) {
+					continue;
+				}
+				this->distances[neighborPosition] = distance + weight;
+				this->predecessors[neighborPosition] = position;
+				this->heap.decreasePriority(neighborPosition, distance + weight + heuristic(neighbor));
+			}
+		}
+		return this->pathLength;
+	}
+
+public:
+
+	/*
+	Creates a path finder over the specified graph, which it does not own.
+	*/
+	PathFinder(Graph<T, U, Container>* graph) {
+		this->graph = graph;
+		this->sourcePosition = -1;
+		this->targetPosition = -1;
+		this->pathLength = std::nan("");
+		this->numSettled = 0;
+	}
+
+	/*
+	Finds a shortest path from the "from" vertex to the "to" vertex by
+	Dijkstra's algorithm, and returns its length: the sum of the weights of
+	its edges. Returns NaN if there is no path or either vertex is not part
+	of the graph.
+	*/
+	double findPath(Vertex<T>* from, Vertex<T>* to) {
+		auto noHeuristic = [](Vertex<T>*) { return 0.0; };
+		return this->search(from, to, noHeuristic);
+	}
+
+	/*
+	Finds a shortest path from the "from" vertex to the "to" vertex by A*,
+	and returns its length, or NaN if there is no path or either vertex is
+	not part of the graph. heuristic(vertex) must return a double no greater
+	than the length of the shortest path from the vertex to the "to" vertex,
+	such as the straight-line distance between rooms when edge weights are
+	corridor lengths. The closer the estimate, the fewer vertices A* visits.
+	*/
+	template <typename Heuristic>
+	double findPath(Vertex<T>* from, Vertex<T>* to, Heuristic heuristic) {
+		return this->search(from, to, heuristic);
+	}
+
+	/*
+	Returns the length of the path found by the last query, or NaN if it
+	found none.
+	*/
+	double getPathLength() {
+		return this->pathLength;
+	}
+
+	/*
+	Replaces the contents of the specified vector with the vertices of the
+	path found by the last query, from its first vertex to its last, and
+	returns their number, or 0 if the last query found no path. Passing the
+	same vector each time avoids allocating.
+	*/
+	int getPath(std::vector<Vertex<T>*>& path) {
+		path.clear();
+		if (std::isnan(this->pathLength)) {
+			return 0;
+		}
+		for (int position = this->targetPosition; position >= 0; position = this->predecessors[position]) {
+			path.push_back(this->reached[position]);
+		}
+		std::reverse(path.begin(), path.end());
+		return (int)path.size();
+	}
+
+	/*
+	Returns a list of the vertices of the path found by the last query, which
+	is empty if it found none. The caller is responsible for deleting the
+	returned list.
+	*/
+	List<Vertex<T>>* getPathList() {
+		List<Vertex<T>>* result = new List<Vertex<T>>();
+		if (!std::isnan(this->pathLength)) {
+			for (int position = this->targetPosition; position >= 0; position = this->predecessors[position]) {
+				result->insertAtStart(this->reached[position]);
+			}
+		}
+		return result;
+	}
+
+	/*
+	Returns the second vertex of the path found by the last query, the one
+	to move to first, or the null pointer if the query found no path or the
+	path has no edges.
+	*/
+	Vertex<T>* getNextStep() {
+		if (std::isnan(this->pathLength) || this->targetPosition == this->sourcePosition) {
+			return nullptr;
+		}
+		int position = this->targetPosition;
+		while (this->predecessors[position] != this->sourcePosition) {
+			position = this->predecessors[position];
+		}
+		return this->reached[position];
+	}
+
+	/*
+	Returns the number of vertices the last query took off its heap, a
+	measure of how much of the graph it explored.
+	*/
+	int getNumSettled() {
+		return this->numSettled;
+	}
+
+};
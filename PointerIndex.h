@@ -0,0 +1,388 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+#include "MemoryReport.h"
+
+/*
+ A hash index from data pointers to their positions in a list, used by the
+ list templates to answer getIndex and contains in constant expected time.
+
+ Positions are not stored directly. Each pointer is stored with a stamp, and
+ its position is its stamp minus a base that moves whenever an element is
+ added or removed at the start of the list. That keeps the index exact in
+ constant time for insertions and removals at either end, which is how
+ graphs and story lists are built.
+
+ Other changes are kept exact too, at a cost proportional to the number of
+ elements whose stamps have to change. When elements are inserted or
+ removed in the middle, the owning list moves either the elements before
+ the change or those after it, whichever are fewer, with moveOccurrence
+ and moveAllPositions; when it splits, appends or prepends, it records each
+ element moved between lists. The lists' own walks to the position already
+ cost that much, so the index doesn't change their complexity.
+
+ When a pointer occurs more than once in the list, the index keeps the
+ position of its first occurrence, matching getIndex. Removing a first
+ occurrence while later ones remain is the one change that can't be
+ followed, since the next occurrence is unknown; it marks the index stale,
+ and the owning list rebuilds it with one scan the next time it is queried.
+ Lists without repeated pointers, such as a graph's vertex and edge lists,
+ never need a rebuild.
+
+ The entries live in one flat array with linear probing, kept at most half
+ full, so a lookup is usually a single cache miss and adding an entry
+ allocates nothing until the array doubles.
+ */
+template <typename T>
+class PointerIndex {
+
+protected:
+
+    /*
+     A pointer, how many times it occurs in the list, and the stamp of its
+     first occurrence. A count of 0 marks an empty slot, so the null
+     pointer can be indexed like any other.
+     */
+    struct Slot {
+        const T* data;
+        int count;
+        long long stamp;
+    };
+
+    /*
+     The table, whose size is 0 or a power of two.
+     */
+    std::vector<Slot> slots;
+
+    int numEntries;
+
+    /*
+     64 minus the base-2 logarithm of the table size, so the top bits of a
+     mixed pointer pick its home slot.
+     */
+    int shift;
+
+    /*
+     The stamp of the element at position 0.
+     */
+    long long base;
+
+    /*
+     True if the entries no longer describe the list.
+     */
+    bool stale;
+
+    int homeOf(const T* data) {
+        return (int)(((uint64_t)(uintptr_t)data * 0x9E3779B97F4A7C15ULL) >> this->shift);
+    }
+
+    /*
+     Returns the slot holding the specified pointer, or -1 if it has none.
+     */
+    int find(const T* data) {
+        if (this->numEntries == 0) {
+            return -1;
+        }
+        int mask = (int)this->slots.size() - 1;
+        for (int slot = this->homeOf(data); this->slots[slot].count != 0; slot = (slot + 1) & mask) {
+            if (this->slots[slot].data == data) {
+                return slot;
+            }
+        }
+        return -1;
+    }
+
+    /*
+     Makes the table the specified size, a power of two large enough for
+     every entry, and puts the entries back.
+     */
+    void resize(size_t size) {
+        std::vector<Slot> oldSlots(size, Slot{ nullptr, 0, 0 });
+        oldSlots.swap(this->slots);
+        this->shift = 64;
+        while (((size_t)1 << (64 - this->shift)) < size) {
+            this->shift--;
+        }
+        int mask = (int)size - 1;
+        for (Slot& old : oldSlots) {
+            if (old.count != 0) {
+                int slot = this->homeOf(old.data);
+                while (this->slots[slot].count != 0) {
+                    slot = (slot + 1) & mask;
+                }
+                this->slots[slot] = old;
+            }
+        }
+    }
+
+    /*
+     Empties the specified slot, moving later entries of its probe run back
+     so that every entry stays reachable from its home slot.
+     */
+    void erase(int slot) {
+        int mask = (int)this->slots.size() - 1;
+        int hole = slot;
+        for (int next = (hole + 1) & mask; this->slots[next].count != 0; next = (next + 1) & mask) {
+            int home = this->homeOf(this->slots[next].data);
+            // the entry can fill the hole if the hole is between its home and it
+            if (((next - home) & mask) >= ((next - hole) & mask)) {
+                this->slots[hole] = this->slots[next];
+                hole = next;
+            }
+        }
+        this->slots[hole] = Slot{ nullptr, 0, 0 };
+        this->numEntries--;
+    }
+
+    void add(const T* data, long long stamp) {
+        int slot = this->find(data);
+        if (slot >= 0) {
+            this->slots[slot].count++;
+            if (stamp < this->slots[slot].stamp) {
+                this->slots[slot].stamp = stamp;
+            }
+            return;
+        }
+        if ((size_t)(this->numEntries + 1) * 2 > this->slots.size()) {
+            this->resize(this->slots.empty() ? 16 : this->slots.size() * 2);
+        }
+        int mask = (int)this->slots.size() - 1;
+        slot = this->homeOf(data);
+        while (this->slots[slot].count != 0) {
+            slot = (slot + 1) & mask;
+        }
+        this->slots[slot] = Slot{ data, 1, stamp };
+        this->numEntries++;
+    }
+
+    /*
+     Removes one occurrence of the specified pointer. If other occurrences
+     remain and the removed one might have been the first, the index is
+     marked stale.
+     */
+    void remove(const T* data, bool mightBeFirst) {
+        int slot = this->find(data);
+        if (slot >= 0) {
+            this->slots[slot].count--;
+            if (this->slots[slot].count == 0) {
+                this->erase(slot);
+            }
+            else if (mightBeFirst) {
+                this->stale = true;
+            }
+        }
+    }
+
+public:
+
+    PointerIndex() {
+        this->numEntries = 0;
+        this->shift = 64;
+        this->base = 0;
+        this->stale = false;
+    }
+
+    /*
+     Empties the index, keeping its table. An empty index describes an
+     empty list.
+     */
+    void clear() {
+        if (this->numEntries > 0) {
+            std::fill(this->slots.begin(), this->slots.end(), Slot{ nullptr, 0, 0 });
+        }
+        this->numEntries = 0;
+        this->base = 0;
+        this->stale = false;
+    }
+
+    /*
+     Makes room for the specified number of distinct pointers, so adding
+     that many doesn't grow the table.
+     */
+    void reserve(int capacity) {
+        size_t size = this->slots.empty() ? 16 : this->slots.size();
+        while ((size_t)capacity * 2 > size) {
+            size *= 2;
+        }
+        if (size > this->slots.size()) {
+            this->resize(size);
+        }
+    }
+
+    /*
+     Records that the specified data was inserted at the start of the list.
+     */
+    void addAtStart(const T* data) {
+        if (!this->stale) {
+            this->base--;
+            this->add(data, this->base);
+        }
+    }
+
+    /*
+     Records that the specified data was inserted at the end of a list that
+     previously had the specified size.
+     */
+    void addAtEnd(const T* data, int previousSize) {
+        if (!this->stale) {
+            this->add(data, this->base + previousSize);
+        }
+    }
+
+    /*
+     Records that the specified data was removed from the start of the list.
+     */
+    void removeFromStart(const T* data) {
+        if (!this->stale) {
+            this->base++;
+            this->remove(data, true);
+        }
+    }
+
+    /*
+     Records that the specified data was removed from the end of the list.
+     */
+    void removeFromEnd(const T* data) {
+        if (!this->stale) {
+            this->remove(data, false);
+        }
+    }
+
+    /*
+     Records that the data at the specified position of the list was replaced
+     by newData.
+     */
+    void replace(const T* oldData, const T* newData, int position) {
+        if (!this->stale) {
+            this->remove(oldData, true);
+            this->add(newData, this->base + position);
+        }
+    }
+
+    /*
+     Records that the specified data was inserted at the specified position,
+     after the positions of the other elements have been moved to make room.
+     */
+    void insertAt(const T* data, int position) {
+        if (!this->stale) {
+            this->add(data, this->base + position);
+        }
+    }
+
+    /*
+     Records that the occurrence of the specified data at the specified
+     position was removed, before the positions of the other elements are
+     moved to close the gap.
+     */
+    void removeAt(const T* data, int position) {
+        if (!this->stale) {
+            int slot = this->find(data);
+            if (slot >= 0) {
+                bool wasFirst = this->slots[slot].stamp == this->base + position;
+                this->slots[slot].count--;
+                if (this->slots[slot].count == 0) {
+                    this->erase(slot);
+                }
+                else if (wasFirst) {
+                    this->stale = true;
+                }
+            }
+        }
+    }
+
+    /*
+     Records that the occurrence of the specified data at oldPosition is now
+     at newPosition. When a run of elements moves, they must be recorded
+     from the last to the first if they moved to higher positions, and from
+     the first to the last if they moved to lower ones, so that a pointer
+     occurring twice in the run is moved only once.
+     */
+    void moveOccurrence(const T* data, int oldPosition, int newPosition) {
+        if (!this->stale) {
+            int slot = this->find(data);
+            if (slot >= 0 && this->slots[slot].stamp == this->base + oldPosition) {
+                this->slots[slot].stamp = this->base + newPosition;
+            }
+        }
+    }
+
+    /*
+     Records that every element moved by the specified number of positions
+     (negative for lower positions). Takes constant time.
+     */
+    void moveAllPositions(int delta) {
+        this->base -= delta;
+    }
+
+    /*
+     Records that the list was changed in some other way.
+     */
+    void invalidate() {
+        this->stale = true;
+    }
+
+    /*
+     Returns true if the index has to be rebuilt before it can be queried.
+     */
+    bool isStale() {
+        return this->stale;
+    }
+
+    /*
+     Rebuilds the index from the specified list, which can be any container
+     whose iterators yield T*.
+     */
+    template <typename Iterable>
+    void rebuild(Iterable& items) {
+        this->clear();
+        this->reserve((int)std::distance(std::begin(items), std::end(items)));
+        long long stamp = 0;
+        for (T* item : items) {
+            this->add(item, stamp);
+            stamp++;
+        }
+    }
+
+    /*
+     Returns true if and only if the specified pointer is in the list. The
+     index must not be stale.
+     */
+    bool contains(const T* data) {
+        return this->find(data) >= 0;
+    }
+
+    /*
+     Returns the position of the first occurrence of the specified pointer,
+     or a negative number if it is not in the list. The index must not be
+     stale.
+     */
+    int getPosition(const T* data) {
+        int slot = this->find(data);
+        if (slot < 0) {
+            return -1;
+        }
+        return (int)(this->slots[slot].stamp - this->base);
+    }
+
+    /*
+     Adds the memory held by this index to the specified report, under the
+     specified name: the index object and its table, counting the empty
+     slots.
+     */
+    void reportMemory(MemoryReport* report, const std::string& name) {
+        report->add(name + ".object", 1, sizeof(*this));
+        report->add(name + ".slots", (long long)this->slots.size(), this->slots.size() * sizeof(Slot));
+    }
+
+    /*
+     Returns the number of distinct pointers in the index.
+     */
+    int getNumEntries() {
+        return this->numEntries;
+    }
+
+};
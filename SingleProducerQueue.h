@@ -0,0 +1,179 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <sstream>
+#include <string>
+
+/*
+ A templated class representing bounded queues shared by exactly one
+ producer thread and one consumer thread. It has the same methods as
+ ConcurrentQueue, but since each position is only ever written by one
+ thread, pushing and popping need no compare-and-swap: the producer owns
+ the tail, the consumer owns the head, and each keeps a cached copy of the
+ other's position so that it only touches the shared one when the cached
+ copy says the queue is full (or empty).
+
+ As with ConcurrentQueue, the queue never owns the pointers it holds, and
+ the null pointer can't be pushed.
+ */
+template <typename T>
+class SingleProducerQueue {
+
+protected:
+
+    static const int CacheLineSize = 64;
+
+    T** slots;
+
+    size_t mask;
+
+    char padding0[CacheLineSize];
+
+    /*
+     The next position to write. Written by the producer only.
+     */
+    std::atomic<size_t> tail;
+
+    /*
+     The producer's last look at head.
+     */
+    size_t cachedHead;
+
+    char padding1[CacheLineSize - sizeof(std::atomic<size_t>) - sizeof(size_t)];
+
+    /*
+     The next position to read. Written by the consumer only.
+     */
+    std::atomic<size_t> head;
+
+    /*
+     The consumer's last look at tail.
+     */
+    size_t cachedTail;
+
+    char padding2[CacheLineSize - sizeof(std::atomic<size_t>) - sizeof(size_t)];
+
+public:
+
+    /*
+     Creates an empty queue with room for at least the specified number of
+     pointers. The capacity is rounded up to a power of two, and is at
+     least 2.
+     */
+    SingleProducerQueue(int capacity) {
+        size_t numSlots = 2;
+        while (numSlots < (size_t)capacity) {
+            numSlots *= 2;
+        }
+        this->slots = new T*[numSlots];
+        this->mask = numSlots - 1;
+        this->tail.store(0, std::memory_order_relaxed);
+        this->head.store(0, std::memory_order_relaxed);
+        this->cachedHead = 0;
+        this->cachedTail = 0;
+    }
+
+    SingleProducerQueue(const SingleProducerQueue<T>& other) = delete;
+
+    SingleProducerQueue<T>& operator=(const SingleProducerQueue<T>& other) = delete;
+
+    /*
+     Destroys this queue. Pointers still in the queue are dropped, not
+     deleted.
+     */
+    ~SingleProducerQueue() {
+        delete[] this->slots;
+    }
+
+    int getCapacity() {
+        return (int)(this->mask + 1);
+    }
+
+    /*
+     Returns the number of pointers in this queue. While the other thread is
+     working this is only an estimate.
+     */
+    int getSize() {
+        size_t currentHead = this->head.load(std::memory_order_acquire);
+        size_t currentTail = this->tail.load(std::memory_order_acquire);
+        return currentTail > currentHead ? (int)(currentTail - currentHead) : 0;
+    }
+
+    bool isEmpty() {
+        return this->getSize() == 0;
+    }
+
+    /*
+     Adds the specified data at the back of this queue. Returns false, and
+     leaves the queue unaltered, if the queue is full or the data is the
+     null pointer. Producer thread only.
+     */
+    bool push(T* data) {
+        return data != nullptr && this->pushBatch(&data, 1) == 1;
+    }
+
+    /*
+     Removes and returns the data at the front of this queue, or returns the
+     null pointer if the queue is empty. Consumer thread only.
+     */
+    T* pop() {
+        T* result = nullptr;
+        this->popBatch(&result, 1);
+        return result;
+    }
+
+    /*
+     Adds as many of the specified pointers as fit, in order, at the back of
+     this queue, and returns how many were added. None of the pointers may
+     be null. Producer thread only.
+     */
+    int pushBatch(T** items, int count) {
+        size_t currentTail = this->tail.load(std::memory_order_relaxed);
+        size_t capacity = this->mask + 1;
+        if (currentTail - this->cachedHead + count > capacity) {
+            this->cachedHead = this->head.load(std::memory_order_acquire);
+        }
+        size_t numFree = capacity - (currentTail - this->cachedHead);
+        int numPushed = numFree < (size_t)count ? (int)numFree : count;
+        for (int k = 0; k < numPushed; k++) {
+            this->slots[(currentTail + k) & this->mask] = items[k];
+        }
+        if (numPushed > 0) {
+            this->tail.store(currentTail + numPushed, std::memory_order_release);
+        }
+        return numPushed;
+    }
+
+    /*
+     Removes up to the specified number of pointers from the front of this
+     queue into the specified array, in order, and returns how many were
+     removed. Consumer thread only.
+     */
+    int popBatch(T** items, int maxCount) {
+        size_t currentHead = this->head.load(std::memory_order_relaxed);
+        if (this->cachedTail - currentHead < (size_t)maxCount) {
+            this->cachedTail = this->tail.load(std::memory_order_acquire);
+        }
+        size_t numReady = this->cachedTail - currentHead;
+        int numPopped = numReady < (size_t)maxCount ? (int)numReady : maxCount;
+        for (int k = 0; k < numPopped; k++) {
+            items[k] = this->slots[(currentHead + k) & this->mask];
+        }
+        if (numPopped > 0) {
+            this->head.store(currentHead + numPopped, std::memory_order_release);
+        }
+        return numPopped;
+    }
+
+    /*
+     Returns a string representation of this queue.
+     */
+    std::string toString() {
+        std::ostringstream sout;
+        sout << "SingleProducerQueue at " << this << std::endl;
+        sout << this->getSize() << " of " << this->getCapacity() << " slots in use" << std::endl;
+        return sout.str();
+    }
+
+};
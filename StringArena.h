@@ -0,0 +1,334 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#ifdef _MSC_VER
+#include <xmmintrin.h>
+#endif
+
+#include "MemoryReport.h"
+
+/*
+ Storage for many small strings that live as long as each other, such as
+ the story text of a game world. Text is copied into large blocks, one
+ after another, instead of into a heap allocation per string, and equal
+ strings are stored once: intern returns the same handle for the same
+ text every time.
+
+ A handle is a pointer to a std::string_view of the text. Handles are also
+ carved out of blocks, so neither a handle nor the text it views ever
+ moves, and a List<std::string_view> can hold handles directly as long as
+ it doesn't own its data. Handles and text stay valid until the arena is
+ cleared or destroyed, so an arena must outlive everything that holds its
+ handles.
+
+ Interning many strings one at a time waits on a cache miss in the table
+ for each new one once the table outgrows the caches. internAll takes a
+ batch instead: it hashes the whole batch and asks for every slot it will
+ probe before looking at any of them, so the misses overlap.
+ */
+class StringArena {
+
+protected:
+
+    static const int HandlesPerBlock = 1024;
+
+    /*
+     The number of bytes of text in each block. Strings longer than a
+     quarter of this get a block of their own.
+     */
+    size_t blockSize;
+
+    std::vector<char*> textBlocks;
+
+    char* freeText;
+
+    size_t freeTextSize;
+
+    size_t textBytesAllocated;
+
+    std::vector<std::string_view*> handleBlocks;
+
+    int freeHandles;
+
+    /*
+     A slot of the table: the handle of an interned string, or the null
+     pointer if the slot is empty, and the low 32 bits of the string's hash,
+     so a probe compares text only when they match.
+     */
+    struct Slot {
+        std::string_view* handle;
+        uint32_t hash;
+    };
+
+    /*
+     The interned strings, by hash, in an open-addressed table with linear
+     probing, at most 3/4 full.
+     */
+    std::vector<Slot> table;
+
+    /*
+     The hashes of the batch internAll is working on.
+     */
+    std::vector<uint32_t> batchHashes;
+
+    int numStrings;
+
+    size_t numTextBytes;
+
+    long long numInterned;
+
+    /*
+     Copies the specified text into a block and returns the copy.
+     */
+    const char* copyText(std::string_view text) {
+        if (text.size() > this->blockSize / 4) {
+            char* block = new char[text.size()];
+            std::memcpy(block, text.data(), text.size());
+            this->textBlocks.push_back(block);
+            this->textBytesAllocated += text.size();
+            return block;
+        }
+        if (text.size() > this->freeTextSize) {
+            this->freeText = new char[this->blockSize];
+            this->freeTextSize = this->blockSize;
+            this->textBlocks.push_back(this->freeText);
+            this->textBytesAllocated += this->blockSize;
+        }
+        char* copy = this->freeText;
+        std::memcpy(copy, text.data(), text.size());
+        this->freeText += text.size();
+        this->freeTextSize -= text.size();
+        return copy;
+    }
+
+    std::string_view* newHandle(const char* text, size_t size) {
+        if (this->freeHandles == 0) {
+            this->handleBlocks.push_back(new std::string_view[HandlesPerBlock]);
+            this->freeHandles = HandlesPerBlock;
+        }
+        std::string_view* handle = this->handleBlocks.back() + (HandlesPerBlock - this->freeHandles);
+        this->freeHandles--;
+        *handle = std::string_view(text, size);
+        return handle;
+    }
+
+    /*
+     Resizes the table to the specified power of two.
+     */
+    void resize(size_t newSize) {
+        std::vector<Slot> oldTable(newSize, Slot{ nullptr, 0 });
+        oldTable.swap(this->table);
+        for (Slot& entry : oldTable) {
+            if (entry.handle != nullptr) {
+                size_t slot = entry.hash & (newSize - 1);
+                while (this->table[slot].handle != nullptr) {
+                    slot = (slot + 1) & (newSize - 1);
+                }
+                this->table[slot] = entry;
+            }
+        }
+    }
+
+    static uint32_t hashOf(std::string_view text) {
+        return (uint32_t)std::hash<std::string_view>()(text);
+    }
+
+    /*
+     Interns text with the specified hash, once the table has room for it.
+     */
+    std::string_view* internHashed(std::string_view text, uint32_t hash) {
+        this->numInterned++;
+        size_t mask = this->table.size() - 1;
+        size_t slot = hash & mask;
+        while (this->table[slot].handle != nullptr) {
+            if (this->table[slot].hash == hash && *this->table[slot].handle == text) {
+                return this->table[slot].handle;
+            }
+            slot = (slot + 1) & mask;
+        }
+        std::string_view* handle = this->newHandle(text.empty() ? "" : this->copyText(text), text.size());
+        this->table[slot] = { handle, hash };
+        this->numStrings++;
+        this->numTextBytes += text.size();
+        return handle;
+    }
+
+public:
+
+    /*
+     Creates an empty arena that copies text into blocks of the specified
+     number of bytes.
+     */
+    StringArena(size_t blockSize = 1 << 16) {
+        this->blockSize = blockSize >= 16 ? blockSize : 16;
+        this->freeText = nullptr;
+        this->freeTextSize = 0;
+        this->textBytesAllocated = 0;
+        this->freeHandles = 0;
+        this->numStrings = 0;
+        this->numTextBytes = 0;
+        this->numInterned = 0;
+    }
+
+    StringArena(const StringArena&) = delete;
+    StringArena& operator=(const StringArena&) = delete;
+
+    /*
+     Returns every block to the heap. Handles from this arena become
+     invalid.
+     */
+    ~StringArena() {
+        this->clear();
+    }
+
+    /*
+     Returns the handle of a copy of the specified text, which is the same
+     handle each time for equal text. The handle must not be changed or
+     deleted.
+     */
+    std::string_view* intern(std::string_view text) {
+        this->reserve(this->numStrings + 1);
+        return this->internHashed(text, hashOf(text));
+    }
+
+    /*
+     Interns each of the specified texts in order, as intern would, and
+     appends their handles to the specified vector.
+     */
+    void internAll(const std::vector<std::string_view>& texts, std::vector<std::string_view*>& handles) {
+        this->reserve(this->numStrings + (int)texts.size());
+        size_t mask = this->table.size() - 1;
+        this->batchHashes.resize(texts.size());
+        for (size_t k = 0; k < texts.size(); k++) {
+            uint32_t hash = hashOf(texts[k]);
+            this->batchHashes[k] = hash;
+#ifdef _MSC_VER
+            _mm_prefetch((const char*)&this->table[hash & mask], _MM_HINT_T0);
+#else
+            __builtin_prefetch(&this->table[hash & mask]);
+#endif
+        }
+        for (size_t k = 0; k < texts.size(); k++) {
+            handles.push_back(this->internHashed(texts[k], this->batchHashes[k]));
+        }
+    }
+
+    /*
+     Makes room in the table for the specified number of strings, so
+     interning that many doesn't grow it again.
+     */
+    void reserve(int numStrings) {
+        size_t newSize = this->table.empty() ? 64 : this->table.size();
+        while (4 * (size_t)numStrings > 3 * newSize) {
+            newSize *= 2;
+        }
+        if (newSize != this->table.size()) {
+            this->resize(newSize);
+        }
+    }
+
+    /*
+     Returns the handle of the text equal to the specified text, or the null
+     pointer if no such text has been interned.
+     */
+    std::string_view* find(std::string_view text) {
+        if (this->table.empty()) {
+            return nullptr;
+        }
+        uint32_t hash = hashOf(text);
+        size_t mask = this->table.size() - 1;
+        for (size_t slot = hash & mask; this->table[slot].handle != nullptr; slot = (slot + 1) & mask) {
+            if (this->table[slot].hash == hash && *this->table[slot].handle == text) {
+                return this->table[slot].handle;
+            }
+        }
+        return nullptr;
+    }
+
+    /*
+     Returns the number of distinct strings in this arena.
+     */
+    int getNumStrings() {
+        return this->numStrings;
+    }
+
+    /*
+     Returns the number of times intern has been called, so
+     getNumInterned() - getNumStrings() strings were found already stored.
+     */
+    long long getNumInterned() {
+        return this->numInterned;
+    }
+
+    /*
+     Returns the number of bytes of distinct text in this arena.
+     */
+    size_t getTextBytes() {
+        return this->numTextBytes;
+    }
+
+    /*
+     Returns the number of bytes this arena has taken from the heap for
+     text, handles and its table.
+     */
+    size_t getBytesAllocated() {
+        return this->textBytesAllocated + this->handleBlocks.size() * HandlesPerBlock * sizeof(std::string_view)
+            + this->table.size() * sizeof(Slot);
+    }
+
+    /*
+     Adds the memory held by this arena to the specified report, under the
+     specified name: the arena object, its text blocks, its handle blocks
+     and its table. The last three add up to getBytesAllocated.
+     */
+    void reportMemory(MemoryReport* report, const std::string& name) {
+        report->add(name + ".object", 1, sizeof(*this));
+        report->add(name + ".text", (long long)this->textBlocks.size(), this->textBytesAllocated);
+        report->add(name + ".handles", this->numStrings,
+            this->handleBlocks.size() * HandlesPerBlock * sizeof(std::string_view));
+        report->add(name + ".table", (long long)this->table.size(), this->table.size() * sizeof(Slot));
+    }
+
+    /*
+     Frees all text and handles. Every handle from this arena becomes
+     invalid.
+     */
+    void clear() {
+        for (char* block : this->textBlocks) {
+            delete[] block;
+        }
+        for (std::string_view* block : this->handleBlocks) {
+            delete[] block;
+        }
+        this->textBlocks.clear();
+        this->handleBlocks.clear();
+        this->table.clear();
+        this->batchHashes.clear();
+        this->freeText = nullptr;
+        this->freeTextSize = 0;
+        this->textBytesAllocated = 0;
+        this->freeHandles = 0;
+        this->numStrings = 0;
+        this->numTextBytes = 0;
+        this->numInterned = 0;
+    }
+
+    /*
+     Returns a string representation of this arena.
+     */
+    std::string toString() {
+        std::ostringstream sout;
+        sout << "StringArena at " << this << std::endl;
+        sout << this->numStrings << " strings, " << this->numTextBytes << " bytes of text, "
+            << this->numInterned << " interned" << std::endl;
+        return sout.str();
+    }
+
+};
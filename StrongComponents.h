@@ -0,0 +1,473 @@
+#pragma once
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+#include "Vertex.h"
+#include "Graph.h"
+#include "ArrayList.h"
+#include "List.h"
+
+/*
+The strongly connected components of a Graph, and the condensation DAG they
+form, for validating worlds: a component with no edges out of it is a set
+of rooms that can't be left once entered.
+
+compute runs Tarjan's algorithm with an explicit stack rather than
+recursion, over a compressed copy of the graph's adjacency, so it handles
+graphs of tens of millions of vertices and paths of any length. It numbers
+the components from 0 in reverse topological order: every edge of the
+condensation goes from a larger component id to a smaller one, and the
+sinks are found first.
+
+After compute, edges added through this object's addEdge update the
+components incrementally instead of recomputing them. An edge within a
+component, or one that agrees with the current order of the condensation,
+costs next to nothing. An edge against the order is handled as in Pearce
+and Kelly's dynamic topological sort: the components between its ends are
+searched forwards and backwards, any that now lie on a cycle are merged,
+and the rest are reordered. Merged components take the id of one of their
+parts, so after incremental updates component ids are no longer
+contiguous, or in topological order; getNumComponents counts the live ones.
+
+Any other change to the graph (adding vertices or edges directly, removing
+anything) leaves the components stale until compute is called again.
+*/
+template <typename T, typename U, template <typename> class Container = ArrayList>
+class StrongComponents {
+
+protected:
+
+	Graph<T, U, Container>* graph;
+
+	/*
+	The component of each vertex, by position in the graph's vertex list. A
+	component that has been merged into another points to it through
+	mergedInto, so a vertex's component is found with findComponent.
+	*/
+	std::vector<int> vertexComponents;
+
+	std::vector<int> mergedInto;
+
+	std::vector<int> componentSizes;
+
+	/*
+	The edges of the condensation, by component. The lists can hold merged
+	ids and duplicates until they are tidied by getSuccessors or
+	getPredecessors.
+	*/
+	std::vector<std::vector<int>> successors;
+
+	std::vector<std::vector<int>> predecessors;
+
+	/*
+	A topological order of the components: an edge of the condensation goes
+	from a smaller order to a larger one. Used only by addEdge.
+	*/
+	std::vector<int> order;
+
+	int nextOrder;
+
+	int numComponents;
+
+	/*
+	Per-component scratch marks for addEdge's searches, with the stamp of
+	the current search, so they never need clearing.
+	*/
+	std::vector<int> forwardMarks;
+
+	std::vector<int> backwardMarks;
+
+	int searchStamp;
+
+	/*
+	Sorts the specified list of component ids, maps merged ids to live ones,
+	and drops duplicates and the specified component itself.
+	*/
+	void tidy(std::vector<int>& components, int self) {
+		for (int& component : components) {
+			component = this->findComponent(component);
+		}
+		std::sort(components.begin(), components.end());
+		components.erase(std::unique(components.begin(), components.end()), components.end());
+		components.erase(std::remove(components.begin(), components.end(), self), components.end());
+	}
+
+	/*
+	Returns the live component that the specified component has been merged
+	into, compressing the path to it.
+	*/
+	int findComponent(int component) {
+		int root = component;
+		while (this->mergedInto[root] != root) {
+			root = this->mergedInto[root];
+		}
+		while (this->mergedInto[component] != root) {
+			int next = this->mergedInto[component];
+			this->mergedInto[component] = root;
+			component = next;
+		}
+		return root;
+	}
+
+	/*
+	Returns the component of the specified vertex, giving it a component of
+	its own, last in the order, if it has no component yet.
+	*/
+	int componentOf(Vertex<T>* vertex) {
+		int position = this->graph->getVertexIndex(vertex);
+		if (position >= (int)this->vertexComponents.size()) {
+			this->vertexComponents.resize(position + 1, -1);
+		}
+		if (this->vertexComponents[position] < 0) {
+			int component = (int)this->mergedInto.size();
+			this->vertexComponents[position] = component;
+			this->mergedInto.push_back(component);
+			this->componentSizes.push_back(1);
+			this->successors.emplace_back();
+			this->predecessors.emplace_back();
+			this->order.push_back(this->nextOrder++);
+			this->forwardMarks.push_back(0);
+			this->backwardMarks.push_back(0);
+			this->numComponents++;
+			return component;
+		}
+		return this->findComponent(this->vertexComponents[position]);
+	}
+
+	/*
+	Marks, and collects in found, the components reachable from the specified
+	one along successors (if forward) or predecessors whose order is within
+	the specified bounds.
+	*/
+	void collect(int start, bool forward, int lowestOrder, int highestOrder, std::vector<int>& found) {
+		std::vector<int>& marks = forward ? this->forwardMarks : this->backwardMarks;
+		std::vector<int> stack(1, start);
+		marks[start] = this->searchStamp;
+		while (!stack.empty()) {
+			int component = stack.back();
+			stack.pop_back();
+			found.push_back(component);
+			for (int neighbor : forward ? this->successors[component] : this->predecessors[component]) {
+				neighbor = this->findComponent(neighbor);
+				if (marks[neighbor] != this->searchStamp && this->order[neighbor] >= lowestOrder
+					&& this->order[neighbor] <= highestOrder) {
+					marks[neighbor] = this->searchStamp;
+					stack.push_back(neighbor);
+				}
+			}
+		}
+	}
+
+	/*
+	Merges the specified components into the first of them.
+	*/
+	void merge(std::vector<int>& components) {
+		int target = components[0];
+		for (size_t k = 1; k < components.size(); k++) {
+			int component = components[k];
+			this->mergedInto[component] = target;
+			this->componentSizes[target] += this->componentSizes[component];
+			this->successors[target].insert(this->successors[target].end(),
+				this->successors[component].begin(), this->successors[component].end());
+			this->predecessors[target].insert(this->predecessors[target].end(),
+				this->predecessors[component].begin(), this->predecessors[component].end());
+			std::vector<int>().swap(this->successors[component]);
+			std::vector<int>().swap(this->predecessors[component]);
+		}
+		this->tidy(this->successors[target], target);
+		this->tidy(this->predecessors[target], target);
+		this->numComponents -= (int)components.size() - 1;
+	}
+
+public:
+
+	/*
+	Creates a component finder for the specified graph, which it does not
+	own. Call compute before asking for components.
+	*/
+	StrongComponents(Graph<T, U, Container>* graph) {
+		this->graph = graph;
+		this->nextOrder = 0;
+		this->numComponents = 0;
+		this->searchStamp = 0;
+	}
+
+	/*
+	Finds the strongly connected components of the graph from scratch, and
+	returns their number.
+	*/
+	int compute() {
+		int numVertices = this->graph->getNumVertices();
+
+		// copy the adjacency into compressed sparse row form, by position
+		std::vector<int> offsets(numVertices + 1, 0);
+		std::vector<int> targets;
+		targets.reserve(this->graph->getNumEdges());
+		int position = 0;
+		for (Vertex<T>* vertex : *this->graph->getVertices()) {
+			int outDegree = vertex->getOutDegree();
+			for (int k = 0; k < outDegree; k++) {
+				int target = this->graph->getVertexIndex(vertex->getOutVertex(k));
+				if (target >= 0) {
+					targets.push_back(target);
+				}
+			}
+			offsets[++position] = (int)targets.size();
+		}
+
+		// Tarjan's algorithm, with the recursion kept in frames: a frame is
+		// a vertex and the position of its next edge to follow
+		std::vector<int> indices(numVertices, -1);
+		std::vector<int> lowLinks(numVertices);
+		std::vector<int>& components = this->vertexComponents;
+		components.assign(numVertices, -1);
+		std::vector<int> tarjanStack;
+		std::vector<std::pair<int, int>> frames;
+		int nextIndex = 0;
+		int numFound = 0;
+		for (int root = 0; root < numVertices; root++) {
+			if (indices[root] >= 0) {
+				continue;
+			}
+			indices[root] = lowLinks[root] = nextIndex++;
+			tarjanStack.push_back(root);
+			frames.push_back(std::make_pair(root, offsets[root]));
+			while (!frames.empty()) {
+				int vertex = frames.back().first;
+				int& nextEdge = frames.back().second;
+				if (nextEdge < offsets[vertex + 1]) {
+					int target = targets[nextEdge++];
+					if (indices[target] < 0) {
+						indices[target] = lowLinks[target] = nextIndex++;
+						tarjanStack.push_back(target);
+						frames.push_back(std::make_pair(target, offsets[target]));
+					}
+					else if (components[target] < 0) {
+						// the target is still on the stack
+						lowLinks[vertex] = std::min(lowLinks[vertex], indices[target]);
+					}
+					continue;
+				}
+				frames.pop_back();
+				if (lowLinks[vertex] == indices[vertex]) {
+					int member;
+					do {
+						member = tarjanStack.back();
+						tarjanStack.pop_back();
+						components[member] = numFound;
+					} while (member != vertex);
+					numFound++;
+				}
+				if (!frames.empty()) {
+					int parent = frames.back().first;
+					lowLinks[parent] = std::min(lowLinks[parent], lowLinks[vertex]);
+				}
+			}
+		}
+
+		// the condensation, and the state addEdge needs
+		this->numComponents = numFound;
+		this->mergedInto.resize(numFound);
+		this->componentSizes.assign(numFound, 0);
+		this->successors.assign(numFound, std::vector<int>());
+		this->predecessors.assign(numFound, std::vector<int>());
+		this->order.resize(numFound);
+		for (int component = 0; component < numFound; component++) {
+			this->mergedInto[component] = component;
+			this->order[component] = numFound - 1 - component;
+		}
+		for (int vertex = 0; vertex < numVertices; vertex++) {
+			this->componentSizes[components[vertex]]++;
+			for (int k = offsets[vertex]; k < offsets[vertex + 1]; k++) {
+				if (components[vertex] != components[targets[k]]) {
+					this->successors[components[vertex]].push_back(components[targets[k]]);
+					this->predecessors[components[targets[k]]].push_back(components[vertex]);
+				}
+			}
+		}
+		for (int component = 0; component < numFound; component++) {
+			this->tidy(this->successors[component], component);
+			this->tidy(this->predecessors[component], component);
+		}
+		this->nextOrder = numFound;
+		this->forwardMarks.assign(numFound, 0);
+		this->backwardMarks.assign(numFound, 0);
+		this->searchStamp = 0;
+		return numFound;
+	}
+
+	/*
+	Adds an edge to the graph, as Graph::addEdge does, and updates the
+	components to match. Returns the number of components merged into one
+	by the new edge: 0 if it closed no cycle.
+	*/
+	int addEdge(Vertex<T>* from, Vertex<T>* to) {
+		if (this->graph->hasEdge(from, to)) {
+			return 0;
+		}
+		this->graph->addEdge(from, to);
+		int fromComponent = this->componentOf(from);
+		int toComponent = this->componentOf(to);
+		if (fromComponent == toComponent) {
+			return 0;
+		}
+		this->successors[fromComponent].push_back(toComponent);
+		this->predecessors[toComponent].push_back(fromComponent);
+		int lowestOrder = this->order[toComponent];
+		int highestOrder = this->order[fromComponent];
+		if (lowestOrder > highestOrder) {
+			return 0;
+		}
+
+		// the edge goes against the order: find what lies between its ends
+		this->searchStamp++;
+		std::vector<int> forward;
+		std::vector<int> backward;
+		this->collect(toComponent, true, lowestOrder, highestOrder, forward);
+		this->collect(fromComponent, false, lowestOrder, highestOrder, backward);
+		std::vector<int> slots;
+		for (int component : forward) {
+			slots.push_back(this->order[component]);
+		}
+		for (int component : backward) {
+			if (this->forwardMarks[component] != this->searchStamp) {
+				slots.push_back(this->order[component]);
+			}
+		}
+		std::sort(slots.begin(), slots.end());
+
+		// components both reachable from the new edge's end and reaching its
+		// start are on a cycle through it
+		std::vector<int> cycle;
+		if (this->forwardMarks[fromComponent] == this->searchStamp) {
+			cycle.push_back(fromComponent);
+			for (int component : forward) {
+				if (component != fromComponent && this->backwardMarks[component] == this->searchStamp) {
+					cycle.push_back(component);
+				}
+			}
+		}
+		auto byOrder = [this](int a, int b) { return this->order[a] < this->order[b]; };
+		std::vector<int> before;
+		for (int component : backward) {
+			if (this->forwardMarks[component] != this->searchStamp) {
+				before.push_back(component);
+			}
+		}
+		std::vector<int> after;
+		for (int component : forward) {
+			if (this->backwardMarks[component] != this->searchStamp) {
+				after.push_back(component);
+			}
+		}
+		std::sort(before.begin(), before.end(), byOrder);
+		std::sort(after.begin(), after.end(), byOrder);
+
+		// the components that only reach the start take the lowest slots,
+		// those only reachable from the end the highest, and a merged
+		// component the slot after the former
+		for (size_t k = 0; k < before.size(); k++) {
+			this->order[before[k]] = slots[k];
+		}
+		for (size_t k = 0; k < after.size(); k++) {
+			this->order[after[k]] = slots[slots.size() - after.size() + k];
+		}
+		if (!cycle.empty()) {
+			this->order[fromComponent] = slots[before.size()];
+			this->merge(cycle);
+		}
+		return (int)cycle.size();
+	}
+
+	/*
+	Returns the number of components.
+	*/
+	int getNumComponents() {
+		return this->numComponents;
+	}
+
+	/*
+	Returns the component of the specified vertex, or -1 if it is not part
+	of the graph or has been added since the components were computed.
+	*/
+	int getComponentId(Vertex<T>* vertex) {
+		return this->getComponentIdAt(this->graph->getVertexIndex(vertex));
+	}
+
+	/*
+	Returns the component of the vertex at the specified position in the
+	graph's vertex list, or -1 if there is no such position.
+	*/
+	int getComponentIdAt(int position) {
+		if (position < 0 || position >= (int)this->vertexComponents.size() || this->vertexComponents[position] < 0) {
+			return -1;
+		}
+		return this->findComponent(this->vertexComponents[position]);
+	}
+
+	/*
+	Returns true if and only if the two vertices are in the same component:
+	each can be reached from the other.
+	*/
+	bool isStronglyConnected(Vertex<T>* first, Vertex<T>* second) {
+		int component = this->getComponentId(first);
+		return component >= 0 && component == this->getComponentId(second);
+	}
+
+	/*
+	Returns the number of vertices in the specified component, or 0 if
+	there is no such live component.
+	*/
+	int getComponentSize(int component) {
+		if (component < 0 || component >= (int)this->mergedInto.size() || this->mergedInto[component] != component) {
+			return 0;
+		}
+		return this->componentSizes[component];
+	}
+
+	/*
+	Returns the components the specified component has edges to in the
+	condensation, sorted, without duplicates. The component must be live.
+	*/
+	const std::vector<int>& getSuccessors(int component) {
+		this->tidy(this->successors[component], component);
+		return this->successors[component];
+	}
+
+	/*
+	Returns the components with edges to the specified component in the
+	condensation, sorted, without duplicates. The component must be live.
+	*/
+	const std::vector<int>& getPredecessors(int component) {
+		this->tidy(this->predecessors[component], component);
+		return this->predecessors[component];
+	}
+
+	/*
+	Returns true if the specified component has no edges out of it: once
+	entered, its rooms can't be left.
+	*/
+	bool isSink(int component) {
+		return this->getComponentSize(component) > 0 && this->getSuccessors(component).empty();
+	}
+
+	/*
+	Returns a list of the vertices of the graph that lie in sink components
+	other than the specified one (normally the component of the goal room).
+	These are the trap rooms. The caller is responsible for deleting the
+	returned list.
+	*/
+	List<Vertex<T>>* getTrappedVertices(int exitComponent) {
+		List<Vertex<T>>* result = new List<Vertex<T>>();
+		int position = 0;
+		for (Vertex<T>* vertex : *this->graph->getVertices()) {
+			int component = this->getComponentIdAt(position++);
+			if (component >= 0 && component != exitComponent && this->isSink(component)) {
+				result->insertAtEnd(vertex);
+			}
+		}
+		return result;
+	}
+
+};
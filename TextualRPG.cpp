@@ -3,6 +3,11 @@
 #include "CharacterTypes.h"
 #include "CharacterTypesTester.h"
 #include "TestResults.h"
+#include "ChainTester.h"
+#include "GraphTester.h"
+#include "MapTester.h"
+#include "DataStructureBenchmarks.h"
+#include "GraphBenchmarks.h"
 
 int main()
 {
@@ -15,4 +20,16 @@ int main()
     //TestResults* r1 = CharacterTypesTester::runAllTests();
     //std::cout << r1->toString() << std::endl;
 
+    //TestResults* r2 = ChainTester::runAllTests();
+    //std::cout << r2->toString() << std::endl;
+
+    //TestResults* r3 = GraphTester::runAllTests();
+    //std::cout << r3->toString() << std::endl;
+
+    //TestResults* r4 = MapTester::runAllTests();
+    //std::cout << r4->toString() << std::endl;
+
+    //std::cout << DataStructureBenchmarks::runAllBenchmarks() << std::endl;
+    //std::cout << GraphBenchmarks::runAllBenchmarks() << std::endl;
+
 }
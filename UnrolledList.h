@@ -0,0 +1,774 @@
+#pragma once
+
+#include <cstddef>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <string>
+
+#include "MemoryReport.h"
+#include "PointerIndex.h"
+
+/*
+ A templated class representing unrolled lists. An UnrolledList<T> manages
+ pointers to objects of type T, like List<T>, and has the same public
+ methods, but each of its nodes holds up to NodeCapacity pointers in a small
+ array. Sequential scans therefore touch one node per NodeCapacity elements
+ instead of one node per element, and positional access skips whole nodes
+ at a time.
+ */
+template <typename T, int NodeCapacity = 16>
+class UnrolledList {
+
+protected:
+
+    /*
+     A node of an unrolled list: a run of up to NodeCapacity data pointers,
+     linked to its neighbouring runs.
+     */
+    class Block {
+
+    public:
+
+        T* items[NodeCapacity];
+
+        int count;
+
+        Block* nextBlock;
+
+        Block* previousBlock;
+
+        Block() {
+            this->count = 0;
+            this->nextBlock = nullptr;
+            this->previousBlock = nullptr;
+        }
+
+        bool isFull() {
+            return this->count == NodeCapacity;
+        }
+
+    };
+
+    /*
+     Pointer to the first block of this list.
+     */
+    Block* startBlock;
+
+    /*
+     Pointer to the last block of this list.
+     */
+    Block* endBlock;
+
+    /*
+     The number of elements in this list.
+     */
+    int numItems;
+
+    /*
+     True if this list owns the data it points to, as with Chain.
+     */
+    bool ownsData;
+
+    /*
+     Hash index from data pointers to positions, or the null pointer if this
+     list is not indexed, as with Chain.
+     */
+    PointerIndex<T>* pointerIndex;
+
+    PointerIndex<T>* getFreshIndex() {
+        if (this->pointerIndex->isStale()) {
+            this->pointerIndex->rebuild(*this);
+        }
+        return this->pointerIndex;
+    }
+
+    /*
+     Finds the block holding the specified position, walking from whichever
+     end of this list is nearer, and stores the position within that block
+     in offset. A position equal to the size of this list is located just
+     past the last element of the end block. The position must be valid.
+     */
+    Block* locate(int position, int& offset) {
+        Block* currentBlock;
+        if (position <= this->numItems / 2) {
+            currentBlock = this->startBlock;
+            while (position >= currentBlock->count && currentBlock->nextBlock != nullptr) {
+                position -= currentBlock->count;
+                currentBlock = currentBlock->nextBlock;
+            }
+        }
+        else {
+            int remaining = this->numItems - position;
+            currentBlock = this->endBlock;
+            while (remaining > currentBlock->count) {
+                remaining -= currentBlock->count;
+                currentBlock = currentBlock->previousBlock;
+            }
+            position = currentBlock->count - remaining;
+        }
+        offset = position;
+        return currentBlock;
+    }
+
+    /*
+     Records in the index, if there is one, that the elements from
+     suffixPosition on moved by delta positions, as with Chain: whichever of
+     the prefixLength unmoved elements and the moved ones are fewer is
+     walked.
+     */
+    void reindexAfterShift(int prefixLength, int suffixPosition, int delta) {
+        if (this->pointerIndex == nullptr || this->pointerIndex->isStale()) {
+            return;
+        }
+        int offset;
+        Block* block;
+        if (this->numItems - suffixPosition <= prefixLength) {
+            if (this->numItems == suffixPosition) {
+                return;
+            }
+            if (delta > 0) {
+                block = this->endBlock;
+                offset = block->count - 1;
+                for (int position = this->numItems - 1; position >= suffixPosition; position--) {
+                    this->pointerIndex->moveOccurrence(block->items[offset], position - delta, position);
+                    if (--offset < 0 && block->previousBlock != nullptr) {
+                        block = block->previousBlock;
+                        offset = block->count - 1;
+                    }
+                }
+            }
+            else {
+                block = this->locate(suffixPosition, offset);
+                for (int position = suffixPosition; position < this->numItems; position++) {
+                    this->pointerIndex->moveOccurrence(block->items[offset], position - delta, position);
+                    if (++offset == block->count && block->nextBlock != nullptr) {
+                        block = block->nextBlock;
+                        offset = 0;
+                    }
+                }
+            }
+        }
+        else {
+            this->pointerIndex->moveAllPositions(delta);
+            if (delta > 0) {
+                block = this->startBlock;
+                offset = 0;
+                for (int position = 0; position < prefixLength; position++) {
+                    this->pointerIndex->moveOccurrence(block->items[offset], position + delta, position);
+                    if (++offset == block->count && block->nextBlock != nullptr) {
+                        block = block->nextBlock;
+                        offset = 0;
+                    }
+                }
+            }
+            else if (prefixLength > 0) {
+                block = this->locate(prefixLength - 1, offset);
+                for (int position = prefixLength - 1; position >= 0; position--) {
+                    this->pointerIndex->moveOccurrence(block->items[offset], position + delta, position);
+                    if (--offset < 0 && block->previousBlock != nullptr) {
+                        block = block->previousBlock;
+                        offset = block->count - 1;
+                    }
+                }
+            }
+        }
+    }
+
+    /*
+     Moves the elements of the specified block from the specified offset
+     onwards into a new block linked in right after it, and returns the new
+     block.
+     */
+    Block* splitBlock(Block* block, int offset) {
+        Block* newBlock = new Block();
+        for (int k = offset; k < block->count; k++) {
+            newBlock->items[k - offset] = block->items[k];
+        }
+        newBlock->count = block->count - offset;
+        block->count = offset;
+        newBlock->nextBlock = block->nextBlock;
+        newBlock->previousBlock = block;
+        if (block->nextBlock != nullptr) {
+            block->nextBlock->previousBlock = newBlock;
+        }
+        else {
+            this->endBlock = newBlock;
+        }
+        block->nextBlock = newBlock;
+        return newBlock;
+    }
+
+    /*
+     Unlinks the specified block from this list and deletes it.
+     */
+    void unlinkBlock(Block* block) {
+        if (block->previousBlock != nullptr) {
+            block->previousBlock->nextBlock = block->nextBlock;
+        }
+        else {
+            this->startBlock = block->nextBlock;
+        }
+        if (block->nextBlock != nullptr) {
+            block->nextBlock->previousBlock = block->previousBlock;
+        }
+        else {
+            this->endBlock = block->previousBlock;
+        }
+        delete block;
+    }
+
+    /*
+     Makes this list empty without touching its blocks.
+     */
+    void release() {
+        this->startBlock = nullptr;
+        this->endBlock = nullptr;
+        this->numItems = 0;
+        if (this->pointerIndex != nullptr) {
+            this->pointerIndex->clear();
+        }
+    }
+
+public:
+
+    /*
+     A bidirectional iterator over the data pointers managed by an unrolled
+     list, with the same behaviour as Chain's iterators.
+     */
+    template <typename DataPointer>
+    class UnrolledIterator {
+
+        friend class UnrolledList<T, NodeCapacity>;
+
+        template <typename OtherDataPointer>
+        friend class UnrolledIterator;
+
+    protected:
+
+        Block* currentBlock;
+
+        int offset;
+
+        const UnrolledList<T, NodeCapacity>* list;
+
+        UnrolledIterator(Block* currentBlock, int offset, const UnrolledList<T, NodeCapacity>* list) {
+            this->currentBlock = currentBlock;
+            this->offset = offset;
+            this->list = list;
+        }
+
+    public:
+
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef DataPointer value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef DataPointer pointer;
+        typedef DataPointer reference;
+
+        UnrolledIterator() {
+            this->currentBlock = nullptr;
+            this->offset = 0;
+            this->list = nullptr;
+        }
+
+        operator UnrolledIterator<const T*>() const {
+            return UnrolledIterator<const T*>(this->currentBlock, this->offset, this->list);
+        }
+
+        reference operator*() const {
+            return this->currentBlock->items[this->offset];
+        }
+
+        pointer operator->() const {
+            return this->currentBlock->items[this->offset];
+        }
+
+        UnrolledIterator& operator++() {
+            this->offset++;
+            if (this->offset == this->currentBlock->count) {
+                this->currentBlock = this->currentBlock->nextBlock;
+                this->offset = 0;
+            }
+            return *this;
+        }
+
+        UnrolledIterator operator++(int) {
+            UnrolledIterator previous = *this;
+            ++(*this);
+            return previous;
+        }
+
+        UnrolledIterator& operator--() {
+            if (this->currentBlock == nullptr) {
+                this->currentBlock = this->list->endBlock;
+                this->offset = this->currentBlock->count - 1;
+            }
+            else if (this->offset == 0) {
+                this->currentBlock = this->currentBlock->previousBlock;
+                this->offset = this->currentBlock->count - 1;
+            }
+            else {
+                this->offset--;
+            }
+            return *this;
+        }
+
+        UnrolledIterator operator--(int) {
+            UnrolledIterator previous = *this;
+            --(*this);
+            return previous;
+        }
+
+        bool operator==(const UnrolledIterator& other) const {
+            return this->currentBlock == other.currentBlock && this->offset == other.offset;
+        }
+
+        bool operator!=(const UnrolledIterator& other) const {
+            return !(*this == other);
+        }
+
+    };
+
+    typedef UnrolledIterator<T*> iterator;
+    typedef UnrolledIterator<const T*> const_iterator;
+    typedef std::reverse_iterator<iterator> reverse_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    /*
+     Creates an empty list.
+     */
+    UnrolledList() {
+        this->startBlock = nullptr;
+        this->endBlock = nullptr;
+        this->numItems = 0;
+        this->ownsData = false;
+        this->pointerIndex = nullptr;
+    }
+
+    /*
+     Creates a non-owning copy of the specified list.
+     */
+    UnrolledList(const UnrolledList<T, NodeCapacity>& other) : UnrolledList() {
+        this->setIndexed(other.pointerIndex != nullptr);
+        for (Block* block = other.startBlock; block != nullptr; block = block->nextBlock) {
+            for (int k = 0; k < block->count; k++) {
+                this->insertAtEnd(block->items[k]);
+            }
+        }
+    }
+
+    /*
+     Creates a list by taking over the blocks of the specified list, which is
+     left empty. Runs in constant time.
+     */
+    UnrolledList(UnrolledList<T, NodeCapacity>&& other) {
+        this->startBlock = other.startBlock;
+        this->endBlock = other.endBlock;
+        this->numItems = other.numItems;
+        this->ownsData = other.ownsData;
+        this->pointerIndex = other.pointerIndex;
+        other.pointerIndex = nullptr;
+        other.release();
+        other.ownsData = false;
+    }
+
+    UnrolledList<T, NodeCapacity>& operator=(const UnrolledList<T, NodeCapacity>& other) {
+        if (this != &other) {
+            this->clear();
+            this->ownsData = false;
+            for (Block* block = other.startBlock; block != nullptr; block = block->nextBlock) {
+                for (int k = 0; k < block->count; k++) {
+                    this->insertAtEnd(block->items[k]);
+                }
+            }
+        }
+        return *this;
+    }
+
+    UnrolledList<T, NodeCapacity>& operator=(UnrolledList<T, NodeCapacity>&& other) {
+        if (this != &other) {
+            this->clear();
+            this->startBlock = other.startBlock;
+            this->endBlock = other.endBlock;
+            this->numItems = other.numItems;
+            this->ownsData = other.ownsData;
+            delete this->pointerIndex;
+            this->pointerIndex = other.pointerIndex;
+            other.pointerIndex = nullptr;
+            other.release();
+            other.ownsData = false;
+        }
+        return *this;
+    }
+
+    /*
+     Destroys the blocks of this list, and its data if this list owns it.
+     */
+    ~UnrolledList() {
+        this->clear();
+        delete this->pointerIndex;
+    }
+
+    /*
+     Removes every element from this list. If this list owns its data, the
+     data is deleted as well.
+     */
+    void clear() {
+        Block* block = this->startBlock;
+        while (block != nullptr) {
+            Block* nextBlock = block->nextBlock;
+            if (this->ownsData) {
+                for (int k = 0; k < block->count; k++) {
+                    delete block->items[k];
+                }
+            }
+            delete block;
+            block = nextBlock;
+        }
+        this->release();
+    }
+
+    bool getOwnsData() {
+        return this->ownsData;
+    }
+
+    void setOwnsData(bool ownsData) {
+        this->ownsData = ownsData;
+    }
+
+    /*
+     Turns the pointer index of this list on or off, as with Chain.
+     */
+    void setIndexed(bool indexed) {
+        if (indexed && this->pointerIndex == nullptr) {
+            this->pointerIndex = new PointerIndex<T>();
+            this->pointerIndex->rebuild(*this);
+        }
+        else if (!indexed && this->pointerIndex != nullptr) {
+            delete this->pointerIndex;
+            this->pointerIndex = nullptr;
+        }
+    }
+
+    bool isIndexed() {
+        return this->pointerIndex != nullptr;
+    }
+
+    /*
+     Returns true if and only if one of the pointers managed by this list
+     has the same value as the specified pointer.
+     */
+    bool contains(T* data) {
+        if (this->pointerIndex != nullptr) {
+            return this->getFreshIndex()->contains(data);
+        }
+        return this->getIndex(data) >= 0;
+    }
+
+    /*
+     Returns true if and only if this list has no elements.
+     */
+    bool isEmpty() {
+        return this->numItems == 0;
+    }
+
+    /*
+     Returns the number of elements in this list.
+     */
+    int getSize() {
+        return this->numItems;
+    }
+
+    /*
+     Returns a pointer to the data stored at the specified position of this
+     list, or the null pointer if there is no such position.
+     */
+    T* peek(int position) {
+        if (position < 0 || position >= this->numItems) {
+            return nullptr;
+        }
+        int offset;
+        Block* block = this->locate(position, offset);
+        return block->items[offset];
+    }
+
+    /*
+     Sets the data at the specified position. If the position does not exist
+     in this list, this method does nothing.
+     */
+    void setData(T* data, int position) {
+        if (position >= 0 && position < this->numItems) {
+            int offset;
+            Block* block = this->locate(position, offset);
+            if (this->pointerIndex != nullptr) {
+                this->pointerIndex->replace(block->items[offset], data, position);
+            }
+            block->items[offset] = data;
+        }
+    }
+
+    /*
+     Returns the index of the first occurance of the specified data pointer
+     in this list, or a negative number if it is not in this list.
+     */
+    int getIndex(T* data) {
+        if (this->pointerIndex != nullptr) {
+            return this->getFreshIndex()->getPosition(data);
+        }
+        int index = 0;
+        for (Block* block = this->startBlock; block != nullptr; block = block->nextBlock) {
+            for (int k = 0; k < block->count; k++) {
+                if (block->items[k] == data) {
+                    return index + k;
+                }
+            }
+            index += block->count;
+        }
+        return -1;
+    }
+
+    /*
+     Inserts the specified data into the list in the specified position. If
+     the position is past the end of the list, the data is inserted at the
+     end.
+     */
+    void insertAtPosition(int position, T* data) {
+        if (this->isEmpty()) {
+            this->startBlock = new Block();
+            this->endBlock = this->startBlock;
+        }
+        if (position < 0) {
+            position = 0;
+        }
+        if (position > this->numItems) {
+            position = this->numItems;
+        }
+        int offset;
+        Block* block = this->locate(position, offset);
+        if (block->isFull()) {
+            Block* newBlock = this->splitBlock(block, NodeCapacity / 2);
+            if (offset > block->count) {
+                offset -= block->count;
+                block = newBlock;
+            }
+        }
+        for (int k = block->count; k > offset; k--) {
+            block->items[k] = block->items[k - 1];
+        }
+        block->items[offset] = data;
+        block->count++;
+        this->numItems++;
+        if (this->pointerIndex != nullptr) {
+            this->reindexAfterShift(position, position + 1, 1);
+            this->pointerIndex->insertAt(data, position);
+        }
+    }
+
+    /*
+     Removes the element at the specified position, and returns its data. If
+     there is no element in the specified position, this method leaves the
+     list unaltered and returns the null pointer.
+     */
+    T* removeFromPosition(int position) {
+        if (position < 0 || position >= this->numItems) {
+            return nullptr;
+        }
+        int offset;
+        Block* block = this->locate(position, offset);
+        T* result = block->items[offset];
+        if (this->pointerIndex != nullptr) {
+            this->pointerIndex->removeAt(result, position);
+        }
+        for (int k = offset; k < block->count - 1; k++) {
+            block->items[k] = block->items[k + 1];
+        }
+        block->count--;
+        this->numItems--;
+
+        if (block->count == 0) {
+            this->unlinkBlock(block);
+        }
+        else if (block->nextBlock != nullptr && block->count + block->nextBlock->count <= NodeCapacity / 2) {
+            // merge sparse neighbours so that blocks stay reasonably full
+            Block* nextBlock = block->nextBlock;
+            for (int k = 0; k < nextBlock->count; k++) {
+                block->items[block->count + k] = nextBlock->items[k];
+            }
+            block->count += nextBlock->count;
+            this->unlinkBlock(nextBlock);
+        }
+        this->reindexAfterShift(position, position, -1);
+        return result;
+    }
+
+    void insertAtStart(T* data) {
+        this->insertAtPosition(0, data);
+    }
+
+    void insertAtEnd(T* data) {
+        this->insertAtPosition(this->numItems, data);
+    }
+
+    T* removeFromStart() {
+        return this->removeFromPosition(0);
+    }
+
+    T* removeFromEnd() {
+        return this->removeFromPosition(this->numItems - 1);
+    }
+
+    /*
+     Splits this list after the specified position, removing all elements
+     after that position from this list, and returning them as another list.
+     The caller is responsible for deleting the returned list.
+     */
+    UnrolledList<T, NodeCapacity>* splitAfter(int position) {
+        UnrolledList<T, NodeCapacity>* result = new UnrolledList<T, NodeCapacity>();
+        result->ownsData = this->ownsData;
+        if (position >= 0 && position < this->numItems - 1) {
+            int offset;
+            Block* block = this->locate(position, offset);
+            if (offset + 1 < block->count) {
+                this->splitBlock(block, offset + 1);
+            }
+            result->startBlock = block->nextBlock;
+            result->startBlock->previousBlock = nullptr;
+            result->endBlock = this->endBlock;
+            result->numItems = this->numItems - position - 1;
+            block->nextBlock = nullptr;
+            this->endBlock = block;
+            this->numItems = position + 1;
+            if (this->pointerIndex != nullptr) {
+                for (reverse_iterator current = result->rbegin(); current != result->rend(); ++current) {
+                    this->pointerIndex->removeFromEnd(*current);
+                }
+            }
+            result->setIndexed(this->pointerIndex != nullptr);
+        }
+        return result;
+    }
+
+    /*
+     Appends the specified list to this one. The blocks of the specified list
+     are moved into this list, leaving it empty.
+     */
+    void append(UnrolledList<T, NodeCapacity>* suffix) {
+        if (!suffix->isEmpty()) {
+            if (this->pointerIndex != nullptr) {
+                int position = this->numItems;
+                for (T* item : *suffix) {
+                    this->pointerIndex->addAtEnd(item, position);
+                    position++;
+                }
+            }
+            if (this->isEmpty()) {
+                this->startBlock = suffix->startBlock;
+            }
+            else {
+                this->endBlock->nextBlock = suffix->startBlock;
+                suffix->startBlock->previousBlock = this->endBlock;
+            }
+            this->endBlock = suffix->endBlock;
+            this->numItems += suffix->numItems;
+            suffix->release();
+        }
+    }
+
+    /*
+     Prepends the specified list to this one. The blocks of the specified
+     list are moved into this list, leaving it empty.
+     */
+    void prepend(UnrolledList<T, NodeCapacity>* prefix) {
+        if (!prefix->isEmpty()) {
+            if (this->pointerIndex != nullptr) {
+                for (reverse_iterator current = prefix->rbegin(); current != prefix->rend(); ++current) {
+                    this->pointerIndex->addAtStart(*current);
+                }
+            }
+            if (this->isEmpty()) {
+                this->endBlock = prefix->endBlock;
+            }
+            else {
+                this->startBlock->previousBlock = prefix->endBlock;
+                prefix->endBlock->nextBlock = this->startBlock;
+            }
+            this->startBlock = prefix->startBlock;
+            this->numItems += prefix->numItems;
+            prefix->release();
+        }
+    }
+
+    iterator begin() {
+        return iterator(this->startBlock, 0, this);
+    }
+
+    iterator end() {
+        return iterator(nullptr, 0, this);
+    }
+
+    const_iterator begin() const {
+        return const_iterator(this->startBlock, 0, this);
+    }
+
+    const_iterator end() const {
+        return const_iterator(nullptr, 0, this);
+    }
+
+    const_iterator cbegin() const {
+        return this->begin();
+    }
+
+    const_iterator cend() const {
+        return this->end();
+    }
+
+    reverse_iterator rbegin() {
+        return reverse_iterator(this->end());
+    }
+
+    reverse_iterator rend() {
+        return reverse_iterator(this->begin());
+    }
+
+    const_reverse_iterator rbegin() const {
+        return const_reverse_iterator(this->end());
+    }
+
+    const_reverse_iterator rend() const {
+        return const_reverse_iterator(this->begin());
+    }
+
+    /*
+     Adds the memory held by this list to the specified report, under the
+     specified name: the list object, its blocks (counting their unused
+     places) and the index, if any.
+     */
+    void reportMemory(MemoryReport* report, const std::string& name) {
+        long long numBlocks = 0;
+        for (Block* block = this->startBlock; block != nullptr; block = block->nextBlock) {
+            numBlocks++;
+        }
+        report->add(name + ".object", 1, sizeof(*this));
+        report->add(name + ".blocks", numBlocks, numBlocks * sizeof(Block));
+        if (this->pointerIndex != nullptr) {
+            this->pointerIndex->reportMemory(report, name + ".index");
+        }
+    }
+
+    /*
+     Returns a string representation of this list.
+     */
+    std::string toString() {
+        std::ostringstream sout;
+        sout << "UnrolledList at " << this << std::endl;
+        int numBlocks = 0;
+        for (Block* block = this->startBlock; block != nullptr; block = block->nextBlock) {
+            numBlocks++;
+        }
+        sout << this->numItems << " elements in " << numBlocks << " blocks of up to "
+            << NodeCapacity << std::endl;
+        return sout.str();
+    }
+
+};
@@ -0,0 +1,190 @@
+#pragma once
+
+#include <sstream>
+#include <string>
+#include <vector>
+#include "MemoryReport.h"
+
+/*
+A template representing a vertex of a directed graph. A vertex can store a
+pointer to data of type T, and keeps the adjacency of its graph: the
+vertices its outgoing edges lead to and the vertices its incoming edges
+come from, in the order the edges were added, except that removing a
+neighbour moves the last one into its place.
+
+A vertex never owns its data or its neighbours. Its adjacency is only
+changed through addOutVertex and removeOutVertexAt (or removeOutVertex),
+each of which updates both ends of the edge, so the out-list of one vertex
+and the in-lists of its neighbours always agree. Graph is the usual caller.
+
+Each entry of an out-list also holds the position of the matching entry in
+the neighbour's in-list, and the other way round, so an edge is unlinked
+from both lists in constant time once its out-list position is known.
+*/
+template <typename T>
+class Vertex
+{
+protected:
+
+	//Pointer to the data stored in the vertex
+	T* data;
+
+	//One end of an edge: the neighbour, and the position of the edge's entry in the
+	//neighbour's other list (its in-list for an out-list entry, and the other way round)
+	struct Link {
+		Vertex<T>* vertex;
+		int mirror;
+	};
+
+	//The vertices the outgoing edges lead to
+	std::vector<Link> outVertices;
+
+	//The vertices the incoming edges come from
+	std::vector<Link> inVertices;
+
+	//Removes the entry at the given position of this vertex's in-list by moving the
+	//last entry into its place, and points the moved entry's mirror back at its new
+	//position
+	void swapRemoveIn(int position) {
+		Link last = this->inVertices.back();
+		this->inVertices.pop_back();
+		if (position < (int)this->inVertices.size()) {
+			this->inVertices[position] = last;
+			last.vertex->outVertices[last.mirror].mirror = position;
+		}
+	}
+
+	//The same for the out-list
+	void swapRemoveOut(int position) {
+		Link last = this->outVertices.back();
+		this->outVertices.pop_back();
+		if (position < (int)this->outVertices.size()) {
+			this->outVertices[position] = last;
+			last.vertex->inVertices[last.mirror].mirror = position;
+		}
+	}
+
+public:
+
+	//Creates a vertex with no data and no neighbours
+	Vertex() {
+		this->data = nullptr;
+	}
+
+	//Creates a vertex storing the given data, with no neighbours
+	Vertex(T* data) {
+		this->data = data;
+	}
+
+	//A copy would hold neighbours whose lists don't mention it, so vertices can't be copied
+	Vertex(const Vertex<T>& other) = delete;
+	Vertex<T>& operator=(const Vertex<T>& other) = delete;
+
+	//The vertex doesn't own its data or its neighbours
+	~Vertex() {
+	}
+
+	T* getData() {
+		return this->data;
+	}
+
+	void setData(T* data) {
+		this->data = data;
+	}
+
+	int getOutDegree() {
+		return (int)this->outVertices.size();
+	}
+
+	int getInDegree() {
+		return (int)this->inVertices.size();
+	}
+
+	//Returns the vertex at the given position of the out-list, or the null pointer
+	//if there is no such position
+	Vertex<T>* getOutVertex(int position) {
+		if (position < 0 || position >= (int)this->outVertices.size()) {
+			return nullptr;
+		}
+		return this->outVertices[position].vertex;
+	}
+
+	//Returns the vertex at the given position of the in-list, or the null pointer
+	//if there is no such position
+	Vertex<T>* getInVertex(int position) {
+		if (position < 0 || position >= (int)this->inVertices.size()) {
+			return nullptr;
+		}
+		return this->inVertices[position].vertex;
+	}
+
+	//Records an edge from this vertex to the given vertex: the given vertex is added
+	//at the end of this vertex's out-list, and this vertex at the end of the given
+	//vertex's in-list. For a loop (the given vertex is this one) both happen to this
+	//vertex. Duplicates are not checked for; Graph does that. Returns the position
+	//of the new entry in the out-list
+	int addOutVertex(Vertex<T>* vertex) {
+		int position = (int)this->outVertices.size();
+		this->outVertices.push_back({ vertex, (int)vertex->inVertices.size() });
+		vertex->inVertices.push_back({ this, position });
+		return position;
+	}
+
+	//Makes room for the given numbers of outgoing and incoming neighbours, so adding
+	//that many doesn't reallocate either list
+	void reserve(int numOut, int numIn) {
+		this->outVertices.reserve(numOut);
+		this->inVertices.reserve(numIn);
+	}
+
+	//Undoes the addOutVertex whose entry is at the given position of the out-list:
+	//removes it, and the matching entry of the neighbour's in-list, each by moving
+	//the last entry of its list into its place. Returns false, and changes nothing,
+	//if there is no such position. Takes constant time; only the entries moved
+	//change position
+	bool removeOutVertexAt(int position) {
+		if (position < 0 || position >= (int)this->outVertices.size()) {
+			return false;
+		}
+		Link link = this->outVertices[position];
+		link.vertex->swapRemoveIn(link.mirror);
+		this->swapRemoveOut(position);
+		return true;
+	}
+
+	//Removes the first edge from this vertex to the given vertex, as removeOutVertexAt
+	//does. Returns false, and changes nothing, if the given vertex is not in the
+	//out-list. Takes time proportional to the out-degree, to find the entry
+	bool removeOutVertex(Vertex<T>* vertex) {
+		for (int k = 0; k < (int)this->outVertices.size(); k++) {
+			if (this->outVertices[k].vertex == vertex) {
+				return this->removeOutVertexAt(k);
+			}
+		}
+		return false;
+	}
+
+	//Adds the heap storage of this vertex's adjacency to the given report, under the
+	//given name: one item per outgoing and per incoming neighbour, and the bytes of
+	//the two arrays of links holding them, spare capacity included. The vertex object itself
+	//is left to whoever allocated it
+	void reportMemory(MemoryReport* report, const std::string& name) {
+		report->add(name, (long long)(this->outVertices.size() + this->inVertices.size()),
+			(this->outVertices.capacity() + this->inVertices.capacity()) * sizeof(Link));
+	}
+
+	//Returns a string representation of this vertex
+	std::string toString() {
+		std::ostringstream sout;
+		sout << "Vertex at " << this << std::endl;
+		if (this->data == nullptr) {
+			sout << "No data" << std::endl;
+		}
+		else {
+			sout << "Data at " << this->data << std::endl;
+		}
+		sout << "Out-degree " << this->outVertices.size() << ", in-degree " << this->inVertices.size() << std::endl;
+		return sout.str();
+	}
+
+};
@@ -0,0 +1,708 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Vertex.h"
+#include "Edge.h"
+#include "Graph.h"
+#include "List.h"
+#include "StringArena.h"
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/*
+A game world saved as a binary image that is memory-mapped and read in
+place, so opening a world never reads its story text, which is most of
+it: a 300 MB image opens in about ten milliseconds. The image holds a game
+world, a Graph<List<std::string_view>, List<std::string_view>> or a
+Graph<List<std::string>, List<std::string>>: its rooms, its edges and
+their weights, and the story lines stored in rooms and edges.
+
+WorldImage::write saves a graph; WorldImage::open maps a saved image,
+checks its header and layout, and validates its index arrays, so that no
+room, edge or story line a reader asks for can point outside the file.
+Validation reads the index arrays but not the text; an image known to be
+intact, such as one this program has just written, can skip it and open
+in constant time, in which case toGraph validates before copying.
+
+Rooms are numbered as in the graph's vertex list. The edges out of each
+room are numbered consecutively, so edge ids run from getFirstEdge(room)
+for getOutDegree(room) edges. Story lines come back as string_views into
+the mapping, valid for as long as the WorldImage exists. toGraph copies the
+image into an ordinary graph for code that needs one, with its story lines
+in a StringArena or in strings of their own.
+
+The file is a fixed header followed by 8-byte aligned arrays, all in the
+byte order of the machine that wrote it:
+
+	Header
+	uint32 edgeOffsets[numVertices + 1]       first edge of each room
+	uint32 edgeTargets[numEdges]
+	double edgeWeights[numEdges]
+	uint64 vertexLines[numVertices + 1]       first story line of each room
+	uint64 edgeLines[numEdges + 1]            first story line of each edge
+	uint8  vertexFlags[numVertices]           1 if the room has a story list
+	uint8  edgeFlags[numEdges]                1 if the edge has a story list
+	uint64 lineOffsets[numLines + 1]          start of each line in the text
+	char   text[]
+
+The header records a format version and a checksum of everything after it.
+The checksum is only computed by verifyChecksum, which reads the whole file.
+A file whose checksum fails but which validates can still be read safely;
+its contents are just not the ones that were written.
+*/
+class WorldImage {
+
+public:
+
+	static const uint32_t Version = 1;
+
+	/*
+	The fixed part at the start of every image. Offsets are from the start
+	of the file.
+	*/
+	struct Header {
+		char magic[8];
+		uint32_t version;
+		uint32_t byteOrder;
+		uint64_t fileSize;
+		uint64_t checksum;
+		uint32_t numVertices;
+		uint32_t numEdges;
+		uint64_t numLines;
+		uint64_t textSize;
+		uint64_t edgeOffsetsOffset;
+		uint64_t edgeTargetsOffset;
+		uint64_t edgeWeightsOffset;
+		uint64_t vertexLinesOffset;
+		uint64_t edgeLinesOffset;
+		uint64_t vertexFlagsOffset;
+		uint64_t edgeFlagsOffset;
+		uint64_t lineOffsetsOffset;
+		uint64_t textOffset;
+	};
+
+protected:
+
+	static constexpr char Magic[8] = { 'T', 'R', 'P', 'G', 'W', 'L', 'D', '\0' };
+
+	static const uint32_t ByteOrderMark = 0x01020304;
+
+	const char* mapping;
+
+	size_t mappingSize;
+
+#ifdef _WIN32
+	HANDLE fileHandle;
+
+	HANDLE mappingHandle;
+#endif
+
+	const Header* header;
+
+	const uint32_t* edgeOffsets;
+
+	const uint32_t* edgeTargets;
+
+	const double* edgeWeights;
+
+	const uint64_t* vertexLines;
+
+	const uint64_t* edgeLines;
+
+	const uint8_t* vertexFlags;
+
+	const uint8_t* edgeFlags;
+
+	const uint64_t* lineOffsets;
+
+	const char* text;
+
+	/*
+	True once validate has succeeded.
+	*/
+	bool validated;
+
+	WorldImage() {
+		this->mapping = nullptr;
+		this->mappingSize = 0;
+#ifdef _WIN32
+		this->fileHandle = INVALID_HANDLE_VALUE;
+		this->mappingHandle = nullptr;
+#endif
+		this->header = nullptr;
+		this->validated = false;
+	}
+
+	/*
+	Returns true if the specified array of count + 1 positions never
+	decreases and ends at or below limit, so each consecutive pair of
+	entries is a valid range.
+	*/
+	template <typename Position>
+	static bool isMonotonic(const Position* positions, uint64_t count, uint64_t limit) {
+		for (uint64_t k = 0; k < count; k++) {
+			if (positions[k] > positions[k + 1]) {
+				return false;
+			}
+		}
+		return positions[count] <= limit;
+	}
+
+	/*
+	Folds the specified bytes into a running 64-bit FNV-1a checksum.
+	*/
+	static uint64_t addToChecksum(uint64_t checksum, const char* bytes, size_t size) {
+		for (size_t k = 0; k < size; k++) {
+			checksum ^= (uint8_t)bytes[k];
+			checksum *= 0x100000001B3ULL;
+		}
+		return checksum;
+	}
+
+	static uint64_t alignUp(uint64_t offset) {
+		return (offset + 7) & ~(uint64_t)7;
+	}
+
+	/*
+	Writes arrays to a file one after another, 8-byte aligned, adding them
+	to a checksum.
+	*/
+	struct SectionWriter {
+		std::ofstream& out;
+		uint64_t position;
+		uint64_t checksum;
+
+		SectionWriter(std::ofstream& out, uint64_t position) : out(out), position(position), checksum(0xCBF29CE484222325ULL) {}
+
+		void write(const void* data, size_t size) {
+			this->out.write((const char*)data, (std::streamsize)size);
+			this->checksum = addToChecksum(this->checksum, (const char*)data, size);
+			this->position += size;
+		}
+
+		/*
+		Pads to the next multiple of 8 and returns the offset reached.
+		*/
+		uint64_t align() {
+			static const char zeros[8] = { 0 };
+			this->write(zeros, (size_t)(alignUp(this->position) - this->position));
+			return this->position;
+		}
+	};
+
+	/*
+	Returns true if the specified section of count items of the specified
+	size lies within the file, and is aligned for its items.
+	*/
+	bool holds(uint64_t offset, uint64_t count, uint64_t itemSize) {
+		return offset % 8 == 0 && offset >= sizeof(Header) && offset <= this->mappingSize
+			&& count <= (this->mappingSize - offset) / itemSize;
+	}
+
+	/*
+	Checks the header and the layout of the mapped file, and points the
+	section pointers into it. Returns false if the file is not a valid
+	image of this version.
+	*/
+	bool attach() {
+		if (this->mappingSize < sizeof(Header)) {
+			return false;
+		}
+		const Header* h = (const Header*)this->mapping;
+		if (std::memcmp(h->magic, Magic, sizeof(Magic)) != 0 || h->version != Version
+			|| h->byteOrder != ByteOrderMark || h->fileSize != this->mappingSize) {
+			return false;
+		}
+		if (!this->holds(h->edgeOffsetsOffset, (uint64_t)h->numVertices + 1, sizeof(uint32_t))
+			|| !this->holds(h->edgeTargetsOffset, h->numEdges, sizeof(uint32_t))
+			|| !this->holds(h->edgeWeightsOffset, h->numEdges, sizeof(double))
+			|| !this->holds(h->vertexLinesOffset, (uint64_t)h->numVertices + 1, sizeof(uint64_t))
+			|| !this->holds(h->edgeLinesOffset, (uint64_t)h->numEdges + 1, sizeof(uint64_t))
+			|| !this->holds(h->vertexFlagsOffset, h->numVertices, 1)
+			|| !this->holds(h->edgeFlagsOffset, h->numEdges, 1)
+			|| !this->holds(h->lineOffsetsOffset, h->numLines + 1, sizeof(uint64_t))
+			|| !this->holds(h->textOffset, h->textSize, 1)) {
+			return false;
+		}
+		this->header = h;
+		this->edgeOffsets = (const uint32_t*)(this->mapping + h->edgeOffsetsOffset);
+		this->edgeTargets = (const uint32_t*)(this->mapping + h->edgeTargetsOffset);
+		this->edgeWeights = (const double*)(this->mapping + h->edgeWeightsOffset);
+		this->vertexLines = (const uint64_t*)(this->mapping + h->vertexLinesOffset);
+		this->edgeLines = (const uint64_t*)(this->mapping + h->edgeLinesOffset);
+		this->vertexFlags = (const uint8_t*)(this->mapping + h->vertexFlagsOffset);
+		this->edgeFlags = (const uint8_t*)(this->mapping + h->edgeFlagsOffset);
+		this->lineOffsets = (const uint64_t*)(this->mapping + h->lineOffsetsOffset);
+		this->text = this->mapping + h->textOffset;
+		return this->edgeOffsets[h->numVertices] == h->numEdges && this->vertexLines[h->numVertices] <= h->numLines
+			&& this->edgeLines[h->numEdges] <= h->numLines && this->lineOffsets[h->numLines] <= h->textSize;
+	}
+
+	/*
+	Appends the lines of the specified story list, if any, to the specified
+	lines, and returns 1 if there was a list or 0 if not.
+	*/
+	template <typename Line>
+	static uint8_t collectLines(List<Line>* story, std::vector<std::string_view>& lines) {
+		if (story == nullptr) {
+			return 0;
+		}
+		for (Line* line : *story) {
+			lines.push_back(std::string_view(*line));
+		}
+		return 1;
+	}
+
+	/*
+	Copies the lines of story list k of the specified ranges into a new
+	list, or returns the null pointer if the room or edge has no story list.
+	makeLine turns a line of the image into an item of the list.
+	*/
+	template <typename Line, typename MakeLine>
+	List<Line>* copyStory(const uint8_t* flags, const uint64_t* lineRanges, uint64_t k, MakeLine& makeLine, bool ownsLines) {
+		if (flags[k] == 0) {
+			return nullptr;
+		}
+		List<Line>* story = new List<Line>();
+		story->setOwnsData(ownsLines);
+		for (uint64_t line = lineRanges[k]; line < lineRanges[k + 1]; line++) {
+			story->insertAtEnd(makeLine(std::string_view(this->text + this->lineOffsets[line],
+				(size_t)(this->lineOffsets[line + 1] - this->lineOffsets[line]))));
+		}
+		return story;
+	}
+
+	/*
+	Copies this image into a new graph that owns its rooms and story lists,
+	with rooms in the same order, or returns the null pointer if the image
+	doesn't validate.
+	*/
+	template <typename Line, typename MakeLine>
+	Graph<List<Line>, List<Line>>* copyToGraph(MakeLine makeLine, bool ownsLines) {
+		if (!this->validate()) {
+			return nullptr;
+		}
+		Graph<List<Line>, List<Line>>* graph = new Graph<List<Line>, List<Line>>(true);
+		int numVertices = this->getNumVertices();
+		std::vector<Vertex<List<Line>>*> rooms(numVertices);
+		for (int room = 0; room < numVertices; room++) {
+			rooms[room] = new Vertex<List<Line>>();
+			rooms[room]->setData(this->copyStory<Line>(this->vertexFlags, this->vertexLines, room, makeLine, ownsLines));
+		}
+		std::vector<typename Graph<List<Line>, List<Line>>::EdgeRecord> records(this->getNumEdges());
+		for (int room = 0; room < numVertices; room++) {
+			for (uint32_t e = this->edgeOffsets[room]; e < this->edgeOffsets[room + 1]; e++) {
+				records[e] = { rooms[room], rooms[this->edgeTargets[e]], this->edgeWeights[e],
+					this->copyStory<Line>(this->edgeFlags, this->edgeLines, e, makeLine, ownsLines) };
+			}
+		}
+		graph->addVertices(rooms);
+		graph->addEdges(records);
+		return graph;
+	}
+
+	static std::string_view emptyLine() {
+		return std::string_view();
+	}
+
+public:
+
+	WorldImage(const WorldImage& other) = delete;
+
+	WorldImage& operator=(const WorldImage& other) = delete;
+
+	/*
+	Unmaps the image. String views obtained from it become invalid.
+	*/
+	~WorldImage() {
+#ifdef _WIN32
+		if (this->mapping != nullptr) {
+			UnmapViewOfFile(this->mapping);
+		}
+		if (this->mappingHandle != nullptr) {
+			CloseHandle(this->mappingHandle);
+		}
+		if (this->fileHandle != INVALID_HANDLE_VALUE) {
+			CloseHandle(this->fileHandle);
+		}
+#else
+		if (this->mapping != nullptr) {
+			munmap((void*)this->mapping, this->mappingSize);
+		}
+#endif
+	}
+
+	/*
+	Maps the image saved at the specified path. Returns the null pointer if
+	the file can't be opened or is not a valid image of this version, or if
+	validateIndexes is true and the image doesn't validate. Without
+	validation the accessors trust the index arrays, so only skip it for
+	images known to be intact. The caller is responsible for deleting the
+	returned image.
+	*/
+	static WorldImage* open(const std::string& path, bool validateIndexes = true) {
+		WorldImage* image = new WorldImage();
+#ifdef _WIN32
+		image->fileHandle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+			FILE_ATTRIBUTE_NORMAL, nullptr);
+		LARGE_INTEGER fileSize;
+		if (image->fileHandle == INVALID_HANDLE_VALUE || !GetFileSizeEx(image->fileHandle, &fileSize)
+			|| fileSize.QuadPart == 0) {
+			delete image;
+			return nullptr;
+		}
+		image->mappingSize = (size_t)fileSize.QuadPart;
+		image->mappingHandle = CreateFileMappingA(image->fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (image->mappingHandle != nullptr) {
+			image->mapping = (const char*)MapViewOfFile(image->mappingHandle, FILE_MAP_READ, 0, 0, 0);
+		}
+#else
+		int descriptor = ::open(path.c_str(), O_RDONLY);
+		struct stat status;
+		if (descriptor < 0 || fstat(descriptor, &status) != 0 || status.st_size == 0) {
+			if (descriptor >= 0) {
+				close(descriptor);
+			}
+			delete image;
+			return nullptr;
+		}
+		image->mappingSize = (size_t)status.st_size;
+		void* mapped = mmap(nullptr, image->mappingSize, PROT_READ, MAP_PRIVATE, descriptor, 0);
+		close(descriptor);
+		image->mapping = mapped == MAP_FAILED ? nullptr : (const char*)mapped;
+#endif
+		if (image->mapping == nullptr || !image->attach() || (validateIndexes && !image->validate())) {
+			delete image;
+			return nullptr;
+		}
+		return image;
+	}
+
+	/*
+	Saves the specified graph as an image at the specified path, replacing
+	any file there. Returns false if the file can't be written or the graph
+	has an edge to a vertex outside it.
+	*/
+	template <typename Line, template <typename> class Container>
+	static bool write(Graph<List<Line>, List<Line>, Container>* graph, const std::string& path) {
+		uint32_t numVertices = (uint32_t)graph->getNumVertices();
+		uint32_t numEdges = (uint32_t)graph->getNumEdges();
+
+		// group the edges by the room they leave from
+		std::vector<uint32_t> edgeOffsets(numVertices + 1, 0);
+		std::vector<uint32_t> edgeSources(numEdges);
+		std::vector<Edge<List<Line>, List<Line>>*> edgeList(numEdges);
+		uint32_t position = 0;
+		for (Edge<List<Line>, List<Line>>* edge : *graph->getEdges()) {
+			int from = graph->getVertexIndex(edge->getInitialVertex());
+			if (from < 0 || graph->getVertexIndex(edge->getTerminalVertex()) < 0) {
+				return false;
+			}
+			edgeSources[position] = (uint32_t)from;
+			edgeList[position++] = edge;
+			edgeOffsets[from + 1]++;
+		}
+		for (uint32_t v = 0; v < numVertices; v++) {
+			edgeOffsets[v + 1] += edgeOffsets[v];
+		}
+		std::vector<uint32_t> edgeTargets(numEdges);
+		std::vector<double> edgeWeights(numEdges);
+		std::vector<Edge<List<Line>, List<Line>>*> edgesInOrder(numEdges);
+		std::vector<uint32_t> rowEnds(edgeOffsets.begin(), edgeOffsets.end() - 1);
+		for (uint32_t k = 0; k < numEdges; k++) {
+			uint32_t slot = rowEnds[edgeSources[k]]++;
+			edgesInOrder[slot] = edgeList[k];
+			edgeTargets[slot] = (uint32_t)graph->getVertexIndex(edgeList[k]->getTerminalVertex());
+			edgeWeights[slot] = edgeList[k]->getEdgeWeight();
+		}
+
+		// gather the story lines of the rooms, then the edges
+		std::vector<std::string_view> lines;
+		std::vector<uint64_t> vertexLines(numVertices + 1, 0);
+		std::vector<uint8_t> vertexFlags(numVertices, 0);
+		uint32_t v = 0;
+		for (Vertex<List<Line>>* vertex : *graph->getVertices()) {
+			vertexLines[v] = lines.size();
+			vertexFlags[v] = collectLines(vertex->getData(), lines);
+			v++;
+		}
+		vertexLines[numVertices] = lines.size();
+		std::vector<uint64_t> edgeLines(numEdges + 1, 0);
+		std::vector<uint8_t> edgeFlags(numEdges, 0);
+		for (uint32_t e = 0; e < numEdges; e++) {
+			edgeLines[e] = lines.size();
+			edgeFlags[e] = collectLines(edgesInOrder[e]->getData(), lines);
+		}
+		edgeLines[numEdges] = lines.size();
+		std::vector<uint64_t> lineOffsets(lines.size() + 1, 0);
+		for (size_t k = 0; k < lines.size(); k++) {
+			lineOffsets[k + 1] = lineOffsets[k] + lines[k].size();
+		}
+
+		std::ofstream out(path, std::ios::binary | std::ios::trunc);
+		if (!out) {
+			return false;
+		}
+		Header header;
+		std::memset(&header, 0, sizeof(header));
+		out.write((const char*)&header, sizeof(header));
+		SectionWriter writer(out, sizeof(header));
+		header.edgeOffsetsOffset = writer.align();
+		writer.write(edgeOffsets.data(), edgeOffsets.size() * sizeof(uint32_t));
+		header.edgeTargetsOffset = writer.align();
+		writer.write(edgeTargets.data(), edgeTargets.size() * sizeof(uint32_t));
+		header.edgeWeightsOffset = writer.align();
+		writer.write(edgeWeights.data(), edgeWeights.size() * sizeof(double));
+		header.vertexLinesOffset = writer.align();
+		writer.write(vertexLines.data(), vertexLines.size() * sizeof(uint64_t));
+		header.edgeLinesOffset = writer.align();
+		writer.write(edgeLines.data(), edgeLines.size() * sizeof(uint64_t));
+		header.vertexFlagsOffset = writer.align();
+		writer.write(vertexFlags.data(), vertexFlags.size());
+		header.edgeFlagsOffset = writer.align();
+		writer.write(edgeFlags.data(), edgeFlags.size());
+		header.lineOffsetsOffset = writer.align();
+		writer.write(lineOffsets.data(), lineOffsets.size() * sizeof(uint64_t));
+		header.textOffset = writer.align();
+		for (std::string_view line : lines) {
+			writer.write(line.data(), line.size());
+		}
+		writer.align();
+
+		std::memcpy(header.magic, Magic, sizeof(Magic));
+		header.version = Version;
+		header.byteOrder = ByteOrderMark;
+		header.fileSize = writer.position;
+		header.checksum = writer.checksum;
+		header.numVertices = numVertices;
+		header.numEdges = numEdges;
+		header.numLines = lines.size();
+		header.textSize = lineOffsets.back();
+		out.seekp(0);
+		out.write((const char*)&header, sizeof(header));
+		out.close();
+		return !out.fail();
+	}
+
+	/*
+	Reads the whole image and returns true if it matches the checksum it
+	was written with.
+	*/
+	bool verifyChecksum() {
+		uint64_t checksum = addToChecksum(0xCBF29CE484222325ULL, this->mapping + sizeof(Header),
+			this->mappingSize - sizeof(Header));
+		return checksum == this->header->checksum;
+	}
+
+	/*
+	Reads the index arrays and returns true if every range in them is in
+	order and within its array, and every edge leads to a room of the
+	image, so that no accessor can read outside the file. Takes time
+	proportional to the numbers of rooms, edges and story lines; once it has
+	succeeded, later calls return at once.
+	*/
+	bool validate() {
+		if (!this->validated) {
+			const Header* h = this->header;
+			bool valid = isMonotonic(this->edgeOffsets, h->numVertices, h->numEdges)
+				&& isMonotonic(this->vertexLines, h->numVertices, h->numLines)
+				&& isMonotonic(this->edgeLines, h->numEdges, h->numLines)
+				&& isMonotonic(this->lineOffsets, h->numLines, h->textSize);
+			for (uint32_t e = 0; e < h->numEdges && valid; e++) {
+				valid = this->edgeTargets[e] < h->numVertices;
+			}
+			this->validated = valid;
+		}
+		return this->validated;
+	}
+
+	/*
+	Returns the size of the image file in bytes.
+	*/
+	size_t getFileSize() {
+		return this->mappingSize;
+	}
+
+	int getNumVertices() {
+		return (int)this->header->numVertices;
+	}
+
+	int getNumEdges() {
+		return (int)this->header->numEdges;
+	}
+
+	/*
+	Returns the number of edges out of the specified room, or -1 if there is
+	no such room.
+	*/
+	int getOutDegree(int room) {
+		if (room < 0 || room >= this->getNumVertices()) {
+			return -1;
+		}
+		return (int)(this->edgeOffsets[room + 1] - this->edgeOffsets[room]);
+	}
+
+	/*
+	Returns the id of the first edge out of the specified room; the others
+	follow it. The room must be valid.
+	*/
+	int getFirstEdge(int room) {
+		return (int)this->edgeOffsets[room];
+	}
+
+	/*
+	Returns a pointer to the rooms the edges out of the specified room lead
+	to, getOutDegree(room) long. The room must be valid.
+	*/
+	const uint32_t* getNeighbors(int room) {
+		return this->edgeTargets + this->edgeOffsets[room];
+	}
+
+	/*
+	Returns a pointer to the weights of the edges out of the specified room,
+	in the same order as getNeighbors. The room must be valid.
+	*/
+	const double* getNeighborWeights(int room) {
+		return this->edgeWeights + this->edgeOffsets[room];
+	}
+
+	/*
+	Returns the id of the edge from the "from" room to the "to" room, or -1
+	if there is no such edge.
+	*/
+	int findEdge(int from, int to) {
+		if (from < 0 || from >= this->getNumVertices()) {
+			return -1;
+		}
+		for (uint32_t e = this->edgeOffsets[from]; e < this->edgeOffsets[from + 1]; e++) {
+			if ((int)this->edgeTargets[e] == to) {
+				return (int)e;
+			}
+		}
+		return -1;
+	}
+
+	/*
+	Returns the room the specified edge leads to, or -1 if there is no such
+	edge.
+	*/
+	int getEdgeTarget(int edge) {
+		if (edge < 0 || edge >= this->getNumEdges()) {
+			return -1;
+		}
+		return (int)this->edgeTargets[edge];
+	}
+
+	/*
+	Returns the weight of the specified edge, or NaN if there is no such
+	edge.
+	*/
+	double getEdgeWeight(int edge) {
+		if (edge < 0 || edge >= this->getNumEdges()) {
+			return std::nan("");
+		}
+		return this->edgeWeights[edge];
+	}
+
+	/*
+	Returns true if the specified room has a story list, which may be empty.
+	*/
+	bool hasStory(int room) {
+		return room >= 0 && room < this->getNumVertices() && this->vertexFlags[room] != 0;
+	}
+
+	/*
+	Returns the number of story lines in the specified room, or -1 if there
+	is no such room.
+	*/
+	int getNumStoryLines(int room) {
+		if (room < 0 || room >= this->getNumVertices()) {
+			return -1;
+		}
+		return (int)(this->vertexLines[room + 1] - this->vertexLines[room]);
+	}
+
+	/*
+	Returns story line k of the specified room, or an empty view if there is
+	no such line.
+	*/
+	std::string_view getStoryLine(int room, int k) {
+		if (k < 0 || k >= this->getNumStoryLines(room)) {
+			return emptyLine();
+		}
+		uint64_t line = this->vertexLines[room] + k;
+		return std::string_view(this->text + this->lineOffsets[line], (size_t)(this->lineOffsets[line + 1] - this->lineOffsets[line]));
+	}
+
+	bool edgeHasStory(int edge) {
+		return edge >= 0 && edge < this->getNumEdges() && this->edgeFlags[edge] != 0;
+	}
+
+	int getNumEdgeStoryLines(int edge) {
+		if (edge < 0 || edge >= this->getNumEdges()) {
+			return -1;
+		}
+		return (int)(this->edgeLines[edge + 1] - this->edgeLines[edge]);
+	}
+
+	std::string_view getEdgeStoryLine(int edge, int k) {
+		if (k < 0 || k >= this->getNumEdgeStoryLines(edge)) {
+			return emptyLine();
+		}
+		uint64_t line = this->edgeLines[edge] + k;
+		return std::string_view(this->text + this->lineOffsets[line], (size_t)(this->lineOffsets[line + 1] - this->lineOffsets[line]));
+	}
+
+	/*
+	Copies this image into a new graph that owns its rooms and story lists,
+	with rooms in the same order and each story line in a string of its own,
+	or returns the null pointer if the image doesn't validate. The caller is
+	responsible for deleting the returned graph.
+	*/
+	Graph<List<std::string>, List<std::string>>* toGraph() {
+		return this->copyToGraph<std::string>([](std::string_view line) { return new std::string(line); }, true);
+	}
+
+	/*
+	Copies this image into a new graph that owns its rooms and story lists,
+	with rooms in the same order and story lines interned in the specified
+	arena, which must outlive the graph, or returns the null pointer if the
+	image doesn't validate. The caller is responsible for deleting the
+	returned graph.
+	*/
+	Graph<List<std::string_view>, List<std::string_view>>* toGraph(StringArena* text) {
+		return this->copyToGraph<std::string_view>([text](std::string_view line) { return text->intern(line); }, false);
+	}
+
+	/*
+	Returns a string representation of this image.
+	*/
+	std::string toString() {
+		std::ostringstream sout;
+		sout << "WorldImage at: " << this << std::endl;
+		sout << "Number of rooms: " << this->getNumVertices() << ", edges: " << this->getNumEdges()
+			<< ", story lines: " << this->header->numLines << ", bytes: " << this->mappingSize << std::endl;
+		return sout.str();
+	}
+
+};
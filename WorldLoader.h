@@ -0,0 +1,627 @@
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <istream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "Vertex.h"
+#include "Graph.h"
+#include "HashMap.h"
+#include "List.h"
+#include "StringArena.h"
+
+/*
+Reads a game world from a plain-text description into a
+Graph<List<std::string_view>, List<std::string_view>>, so the world can
+change without rebuilding the game. A description looks like this:
+
+	# the first room declared is room 0, where the game starts
+	room lair
+	| You awaken in a dark underground pit...
+	| You can't see far ahead of you...
+
+	room tunnel
+	exit lair tunnel 2.5
+	| You squeeze through a crack in the wall.
+
+Each line is one of:
+
+	room NAME                 declares a room; NAME has no spaces
+	exit FROM TO [WEIGHT]     an edge between two rooms, weight 1 by default
+	| TEXT                    a story line for the last room or exit declared
+	# ...                     a comment
+
+Blank lines and leading spaces and tabs are ignored. A story line is the
+rest of the line after the bar and one space. Exits may name rooms declared
+later in the file, but every room must be declared exactly once, and each
+exit may appear only once. Rooms are added to the graph in the order they
+are declared; a room or exit with no story lines has no story list.
+
+Story lines are interned in a StringArena given to the loader, and the
+story lists hold their handles, so a line repeated across the world is
+stored once. The arena must outlive the graphs loaded into it.
+
+The input is read in fixed-size chunks and split into lines and tokens as
+string_views into the chunk, so the only allocations are the rooms, edges
+and story lists of the world itself, the arena's blocks, and the loader's
+own tables. When the input is not a valid world, load returns the null
+pointer, and getErrorMessage, getErrorLine and getErrorColumn say what was
+wrong and where. Columns count bytes from 1.
+
+A large world doesn't fit in the caches, so the loader keeps the work done
+per line away from scattered memory. Room names go into a flat table of
+their own, and exits hold the rooms' entries in it; the rooms become
+vertices only once every line is read, side by side and with room for
+their exits, and the exits are added to the graph from there. Story lines
+are interned a chunk at a time with StringArena::internAll. On one core,
+GraphBenchmarks::benchmarkWorldLoader loads a 204 MB world (300000 rooms,
+1200000 exits) at 110-140 MB/s.
+*/
+class WorldLoader {
+
+public:
+
+	typedef Graph<List<std::string_view>, List<std::string_view>> WorldGraph;
+
+protected:
+
+	/*
+	What the loader knows about a room name, by the order in which names are
+	first used: where the name is kept in names, the room's position in the
+	graph once it is declared, where the name was first used, for reporting
+	a room that is never declared, and the room's story.
+	*/
+	struct RoomEntry {
+		size_t nameStart;
+		int nameSize;
+		int index;
+		int line;
+		int column;
+		List<std::string_view>* story;
+	};
+
+	/*
+	An exit, with its rooms given by their entries in rooms, and where it
+	was declared, for reporting an exit declared twice.
+	*/
+	struct ExitEntry {
+		int from;
+		int to;
+		double weight;
+		List<std::string_view>* story;
+		int line;
+		int column;
+	};
+
+	StringArena* text;
+
+	size_t chunkSize;
+
+	/*
+	The text of every room name, one after another.
+	*/
+	std::string names;
+
+	std::vector<RoomEntry> rooms;
+
+	/*
+	The rooms by name, in an open-addressed table with linear probing, at
+	most half full. A slot holds the high 32 bits of the name's hash and one
+	more than the room's entry, or 0 if it is empty, so a probe reads the
+	name only when the hashes match.
+	*/
+	std::vector<uint64_t> roomTable;
+
+	/*
+	The entries of the declared rooms, in the order they are declared.
+	*/
+	std::vector<int> declared;
+
+	std::vector<ExitEntry> exits;
+
+	/*
+	The story lines read since the last call to addStoryLines, still in the
+	input buffer, and the lists they go to.
+	*/
+	std::vector<std::string_view> storyLines;
+
+	std::vector<List<std::string_view>*> storyLists;
+
+	std::vector<std::string_view*> storyHandles;
+
+	/*
+	What story lines are added to: nothing before the first room or exit,
+	then the last room or exit declared.
+	*/
+	enum StoryTarget { NoTarget, RoomTarget, ExitTarget };
+
+	StoryTarget storyTarget;
+
+	/*
+	The entry of the room declared last, or -1. Exits usually follow the
+	room they leave from, so its name is checked before the table.
+	*/
+	int lastRoom;
+
+	std::string errorMessage;
+
+	int errorLine;
+
+	int errorColumn;
+
+	int lineNumber;
+
+	/*
+	Starts a new load, freeing anything left from the last one.
+	*/
+	void reset() {
+		this->discard();
+		this->roomTable.assign(1024, 0);
+		this->errorMessage.clear();
+		this->errorLine = 0;
+		this->errorColumn = 0;
+		this->lineNumber = 0;
+		this->storyTarget = NoTarget;
+		this->lastRoom = -1;
+	}
+
+	/*
+	Frees the story lists of a load that failed, and everything the loader
+	knows about its rooms and exits.
+	*/
+	void discard() {
+		for (RoomEntry& room : this->rooms) {
+			delete room.story;
+		}
+		for (ExitEntry& exit : this->exits) {
+			delete exit.story;
+		}
+		this->clearTables();
+	}
+
+	void clearTables() {
+		this->names.clear();
+		this->rooms.clear();
+		this->roomTable.clear();
+		this->declared.clear();
+		this->exits.clear();
+		this->storyLines.clear();
+		this->storyLists.clear();
+	}
+
+	/*
+	Records an error at the specified column of the current line, unless an
+	error has already been recorded, and returns false.
+	*/
+	bool fail(std::string_view message, std::string_view token, int column) {
+		if (this->errorMessage.empty()) {
+			std::ostringstream sout;
+			sout << message;
+			if (!token.empty()) {
+				sout << " '" << token << "'";
+			}
+			this->errorMessage = sout.str();
+			this->errorLine = this->lineNumber;
+			this->errorColumn = column;
+		}
+		return false;
+	}
+
+	/*
+	Records an error at the specified line and column, once every line has
+	been read, and returns false.
+	*/
+	bool failAt(std::string_view message, std::string_view token, int line, int column) {
+		int linesRead = this->lineNumber;
+		this->lineNumber = line;
+		this->fail(message, token, column);
+		this->lineNumber = linesRead;
+		return false;
+	}
+
+	std::string_view nameOf(int room) {
+		return std::string_view(this->names).substr(this->rooms[room].nameStart, this->rooms[room].nameSize);
+	}
+
+	/*
+	Returns true if no two exits join the same rooms in the same direction,
+	or reports the first exit that repeats an earlier one. Exits are sorted
+	by their rooms once every line is read, which is much cheaper than
+	looking each one up in a set as it is read.
+	*/
+	bool checkExitsDistinct() {
+		std::vector<std::pair<uint64_t, int>> keys(this->exits.size());
+		for (size_t k = 0; k < keys.size(); k++) {
+			ExitEntry& exit = this->exits[k];
+			keys[k] = { ((uint64_t)exit.from << 32) | (uint32_t)exit.to, (int)k };
+		}
+		std::sort(keys.begin(), keys.end());
+		int repeated = -1;
+		for (size_t k = 1; k < keys.size(); k++) {
+			// within a run of equal rooms, the second exit is the first repeat
+			if (keys[k].first == keys[k - 1].first && (k < 2 || keys[k - 2].first != keys[k].first)
+				&& (repeated < 0 || keys[k].second < repeated)) {
+				repeated = keys[k].second;
+			}
+		}
+		if (repeated < 0) {
+			return true;
+		}
+		ExitEntry& exit = this->exits[repeated];
+		return this->failAt("exit declared twice:",
+			std::string(this->nameOf(exit.from)) + " " + std::string(this->nameOf(exit.to)), exit.line, exit.column);
+	}
+
+	/*
+	Doubles the size of the room table.
+	*/
+	void growRoomTable() {
+		std::vector<uint64_t> oldTable(this->roomTable.size() * 2, 0);
+		oldTable.swap(this->roomTable);
+		size_t mask = this->roomTable.size() - 1;
+		for (uint64_t entry : oldTable) {
+			if (entry != 0) {
+				size_t slot = (size_t)(entry >> 32) & mask;
+				while (this->roomTable[slot] != 0) {
+					slot = (slot + 1) & mask;
+				}
+				this->roomTable[slot] = entry;
+			}
+		}
+	}
+
+	static bool isBlank(char c) {
+		return c == ' ' || c == '\t';
+	}
+
+	/*
+	Returns the next space-separated token of the specified line at or after
+	the specified position, and moves the position past it. The token is
+	empty at the end of the line.
+	*/
+	static std::string_view nextToken(std::string_view line, size_t& position) {
+		while (position < line.size() && isBlank(line[position])) {
+			position++;
+		}
+		size_t start = position;
+		while (position < line.size() && !isBlank(line[position])) {
+			position++;
+		}
+		return line.substr(start, position - start);
+	}
+
+	/*
+	Returns the entry of the room with the specified name, creating one the
+	first time the name is used.
+	*/
+	int findRoom(std::string_view name, int column) {
+		uint32_t hash = (uint32_t)(std::hash<std::string_view>()(name) >> 32);
+		size_t mask = this->roomTable.size() - 1;
+		size_t slot = hash & mask;
+		for (uint64_t entry; (entry = this->roomTable[slot]) != 0; slot = (slot + 1) & mask) {
+			if ((uint32_t)(entry >> 32) == hash && this->nameOf((int)(uint32_t)entry - 1) == name) {
+				return (int)(uint32_t)entry - 1;
+			}
+		}
+		int room = (int)this->rooms.size();
+		this->rooms.push_back({ this->names.size(), (int)name.size(), -1, this->lineNumber, column, nullptr });
+		this->names.append(name);
+		this->roomTable[slot] = ((uint64_t)hash << 32) | (uint32_t)(room + 1);
+		if (2 * this->rooms.size() > this->roomTable.size()) {
+			this->growRoomTable();
+		}
+		return room;
+	}
+
+	bool parseRoom(std::string_view line, size_t position) {
+		std::string_view name = nextToken(line, position);
+		int nameColumn = (int)(position - name.size()) + 1;
+		if (name.empty()) {
+			return this->fail("expected a room name", name, nameColumn);
+		}
+		std::string_view extra = nextToken(line, position);
+		if (!extra.empty()) {
+			return this->fail("unexpected text after the room name:", extra, (int)(position - extra.size()) + 1);
+		}
+		int room = this->findRoom(name, nameColumn);
+		if (this->rooms[room].index >= 0) {
+			return this->fail("room declared twice:", name, nameColumn);
+		}
+		this->rooms[room].index = (int)this->declared.size();
+		this->declared.push_back(room);
+		this->storyTarget = RoomTarget;
+		this->lastRoom = room;
+		return true;
+	}
+
+	bool parseExit(std::string_view line, size_t position) {
+		std::string_view fromName = nextToken(line, position);
+		int fromColumn = (int)(position - fromName.size()) + 1;
+		std::string_view toName = nextToken(line, position);
+		int toColumn = (int)(position - toName.size()) + 1;
+		if (toName.empty()) {
+			return this->fail("expected the names of the two rooms of the exit", toName, (int)position + 1);
+		}
+		double weight = 1;
+		std::string_view weightText = nextToken(line, position);
+		if (!weightText.empty()) {
+			int weightColumn = (int)(position - weightText.size()) + 1;
+			std::from_chars_result result = std::from_chars(weightText.data(), weightText.data() + weightText.size(), weight);
+			if (result.ec != std::errc() || result.ptr != weightText.data() + weightText.size() || !(weight >= 0)
+				|| std::isinf(weight)) {
+				return this->fail("expected a weight of 0 or more, not", weightText, weightColumn);
+			}
+			std::string_view extra = nextToken(line, position);
+			if (!extra.empty()) {
+				return this->fail("unexpected text after the exit weight:", extra, (int)(position - extra.size()) + 1);
+			}
+		}
+		int from = this->lastRoom >= 0 && fromName == this->nameOf(this->lastRoom)
+			? this->lastRoom : this->findRoom(fromName, fromColumn);
+		int to = this->findRoom(toName, toColumn);
+		this->exits.push_back({ from, to, weight, nullptr, this->lineNumber, fromColumn });
+		this->storyTarget = ExitTarget;
+		return true;
+	}
+
+	/*
+	Adds a story line to the last room or exit declared.
+	*/
+	bool parseStoryLine(std::string_view line, size_t position) {
+		if (this->storyTarget == NoTarget) {
+			return this->fail("a story line must follow a room or an exit", std::string_view(), (int)position + 1);
+		}
+		position++;
+		if (position < line.size() && line[position] == ' ') {
+			position++;
+		}
+		// rooms hold their story in the vertex, exits in their record
+		List<std::string_view>*& story = this->storyTarget == RoomTarget
+			? this->rooms[this->lastRoom].story : this->exits.back().story;
+		if (story == nullptr) {
+			story = new List<std::string_view>();
+		}
+		this->storyLines.push_back(line.substr(position));
+		this->storyLists.push_back(story);
+		return true;
+	}
+
+	/*
+	Interns the story lines read since the last call, all at once, and adds
+	them to their lists. Called before the input buffer they are in is
+	reused.
+	*/
+	void addStoryLines() {
+		this->storyHandles.clear();
+		this->text->internAll(this->storyLines, this->storyHandles);
+		for (size_t k = 0; k < this->storyHandles.size(); k++) {
+			this->storyLists[k]->insertAtEnd(this->storyHandles[k]);
+		}
+		this->storyLines.clear();
+		this->storyLists.clear();
+	}
+
+	/*
+	Parses one line, without its line break. Returns false if it is not
+	valid.
+	*/
+	bool parseLine(std::string_view line) {
+		this->lineNumber++;
+		if (!line.empty() && line.back() == '\r') {
+			line.remove_suffix(1);
+		}
+		size_t position = 0;
+		while (position < line.size() && isBlank(line[position])) {
+			position++;
+		}
+		if (position == line.size() || line[position] == '#') {
+			return true;
+		}
+		if (line[position] == '|') {
+			return this->parseStoryLine(line, position);
+		}
+		size_t keywordStart = position;
+		std::string_view keyword = nextToken(line, position);
+		if (keyword == "room") {
+			return this->parseRoom(line, position);
+		}
+		if (keyword == "exit") {
+			return this->parseExit(line, position);
+		}
+		return this->fail("expected room, exit or a story line, not", keyword, (int)keywordStart + 1);
+	}
+
+public:
+
+	/*
+	Creates a loader that interns story lines in the specified arena, which
+	it does not own, and reads its input the specified number of bytes at a
+	time. Lines longer than that are still read whole.
+	*/
+	WorldLoader(StringArena* text, size_t chunkSize = 1 << 16) {
+		this->text = text;
+		this->chunkSize = chunkSize > 0 ? chunkSize : 1;
+		this->storyTarget = NoTarget;
+		this->lastRoom = -1;
+		this->errorLine = 0;
+		this->errorColumn = 0;
+		this->lineNumber = 0;
+	}
+
+	WorldLoader(const WorldLoader& other) = delete;
+
+	WorldLoader& operator=(const WorldLoader& other) = delete;
+
+	~WorldLoader() {
+		this->discard();
+	}
+
+	/*
+	Reads a world from the specified stream and returns it as a new graph
+	that owns its rooms and story lists, or returns the null pointer if the
+	stream doesn't hold a valid world. The caller is responsible for
+	deleting the returned graph. Story lines that a failed load interned
+	stay in the arena.
+	*/
+	WorldGraph* load(std::istream& in) {
+		this->reset();
+		std::vector<char> buffer(this->chunkSize);
+		size_t used = 0;
+		bool valid = true;
+		while (valid) {
+			in.read(buffer.data() + used, (std::streamsize)(buffer.size() - used));
+			size_t read = (size_t)in.gcount();
+			bool atEnd = read == 0;
+			used += read;
+			const char* start = buffer.data();
+			const char* end = buffer.data() + used;
+			const char* lineEnd;
+			while (valid && (lineEnd = (const char*)std::memchr(start, '\n', (size_t)(end - start))) != nullptr) {
+				valid = this->parseLine(std::string_view(start, (size_t)(lineEnd - start)));
+				start = lineEnd + 1;
+			}
+			if (!valid) {
+				break;
+			}
+			if (atEnd) {
+				if (start != end) {
+					valid = this->parseLine(std::string_view(start, (size_t)(end - start)));
+				}
+				this->addStoryLines();
+				break;
+			}
+			this->addStoryLines();
+			// keep the partial last line for the next chunk, making room
+			// for it if it fills the whole buffer
+			used = (size_t)(end - start);
+			std::memmove(buffer.data(), start, used);
+			if (used == buffer.size()) {
+				buffer.resize(buffer.size() * 2);
+			}
+		}
+		if (valid && in.bad()) {
+			valid = this->fail("the input couldn't be read", std::string_view(), 0);
+		}
+		if (valid) {
+			// report the first use of a room that is never declared
+			int undeclared = -1;
+			for (int room = 0; room < (int)this->rooms.size(); room++) {
+				RoomEntry& entry = this->rooms[room];
+				if (entry.index < 0 && (undeclared < 0 || entry.line < this->rooms[undeclared].line
+					|| (entry.line == this->rooms[undeclared].line && entry.column < this->rooms[undeclared].column))) {
+					undeclared = room;
+				}
+			}
+			if (undeclared >= 0) {
+				valid = this->failAt("exit to a room that is never declared:", this->nameOf(undeclared),
+					this->rooms[undeclared].line, this->rooms[undeclared].column);
+			}
+		}
+		if (valid) {
+			valid = this->checkExitsDistinct();
+		}
+		if (!valid) {
+			this->discard();
+			return nullptr;
+		}
+		// the rooms only become vertices now, one after another in the order
+		// they were declared, with room for all their exits, and exits find
+		// them by their entry
+		std::vector<int> numOut(this->rooms.size(), 0);
+		std::vector<int> numIn(this->rooms.size(), 0);
+		for (ExitEntry& exit : this->exits) {
+			numOut[exit.from]++;
+			numIn[exit.to]++;
+		}
+		std::vector<Vertex<List<std::string_view>>*> vertices(this->rooms.size());
+		for (int room : this->declared) {
+			vertices[room] = new Vertex<List<std::string_view>>(this->rooms[room].story);
+			vertices[room]->reserve(numOut[room], numIn[room]);
+		}
+		std::vector<WorldGraph::EdgeRecord> records(this->exits.size());
+		for (size_t k = 0; k < records.size(); k++) {
+			ExitEntry& exit = this->exits[k];
+			records[k] = { vertices[exit.from], vertices[exit.to], exit.weight, exit.story };
+		}
+		std::vector<Vertex<List<std::string_view>>*> rooms(this->declared.size());
+		for (size_t k = 0; k < rooms.size(); k++) {
+			rooms[k] = vertices[this->declared[k]];
+		}
+		// the graph now owns the rooms and story lists
+		this->clearTables();
+		WorldGraph* world = new WorldGraph(true);
+		world->addVertices(rooms);
+		world->addEdges(records);
+		return world;
+	}
+
+	/*
+	Reads a world from the file at the specified path. Returns the null
+	pointer if the file can't be opened or doesn't hold a valid world.
+	*/
+	WorldGraph* loadFile(const std::string& path) {
+		std::ifstream in(path, std::ios::binary);
+		if (!in) {
+			this->reset();
+			this->fail("couldn't open", path, 0);
+			this->discard();
+			return nullptr;
+		}
+		return this->load(in);
+	}
+
+	/*
+	Returns a description of what was wrong with the input of the last load,
+	or an empty string if it succeeded.
+	*/
+	std::string getErrorMessage() {
+		return this->errorMessage;
+	}
+
+	/*
+	Returns the line on which the last load found an error, counting from
+	1, or 0 if it found none or the input couldn't be read.
+	*/
+	int getErrorLine() {
+		return this->errorLine;
+	}
+
+	/*
+	Returns the column at which the last load found an error, counting
+	bytes from 1, or 0 if it found none.
+	*/
+	int getErrorColumn() {
+		return this->errorColumn;
+	}
+
+	/*
+	Returns the number of lines the last load read.
+	*/
+	int getNumLinesRead() {
+		return this->lineNumber;
+	}
+
+	/*
+	Returns a string representation of this loader.
+	*/
+	std::string toString() {
+		std::ostringstream sout;
+		sout << "WorldLoader at: " << this << std::endl;
+		if (this->errorMessage.empty()) {
+			sout << "Lines read: " << this->lineNumber << std::endl;
+		}
+		else {
+			sout << "Error at line " << this->errorLine << ", column " << this->errorColumn << ": "
+				<< this->errorMessage << std::endl;
+		}
+		return sout.str();
+	}
+
+};